@@ -0,0 +1,152 @@
+/**
+ * @file    gravity_benchmark.cpp
+ * @author  Martin Cagas
+ *
+ * @brief   Benchmarks of the gravitational force calculations.
+ */
+
+// Standard includes
+#include <vector>
+
+// Google Benchmark includes
+#include <benchmark/benchmark.h>
+
+// "Game essentials" library includes
+#include <random.hpp>
+#include <vector2d.hpp>
+
+// "Particle game core" library includes
+#include <gravity_constant.hpp>
+#include <gravity_object.hpp>
+#include <physics_object.hpp>
+
+// Local includes
+#include "particle_counters.hpp"
+
+using namespace essentials;
+
+/**
+ * @brief   Returns count objects with random positions and masses, the same ones on every run.
+ */
+template <typename T>
+static std::vector<BasicPhysicsObject<T>> random_objects(std::size_t count)
+{
+    Random random(count);
+    std::vector<BasicPhysicsObject<T>> objects;
+    objects.reserve(count);
+    for (std::size_t i = 0; i < count; i++) {
+        BasicVector2D<T> position(random.next_real<T>(-100, 100), random.next_real<T>(-100, 100));
+        objects.emplace_back(position, random.next_real<T>(1, 10));
+    }
+    return objects;
+}
+
+/**
+ * @brief   Particle arrays with random positions and masses, the same ones on every run.
+ */
+template <typename T>
+struct RandomArrays
+{
+    std::vector<T> x, y, mass, fx, fy;
+
+    RandomArrays(std::size_t count) : x(count), y(count), mass(count), fx(count), fy(count)
+    {
+        Random random(count);
+        for (std::size_t i = 0; i < count; i++) {
+            x[i] = random.next_real<T>(-100, 100);
+            y[i] = random.next_real<T>(-100, 100);
+            mass[i] = random.next_real<T>(1, 10);
+        }
+    }
+};
+
+/**
+ * @brief   Returns an enabled point mass in the middle of the random objects.
+ */
+template <typename T>
+static BasicGravityObject<T> make_point_mass(void)
+{
+    BasicGravityObject<T> gravity_object(BasicVector2D<T>(T(0), T(0)));
+    gravity_object.set_mass(T(1000));
+    gravity_object.enable();
+    return gravity_object;
+}
+
+template <typename T>
+static void BM_GravityObjectCalculateForce(benchmark::State &state)
+{
+    const std::size_t count = state.range(0);
+    const std::vector<BasicPhysicsObject<T>> objects = random_objects<T>(count);
+    const BasicGravityObject<T> gravity_object = make_point_mass<T>();
+    std::vector<BasicVector2D<T>> forces(count);
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < count; i++) {
+            forces[i] = gravity_object.calculate_force(objects[i]);
+        }
+        benchmark::DoNotOptimize(forces.data());
+        benchmark::ClobberMemory();
+    }
+
+    set_particle_counters(state, count);
+}
+
+template <typename T>
+static void BM_GravityObjectAccumulateForces(benchmark::State &state)
+{
+    const std::size_t count = state.range(0);
+    RandomArrays<T> arrays(count);
+    const BasicGravityObject<T> gravity_object = make_point_mass<T>();
+
+    for (auto _ : state) {
+        gravity_object.accumulate_forces(arrays.x.data(), arrays.y.data(), arrays.mass.data(),
+                                         arrays.fx.data(), arrays.fy.data(), count);
+        benchmark::ClobberMemory();
+    }
+
+    set_particle_counters(state, count);
+}
+
+template <typename T>
+static void BM_GravityConstantCalculateForce(benchmark::State &state)
+{
+    const std::size_t count = state.range(0);
+    const std::vector<BasicPhysicsObject<T>> objects = random_objects<T>(count);
+    const BasicGravityConstant<T> gravity_constant;
+    std::vector<BasicVector2D<T>> forces(count);
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < count; i++) {
+            forces[i] = gravity_constant.calculate_force(objects[i]);
+        }
+        benchmark::DoNotOptimize(forces.data());
+        benchmark::ClobberMemory();
+    }
+
+    set_particle_counters(state, count);
+}
+
+template <typename T>
+static void BM_GravityConstantAccumulateForces(benchmark::State &state)
+{
+    const std::size_t count = state.range(0);
+    RandomArrays<T> arrays(count);
+    const BasicGravityConstant<T> gravity_constant;
+
+    for (auto _ : state) {
+        gravity_constant.accumulate_forces(arrays.x.data(), arrays.y.data(), arrays.mass.data(),
+                                           arrays.fx.data(), arrays.fy.data(), count);
+        benchmark::ClobberMemory();
+    }
+
+    set_particle_counters(state, count);
+}
+
+BENCHMARK_TEMPLATE(BM_GravityObjectCalculateForce, float)->Apply(particle_counts);
+BENCHMARK_TEMPLATE(BM_GravityObjectCalculateForce, double)->Apply(particle_counts);
+BENCHMARK_TEMPLATE(BM_GravityObjectAccumulateForces, float)->Apply(particle_counts);
+BENCHMARK_TEMPLATE(BM_GravityObjectAccumulateForces, double)->Apply(particle_counts);
+BENCHMARK_TEMPLATE(BM_GravityConstantCalculateForce, float)->Apply(particle_counts);
+BENCHMARK_TEMPLATE(BM_GravityConstantCalculateForce, double)->Apply(particle_counts);
+BENCHMARK_TEMPLATE(BM_GravityConstantAccumulateForces, float)->Apply(particle_counts);
+BENCHMARK_TEMPLATE(BM_GravityConstantAccumulateForces, double)->Apply(particle_counts);
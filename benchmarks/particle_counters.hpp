@@ -0,0 +1,45 @@
+/**
+ * @file    particle_counters.hpp
+ * @author  Martin Cagas
+ *
+ * @brief   Helpers shared by the benchmarks of the per-particle passes.
+ */
+
+#pragma once
+
+// Standard includes
+#include <cstdint>
+#include <cstdlib>
+
+// Google Benchmark includes
+#include <benchmark/benchmark.h>
+
+/**
+ * @brief   Particle counts every per-particle benchmark runs with, 1k to 1M in steps of 10x.
+ */
+inline void particle_counts(benchmark::internal::Benchmark *benchmark)
+{
+    benchmark->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMicrosecond);
+}
+
+/**
+ * @brief   Reports the throughput of a benchmark processing count particles per iteration.
+ *
+ * @details
+ *
+ * Adds the particles per second as items_per_second and the time spent per particle as the
+ * time_per_particle counter. The console shows the time per particle with an SI prefix, typically
+ * in nanoseconds, the JSON output keeps it in seconds.
+ *
+ * @param   &state      State of the finished benchmark.
+ * @param   count       Amount of particles processed by every iteration.
+ */
+inline void set_particle_counters(benchmark::State &state, std::size_t count)
+{
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+
+    // The inverted rate of the particles is the time per particle.
+    state.counters["time_per_particle"] = benchmark::Counter(
+        static_cast<double>(count),
+        benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
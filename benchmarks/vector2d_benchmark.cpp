@@ -0,0 +1,209 @@
+/**
+ * @file    vector2d_benchmark.cpp
+ * @author  Martin Cagas
+ *
+ * @brief   Benchmarks of the Vector2D operations, one vector at a time and batched.
+ */
+
+// Standard includes
+#include <vector>
+
+// Google Benchmark includes
+#include <benchmark/benchmark.h>
+
+// "Game essentials" library includes
+#include <random.hpp>
+#include <vector2d.hpp>
+#include <vector2d_batch.hpp>
+
+// Local includes
+#include "particle_counters.hpp"
+
+using namespace essentials;
+
+/**
+ * @brief   Returns count vectors with random components, the same ones on every run.
+ */
+template <typename T>
+static std::vector<BasicVector2D<T>> random_vectors(std::size_t count)
+{
+    Random random(count);
+    std::vector<BasicVector2D<T>> vectors(count);
+    for (BasicVector2D<T> &vector : vectors) {
+        vector = BasicVector2D<T>(random.next_real<T>(-100, 100), random.next_real<T>(-100, 100));
+    }
+    return vectors;
+}
+
+/**
+ * @brief   Splits vectors into the arrays of their x and y components.
+ */
+template <typename T>
+static void split(const std::vector<BasicVector2D<T>> &vectors, std::vector<T> &x,
+                  std::vector<T> &y)
+{
+    x.resize(vectors.size());
+    y.resize(vectors.size());
+    for (std::size_t i = 0; i < vectors.size(); i++) {
+        x[i] = vectors[i].x;
+        y[i] = vectors[i].y;
+    }
+}
+
+template <typename T>
+static void BM_Vector2DAdd(benchmark::State &state)
+{
+    const std::size_t count = state.range(0);
+    std::vector<BasicVector2D<T>> a = random_vectors<T>(count);
+    const std::vector<BasicVector2D<T>> b = random_vectors<T>(count + 1);
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < count; i++) {
+            a[i] += b[i];
+        }
+        benchmark::DoNotOptimize(a.data());
+        benchmark::ClobberMemory();
+    }
+
+    set_particle_counters(state, count);
+}
+
+template <typename T>
+static void BM_Vector2DLength(benchmark::State &state)
+{
+    const std::size_t count = state.range(0);
+    const std::vector<BasicVector2D<T>> a = random_vectors<T>(count);
+    std::vector<T> lengths(count);
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < count; i++) {
+            lengths[i] = a[i].length();
+        }
+        benchmark::DoNotOptimize(lengths.data());
+        benchmark::ClobberMemory();
+    }
+
+    set_particle_counters(state, count);
+}
+
+template <typename T>
+static void BM_Vector2DNormalized(benchmark::State &state)
+{
+    const std::size_t count = state.range(0);
+    const std::vector<BasicVector2D<T>> a = random_vectors<T>(count);
+    std::vector<BasicVector2D<T>> normalized(count);
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < count; i++) {
+            normalized[i] = a[i].normalized();
+        }
+        benchmark::DoNotOptimize(normalized.data());
+        benchmark::ClobberMemory();
+    }
+
+    set_particle_counters(state, count);
+}
+
+template <typename T>
+static void BM_Vector2DDirectionTo(benchmark::State &state)
+{
+    const std::size_t count = state.range(0);
+    const std::vector<BasicVector2D<T>> a = random_vectors<T>(count);
+    const BasicVector2D<T> target(T(1), T(2));
+    std::vector<BasicVector2D<T>> directions(count);
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < count; i++) {
+            directions[i] = a[i].direction_to(target);
+        }
+        benchmark::DoNotOptimize(directions.data());
+        benchmark::ClobberMemory();
+    }
+
+    set_particle_counters(state, count);
+}
+
+template <typename T>
+static void BM_BatchAdd(benchmark::State &state)
+{
+    const std::size_t count = state.range(0);
+    std::vector<T> x, y, other_x, other_y;
+    split(random_vectors<T>(count), x, y);
+    split(random_vectors<T>(count + 1), other_x, other_y);
+
+    for (auto _ : state) {
+        batch::add(x.data(), y.data(), other_x.data(), other_y.data(), count);
+        benchmark::ClobberMemory();
+    }
+
+    set_particle_counters(state, count);
+}
+
+template <typename T>
+static void BM_BatchMultiplyAdd(benchmark::State &state)
+{
+    const std::size_t count = state.range(0);
+    std::vector<T> x, y, other_x, other_y;
+    split(random_vectors<T>(count), x, y);
+    split(random_vectors<T>(count + 1), other_x, other_y);
+
+    for (auto _ : state) {
+        batch::multiply_add(x.data(), y.data(), other_x.data(), other_y.data(), T(0.01), count);
+        benchmark::ClobberMemory();
+    }
+
+    set_particle_counters(state, count);
+}
+
+template <typename T>
+static void BM_BatchLength(benchmark::State &state)
+{
+    const std::size_t count = state.range(0);
+    std::vector<T> x, y, lengths(count);
+    split(random_vectors<T>(count), x, y);
+
+    for (auto _ : state) {
+        batch::length(x.data(), y.data(), lengths.data(), count);
+        benchmark::ClobberMemory();
+    }
+
+    set_particle_counters(state, count);
+}
+
+template <typename T>
+static void BM_BatchNormalize(benchmark::State &state)
+{
+    const std::size_t count = state.range(0);
+    std::vector<T> x, y, source_x, source_y;
+    split(random_vectors<T>(count), source_x, source_y);
+
+    // Normalising is idempotent, so the vectors are reset outside of the timed region.
+    for (auto _ : state) {
+        state.PauseTiming();
+        x = source_x;
+        y = source_y;
+        state.ResumeTiming();
+
+        batch::normalize(x.data(), y.data(), count);
+        benchmark::ClobberMemory();
+    }
+
+    set_particle_counters(state, count);
+}
+
+BENCHMARK_TEMPLATE(BM_Vector2DAdd, float)->Apply(particle_counts);
+BENCHMARK_TEMPLATE(BM_Vector2DAdd, double)->Apply(particle_counts);
+BENCHMARK_TEMPLATE(BM_Vector2DLength, float)->Apply(particle_counts);
+BENCHMARK_TEMPLATE(BM_Vector2DLength, double)->Apply(particle_counts);
+BENCHMARK_TEMPLATE(BM_Vector2DNormalized, float)->Apply(particle_counts);
+BENCHMARK_TEMPLATE(BM_Vector2DNormalized, double)->Apply(particle_counts);
+BENCHMARK_TEMPLATE(BM_Vector2DDirectionTo, float)->Apply(particle_counts);
+BENCHMARK_TEMPLATE(BM_Vector2DDirectionTo, double)->Apply(particle_counts);
+BENCHMARK_TEMPLATE(BM_BatchAdd, float)->Apply(particle_counts);
+BENCHMARK_TEMPLATE(BM_BatchAdd, double)->Apply(particle_counts);
+BENCHMARK_TEMPLATE(BM_BatchMultiplyAdd, float)->Apply(particle_counts);
+BENCHMARK_TEMPLATE(BM_BatchMultiplyAdd, double)->Apply(particle_counts);
+BENCHMARK_TEMPLATE(BM_BatchLength, float)->Apply(particle_counts);
+BENCHMARK_TEMPLATE(BM_BatchLength, double)->Apply(particle_counts);
+BENCHMARK_TEMPLATE(BM_BatchNormalize, float)->Apply(particle_counts);
+BENCHMARK_TEMPLATE(BM_BatchNormalize, double)->Apply(particle_counts);
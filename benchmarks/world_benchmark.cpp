@@ -0,0 +1,155 @@
+/**
+ * @file    world_benchmark.cpp
+ * @author  Martin Cagas
+ *
+ * @brief   Benchmarks of the per-particle passes of the game world.
+ */
+
+// Standard includes
+#include <cmath>
+
+// Google Benchmark includes
+#include <benchmark/benchmark.h>
+
+// "Game essentials" library includes
+#include <random.hpp>
+#include <vector2d.hpp>
+
+// "Particle game core" library includes
+#include <gravity_constant.hpp>
+#include <world.hpp>
+
+// Local includes
+#include "particle_counters.hpp"
+
+using namespace essentials;
+
+/**
+ * @brief   Fills a world with count particles at random positions, the same ones on every run.
+ *
+ * @details
+ *
+ * The world runs on a single thread, so that the results measure the passes themselves and are
+ * comparable between machines with different core counts.
+ */
+template <typename T>
+static void populate(BasicWorld<T> &world, std::size_t count)
+{
+    Random random(count);
+
+    world.set_thread_count(1);
+    world.set_particle_limit(count);
+    world.set_time_step(T(1) / T(60));
+
+    for (std::size_t i = 0; i < count; i++) {
+        BasicVector2D<T> position(random.next_real<T>(-100, 100), random.next_real<T>(-100, 100));
+        BasicVector2D<T> velocity(random.next_real<T>(-1, 1), random.next_real<T>(-1, 1));
+        world.spawn_particle(position, velocity, random.next_real<T>(1, 10));
+    }
+}
+
+template <typename T>
+static void BM_WorldIntegrateForces(benchmark::State &state)
+{
+    const std::size_t count = state.range(0);
+    BasicWorld<T> world;
+    populate(world, count);
+
+    for (auto _ : state) {
+        world.integrate_forces();
+        benchmark::ClobberMemory();
+    }
+
+    set_particle_counters(state, count);
+}
+
+template <typename T>
+static void BM_WorldUpdate(benchmark::State &state)
+{
+    const std::size_t count = state.range(0);
+    BasicWorld<T> world;
+    populate(world, count);
+
+    for (auto _ : state) {
+        world.update();
+        benchmark::ClobberMemory();
+    }
+
+    set_particle_counters(state, count);
+}
+
+template <typename T>
+static void BM_WorldStepConstantGravity(benchmark::State &state)
+{
+    const std::size_t count = state.range(0);
+    BasicWorld<T> world;
+    populate(world, count);
+    world.add_gravity_object(std::make_unique<BasicGravityConstant<T>>());
+
+    for (auto _ : state) {
+        world.step();
+        benchmark::ClobberMemory();
+    }
+
+    set_particle_counters(state, count);
+}
+
+/**
+ * @brief   Resolves the collisions of particles sized to cover a tenth of the populated area.
+ */
+template <typename T>
+static void BM_WorldResolveCollisions(benchmark::State &state)
+{
+    const std::size_t count = state.range(0);
+    BasicWorld<T> world;
+    populate(world, count);
+
+    BasicParticleStore<T> &store = world.get_particle_pool().get_store();
+    const T radius = std::sqrt(T(4000) / (T(3.14159265) * T(count)));
+    for (std::size_t i = 0; i < count; i++) {
+        store.radius[i] = radius;
+    }
+    world.set_particle_collisions(true);
+
+    for (auto _ : state) {
+        world.resolve_collisions();
+        benchmark::ClobberMemory();
+    }
+
+    set_particle_counters(state, count);
+}
+
+/**
+ * @brief   Resolves the particles against bouncing bounds, a floor, a segment and a circle.
+ */
+template <typename T>
+static void BM_WorldResolveObstacles(benchmark::State &state)
+{
+    const std::size_t count = state.range(0);
+    BasicWorld<T> world;
+    populate(world, count);
+
+    world.set_boundary_mode(BoundaryMode::BOUNCE);
+    world.set_bounds(BasicVector2D<T>(-90, -90), BasicVector2D<T>(90, 90));
+    world.get_obstacles().add_line(BasicVector2D<T>(0, -80), BasicVector2D<T>(0, 1));
+    world.get_obstacles().add_segment(BasicVector2D<T>(-60, 0), BasicVector2D<T>(0, -10), T(1));
+    world.get_obstacles().add_circle(BasicVector2D<T>(40, 40), T(20));
+
+    for (auto _ : state) {
+        world.resolve_obstacles();
+        benchmark::ClobberMemory();
+    }
+
+    set_particle_counters(state, count);
+}
+
+BENCHMARK_TEMPLATE(BM_WorldIntegrateForces, float)->Apply(particle_counts);
+BENCHMARK_TEMPLATE(BM_WorldIntegrateForces, double)->Apply(particle_counts);
+BENCHMARK_TEMPLATE(BM_WorldUpdate, float)->Apply(particle_counts);
+BENCHMARK_TEMPLATE(BM_WorldUpdate, double)->Apply(particle_counts);
+BENCHMARK_TEMPLATE(BM_WorldStepConstantGravity, float)->Apply(particle_counts);
+BENCHMARK_TEMPLATE(BM_WorldStepConstantGravity, double)->Apply(particle_counts);
+BENCHMARK_TEMPLATE(BM_WorldResolveCollisions, float)->Apply(particle_counts);
+BENCHMARK_TEMPLATE(BM_WorldResolveCollisions, double)->Apply(particle_counts);
+BENCHMARK_TEMPLATE(BM_WorldResolveObstacles, float)->Apply(particle_counts);
+BENCHMARK_TEMPLATE(BM_WorldResolveObstacles, double)->Apply(particle_counts);
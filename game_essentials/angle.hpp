@@ -14,7 +14,7 @@
 namespace essentials
 {
     /**
-     * @class   Angle
+     * @class   BasicAngle
      *
      * @brief   Angle with conversion functions.
      *
@@ -23,6 +23,9 @@ namespace essentials
      * A class both capable of representing an angle and providing conversion methods between
      * radians and degrees.
      *
+     * The class is a template over the type of the angle. Angle uses double precision and AngleF
+     * single precision.
+     *
      * @section USAGE
      *
      * @code
@@ -39,9 +42,10 @@ namespace essentials
      *
      * @endcode
      */
-    struct Angle
+    template <typename T>
+    struct BasicAngle
     {
-        double radians_;  ///< The angle in radians.
+        T radians_;  ///< The angle in radians.
 
         /**
          * @brief Constructor.
@@ -50,7 +54,7 @@ namespace essentials
          *
          * Initializes the angle to 0.0.
          */
-        Angle(void);
+        constexpr BasicAngle(void) noexcept;
 
         /**
          * @brief   Constructs an angle from degrees.
@@ -61,35 +65,35 @@ namespace essentials
          *
          * @param   degrees     The angle in degrees.
          */
-        Angle(double degrees);
+        constexpr BasicAngle(T degrees) noexcept;
 
         /**
          * @brief   Sets the angle from radians.
          *
          * @param   radians     The angle in radians.
          */
-        void set_from_radians(double radians);
+        constexpr void set_from_radians(T radians) noexcept;
 
         /**
          * @brief   Returns the angle in radians.
          *
          * @return  The angle in radians.
          */
-        double get_as_radians(void) const;
+        constexpr T get_as_radians(void) const noexcept;
 
         /**
          * @brief   Sets the angle from degrees.
          *
          * @param   degrees     The angle in degrees.
          */
-        void set_from_degrees(double degrees);
+        constexpr void set_from_degrees(T degrees) noexcept;
 
         /**
          * @brief   Returns the angle in degrees.
          *
          * @return  The angle in degrees.
          */
-        double get_as_degrees(void) const;
+        constexpr T get_as_degrees(void) const noexcept;
 
         /**
          * @brief   Converts angle from radians to degrees.
@@ -98,7 +102,7 @@ namespace essentials
          *
          * @return  Output angle in degrees.
          */
-        static inline double rad_to_deg(double radians);
+        static constexpr T rad_to_deg(T radians) noexcept;
 
         /**
          * @brief   Converts angle from degrees to radians.
@@ -107,6 +111,43 @@ namespace essentials
          *
          * @return  Output angle in radians.
          */
-        static inline double deg_to_rad(double degrees);
+        static constexpr T deg_to_rad(T degrees) noexcept;
     };
+
+    /**
+     * @brief   Double precision angle.
+     */
+    typedef BasicAngle<double> Angle;
+
+    /**
+     * @brief   Single precision angle.
+     */
+    typedef BasicAngle<float> AngleF;
+
+    template <typename T>
+    constexpr BasicAngle<T>::BasicAngle(void) noexcept : radians_(T(0)) {}
+
+    template <typename T>
+    constexpr BasicAngle<T>::BasicAngle(T degrees) noexcept : radians_(deg_to_rad(degrees)) {}
+
+    template <typename T>
+    constexpr void BasicAngle<T>::set_from_radians(T radians) noexcept { radians_ = radians; }
+
+    template <typename T>
+    constexpr T BasicAngle<T>::get_as_radians(void) const noexcept { return radians_; }
+
+    template <typename T>
+    constexpr void BasicAngle<T>::set_from_degrees(T degrees) noexcept
+    {
+        radians_ = deg_to_rad(degrees);
+    }
+
+    template <typename T>
+    constexpr T BasicAngle<T>::get_as_degrees(void) const noexcept { return rad_to_deg(radians_); }
+
+    template <typename T>
+    constexpr T BasicAngle<T>::rad_to_deg(T radians) noexcept { return radians * T(180.0 / M_PI); }
+
+    template <typename T>
+    constexpr T BasicAngle<T>::deg_to_rad(T degrees) noexcept { return degrees * T(M_PI / 180.0); }
 }  // namespace essentials
@@ -0,0 +1,63 @@
+/**
+ * @file    fixed_timestep.cpp
+ * @author  Martin Cagas
+ *
+ * @brief   Accumulator running a simulation in fixed steps independently of the frame rate.
+ */
+
+#include "fixed_timestep.hpp"
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+
+using namespace essentials;
+
+FixedTimestep::FixedTimestep(void) : FixedTimestep(1.0 / 60.0, 8) {}
+
+FixedTimestep::FixedTimestep(double time_step, std::size_t max_steps)
+    : time_step_(time_step), max_steps_(max_steps), accumulator_(0.0), dropped_time_(0.0)
+{
+}
+
+void FixedTimestep::set_time_step(double time_step) { time_step_ = time_step; }
+
+double FixedTimestep::get_time_step(void) const { return time_step_; }
+
+void FixedTimestep::set_max_steps(std::size_t max_steps) { max_steps_ = max_steps; }
+
+std::size_t FixedTimestep::get_max_steps(void) const { return max_steps_; }
+
+std::size_t FixedTimestep::advance(double elapsed)
+{
+    if (elapsed > 0.0) {
+        accumulator_ += elapsed;
+    }
+
+    double steps = std::floor(accumulator_ / time_step_);
+
+    // Drop the backlog beyond the cap, but keep the fraction of a step for the interpolation.
+    if (steps > double(max_steps_)) {
+        double kept = std::fmod(accumulator_, time_step_);
+        dropped_time_ += accumulator_ - kept - max_steps_ * time_step_;
+        accumulator_ = kept + max_steps_ * time_step_;
+        steps = double(max_steps_);
+    }
+
+    accumulator_ -= steps * time_step_;
+
+    // Rounding may leave the accumulator just outside of [0, time_step_).
+    accumulator_ = std::min(std::max(accumulator_, 0.0), std::nextafter(time_step_, 0.0));
+
+    return static_cast<std::size_t>(steps);
+}
+
+double FixedTimestep::get_alpha(void) const { return accumulator_ / time_step_; }
+
+double FixedTimestep::get_dropped_time(void) const { return dropped_time_; }
+
+void FixedTimestep::reset(void)
+{
+    accumulator_ = 0.0;
+    dropped_time_ = 0.0;
+}
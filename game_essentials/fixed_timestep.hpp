@@ -0,0 +1,126 @@
+/**
+ * @file    fixed_timestep.hpp
+ * @author  Martin Cagas
+ *
+ * @brief   Accumulator running a simulation in fixed steps independently of the frame rate.
+ */
+
+#pragma once
+
+#include <cstdlib>
+
+namespace essentials
+{
+    /**
+     * @class   FixedTimestep
+     *
+     * @brief   Accumulator running a simulation in fixed steps independently of the frame rate.
+     *
+     * @section DESCRIPTION
+     *
+     * Every frame, the time the frame took is added to an accumulator and as many whole time steps
+     * as fit into the accumulator are taken out of it again and simulated. The simulation thus
+     * always advances in steps of the same length, no matter how fast or unevenly the frames come,
+     * and the simulated time keeps up with the real time.
+     *
+     * When a frame takes very long, catching up would take more steps than the frame has time
+     * for, making the next frame take even longer. The amount of steps per frame is therefore
+     * capped, and the time that does not fit under the cap is dropped, so the simulation slows
+     * down instead of stalling.
+     *
+     * What is left in the accumulator is a fraction of a step the simulation lags behind the real
+     * time. Rendering the state interpolated between the last two steps by that fraction keeps
+     * the motion smooth when the frame rate and the step rate differ.
+     *
+     * @section USAGE
+     *
+     * @code
+     *
+     * FixedTimestep timestep(1.0 / 60.0, 8);
+     *
+     * for (std::size_t steps = timestep.advance(frame_time); steps > 0; steps--) {
+     *     world.step();
+     * }
+     * draw(timestep.get_alpha());
+     *
+     * @endcode
+     */
+    class FixedTimestep
+    {
+    public:
+        /**
+         * @brief   Empty constructor.
+         *
+         * @details
+         *
+         * Initialises the time step to 1/60 of a second and the step cap to 8 steps per frame.
+         */
+        FixedTimestep(void);
+
+        /**
+         * @brief   Constructor.
+         *
+         * @param   time_step       Length of a step in seconds.
+         * @param   max_steps       Maximum amount of steps per frame.
+         */
+        FixedTimestep(double time_step, std::size_t max_steps);
+
+        /**
+         * @brief   time_step_ setter.
+         *
+         * @param   time_step       Length of a step in seconds, must be positive.
+         */
+        void set_time_step(double time_step);
+
+        /**
+         * @brief   time_step_ getter.
+         */
+        double get_time_step(void) const;
+
+        /**
+         * @brief   max_steps_ setter.
+         *
+         * @param   max_steps       Maximum amount of steps per frame.
+         */
+        void set_max_steps(std::size_t max_steps);
+
+        /**
+         * @brief   max_steps_ getter.
+         */
+        std::size_t get_max_steps(void) const;
+
+        /**
+         * @brief   Adds the time of a frame to the accumulator.
+         *
+         * @param   elapsed         Time since the last frame in seconds.
+         *
+         * @return  Amount of steps to simulate in this frame, at most the step cap.
+         */
+        std::size_t advance(double elapsed);
+
+        /**
+         * @brief   Returns the fraction of a step the simulation lags behind the real time.
+         *
+         * @details
+         *
+         * Always in the range [0, 1), 0 meaning the last step is right on time.
+         */
+        double get_alpha(void) const;
+
+        /**
+         * @brief   Returns the total time dropped because of the step cap, in seconds.
+         */
+        double get_dropped_time(void) const;
+
+        /**
+         * @brief   Empties the accumulator and forgets the dropped time.
+         */
+        void reset(void);
+
+    private:
+        double time_step_;       ///< Length of a step in seconds.
+        std::size_t max_steps_;  ///< Maximum amount of steps per frame.
+        double accumulator_;     ///< Real time not simulated yet, in seconds.
+        double dropped_time_;    ///< Real time dropped because of the step cap, in seconds.
+    };
+}  // namespace essentials
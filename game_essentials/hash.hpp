@@ -0,0 +1,53 @@
+/**
+ * @file    hash.hpp
+ * @author  Martin Cagas
+ *
+ * @brief   Fast non-cryptographic hashing of raw bytes.
+ */
+
+#pragma once
+
+// Standard includes
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace essentials
+{
+    /**
+     * @brief   Returns a 64-bit hash of raw bytes.
+     *
+     * @details
+     *
+     * Mixes the bytes in eight at a time with a multiply and a rotation, then runs the result
+     * through the splitmix64 finaliser, so every input bit affects every output bit. Fast enough to
+     * hash whole particle arrays, about a cycle per word, but not suitable for cryptography or for
+     * hash tables exposed to untrusted input.
+     *
+     * Hashes of several buffers can be chained by passing the hash of one as the seed of the next.
+     *
+     * @param   *data       The bytes.
+     * @param   size        Amount of bytes.
+     * @param   seed        Seed of the hash.
+     */
+    inline std::uint64_t hash_bytes(const void *data, std::size_t size, std::uint64_t seed = 0)
+    {
+        const unsigned char *bytes = static_cast<const unsigned char *>(data);
+        std::uint64_t hash = seed ^ (size * 0x9e3779b97f4a7c15ULL);
+
+        for (; size >= 8; bytes += 8, size -= 8) {
+            std::uint64_t word;
+            std::memcpy(&word, bytes, 8);
+            hash ^= word * 0xbf58476d1ce4e5b9ULL;
+            hash = ((hash << 31) | (hash >> 33)) * 0x94d049bb133111ebULL;
+        }
+
+        std::uint64_t tail = 0;
+        std::memcpy(&tail, bytes, size);
+        hash ^= tail * 0xbf58476d1ce4e5b9ULL;
+
+        hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+        return hash ^ (hash >> 31);
+    }
+}  // namespace essentials
@@ -0,0 +1,107 @@
+/**
+ * @file    mapped_file.cpp
+ * @author  Martin Cagas
+ *
+ * @brief   Read-only file mapped into memory.
+ */
+
+#include "mapped_file.hpp"
+
+// Standard includes
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace essentials;
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string &path) : data_(nullptr), size_(0)
+{
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        throw std::runtime_error("Cannot read the size of " + path);
+    }
+    size_ = static_cast<std::size_t>(size.QuadPart);
+
+    // An empty file cannot be mapped, it simply has no data.
+    if (size_ > 0) {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping != nullptr) {
+            data_ = static_cast<const unsigned char *>(
+                MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+
+    if (size_ > 0 && data_ == nullptr) {
+        throw std::runtime_error("Cannot map " + path);
+    }
+}
+
+MappedFile::~MappedFile(void)
+{
+    if (data_ != nullptr) {
+        UnmapViewOfFile(data_);
+    }
+}
+
+#else
+
+MappedFile::MappedFile(const std::string &path) : data_(nullptr), size_(0)
+{
+    int file = open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+
+    struct stat status;
+    if (fstat(file, &status) != 0) {
+        close(file);
+        throw std::runtime_error("Cannot read the size of " + path);
+    }
+    size_ = static_cast<std::size_t>(status.st_size);
+
+    // An empty file cannot be mapped, it simply has no data. The mapping outlives the descriptor.
+    if (size_ > 0) {
+        void *mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file, 0);
+        if (mapping != MAP_FAILED) {
+            data_ = static_cast<const unsigned char *>(mapping);
+        }
+    }
+    close(file);
+
+    if (size_ > 0 && data_ == nullptr) {
+        throw std::runtime_error("Cannot map " + path);
+    }
+}
+
+MappedFile::~MappedFile(void)
+{
+    if (data_ != nullptr) {
+        munmap(const_cast<unsigned char *>(data_), size_);
+    }
+}
+
+#endif
+
+const unsigned char *MappedFile::get_data(void) const { return data_; }
+
+std::size_t MappedFile::get_size(void) const { return size_; }
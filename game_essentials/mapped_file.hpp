@@ -0,0 +1,77 @@
+/**
+ * @file    mapped_file.hpp
+ * @author  Martin Cagas
+ *
+ * @brief   Read-only file mapped into memory.
+ */
+
+#pragma once
+
+// Standard includes
+#include <cstdlib>
+#include <string>
+
+namespace essentials
+{
+    /**
+     * @class   MappedFile
+     *
+     * @brief   Read-only file mapped into memory.
+     *
+     * @section DESCRIPTION
+     *
+     * Maps the whole contents of a file into the address space of the process, using mmap() on
+     * POSIX systems and a file mapping on Windows. Reading the file then costs no system calls and
+     * no copies into buffers of the process, the pages come straight from the page cache as they
+     * are touched, and large arrays stored in the file can be used or copied in bulk right where
+     * they are.
+     *
+     * The mapping starts at a page boundary, so data aligned within the file is aligned in memory
+     * as well. The mapping is released when the MappedFile is destroyed.
+     *
+     * @section USAGE
+     *
+     * @code
+     *
+     * MappedFile file("world.snapshot");
+     *
+     * const unsigned char *data = file.get_data();
+     * std::size_t size = file.get_size();
+     *
+     * @endcode
+     */
+    class MappedFile
+    {
+    public:
+        /**
+         * @brief   Constructor, maps a file.
+         *
+         * @param   &path       Path of the file.
+         *
+         * @throws  std::runtime_error if the file cannot be opened or mapped.
+         */
+        explicit MappedFile(const std::string &path);
+
+        /**
+         * @brief   Destructor, unmaps the file.
+         */
+        ~MappedFile(void);
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        /**
+         * @brief   Returns the contents of the file, null for an empty file.
+         */
+        const unsigned char *get_data(void) const;
+
+        /**
+         * @brief   Returns the size of the file in bytes.
+         */
+        std::size_t get_size(void) const;
+
+    protected:
+        const unsigned char *data_;  ///< Start of the mapping, null for an empty file.
+        std::size_t size_;           ///< Size of the file in bytes.
+    };
+}
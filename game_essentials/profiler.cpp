@@ -0,0 +1,169 @@
+/**
+ * @file    profiler.cpp
+ * @author  Martin Cagas
+ *
+ * @brief   Lightweight instrumenting profiler recording scoped timers into per-thread buffers.
+ */
+
+#include "profiler.hpp"
+
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+using namespace essentials;
+using namespace essentials::profiler;
+
+namespace
+{
+    /**
+     * @brief   Ring buffer of the events of a single thread.
+     */
+    struct ThreadBuffer
+    {
+        std::size_t thread;                  ///< Index of the thread.
+        std::atomic<std::uint64_t> written;  ///< Amount of events ever written into the buffer.
+        std::unique_ptr<Event[]> events;     ///< The events, the newest at (written - 1).
+    };
+
+    /**
+     * @brief   Buffers of all the threads that have recorded an event.
+     *
+     * @details
+     *
+     * The buffers outlive their threads, so the events of the worker threads of a job system that
+     * has already been stopped can still be exported.
+     */
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+    /**
+     * @brief   Guards the list of buffers, taken only when a thread records its first event and
+     *          when reading the events.
+     */
+    std::mutex buffers_mutex;
+
+    /**
+     * @brief   Buffer of the calling thread, null until its first event.
+     */
+    thread_local ThreadBuffer *thread_buffer = nullptr;
+
+    /**
+     * @brief   Creates the buffer of the calling thread.
+     */
+    ThreadBuffer *create_thread_buffer(void)
+    {
+        std::unique_ptr<ThreadBuffer> buffer(new ThreadBuffer());
+        buffer->written.store(0, std::memory_order_relaxed);
+        buffer->events.reset(new Event[BUFFER_CAPACITY]);
+
+        std::lock_guard<std::mutex> lock(buffers_mutex);
+        buffer->thread = buffers.size();
+        buffers.push_back(std::move(buffer));
+        return buffers.back().get();
+    }
+
+    /**
+     * @brief   Writes a string into a JSON file as a string literal.
+     */
+    void write_json_string(std::FILE *file, const char *string)
+    {
+        std::fputc('"', file);
+        for (const char *c = string; *c != '\0'; c++) {
+            if (*c == '"' || *c == '\\') {
+                std::fputc('\\', file);
+            }
+            std::fputc(*c, file);
+        }
+        std::fputc('"', file);
+    }
+}
+
+void profiler::enable(void) { enabled_flag.store(true, std::memory_order_relaxed); }
+
+void profiler::disable(void) { enabled_flag.store(false, std::memory_order_relaxed); }
+
+std::uint64_t profiler::now(void)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+void profiler::record(const char *name, std::uint64_t start, std::uint64_t end)
+{
+    if (thread_buffer == nullptr) {
+        thread_buffer = create_thread_buffer();
+    }
+
+    // Only the owning thread writes, the release store publishes the event to the readers.
+    ThreadBuffer &buffer = *thread_buffer;
+    const std::uint64_t written = buffer.written.load(std::memory_order_relaxed);
+    buffer.events[written % BUFFER_CAPACITY] = Event{name, start, end, buffer.thread};
+    buffer.written.store(written + 1, std::memory_order_release);
+}
+
+void profiler::collect(std::uint64_t since, std::vector<Event> &events)
+{
+    std::lock_guard<std::mutex> lock(buffers_mutex);
+
+    for (const std::unique_ptr<ThreadBuffer> &buffer : buffers) {
+        const std::uint64_t written = buffer->written.load(std::memory_order_acquire);
+        const std::uint64_t oldest = written - std::min<std::uint64_t>(written, BUFFER_CAPACITY);
+
+        // The events of a thread are ordered by their ends, walk back to the first one to append.
+        std::uint64_t first = written;
+        while (first > oldest && buffer->events[(first - 1) % BUFFER_CAPACITY].end > since) {
+            first--;
+        }
+
+        for (std::uint64_t i = first; i < written; i++) {
+            events.push_back(buffer->events[i % BUFFER_CAPACITY]);
+        }
+    }
+}
+
+void profiler::clear(void)
+{
+    std::lock_guard<std::mutex> lock(buffers_mutex);
+
+    for (const std::unique_ptr<ThreadBuffer> &buffer : buffers) {
+        buffer->written.store(0, std::memory_order_relaxed);
+    }
+}
+
+void profiler::export_chrome_trace(const std::string &path)
+{
+    std::vector<Event> events;
+    collect(0, events);
+
+    std::FILE *file = std::fopen(path.c_str(), "w");
+    if (file == nullptr) {
+        throw std::runtime_error("Cannot open trace file " + path);
+    }
+
+    // Timestamps are written in microseconds relative to the earliest event.
+    std::uint64_t origin = events.empty() ? 0 : events.front().start;
+    for (const Event &event : events) {
+        origin = std::min(origin, event.start);
+    }
+
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", file);
+    for (std::size_t i = 0; i < events.size(); i++) {
+        const Event &event = events[i];
+        std::fputs((i == 0) ? "\n{\"name\":" : ",\n{\"name\":", file);
+        write_json_string(file, event.name);
+        std::fprintf(file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%zu,\"ts\":%.3f,\"dur\":%.3f}",
+                     event.thread, (event.start - origin) / 1000.0,
+                     (event.end - event.start) / 1000.0);
+    }
+    std::fputs("\n]}\n", file);
+
+    const bool failed = std::ferror(file) != 0;
+    if (std::fclose(file) != 0 || failed) {
+        throw std::runtime_error("Cannot write trace file " + path);
+    }
+}
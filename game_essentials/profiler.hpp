@@ -0,0 +1,191 @@
+/**
+ * @file    profiler.hpp
+ * @author  Martin Cagas
+ *
+ * @brief   Lightweight instrumenting profiler recording scoped timers into per-thread buffers.
+ */
+
+#pragma once
+
+// Standard includes
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace essentials
+{
+    /**
+     * @brief   Lightweight instrumenting profiler recording scoped timers into per-thread buffers.
+     *
+     * @section DESCRIPTION
+     *
+     * Zones of code are measured by placing ESSENTIALS_PROFILE_SCOPE() at their start. While the
+     * profiler is enabled, every zone records an event with its name, start and end into a ring
+     * buffer of the thread running it. The buffers are per thread, so recording takes no locks
+     * and the worker threads of a parallel loop never contend with each other. Each buffer keeps
+     * the last BUFFER_CAPACITY events of its thread, older ones are overwritten.
+     *
+     * The timestamps come from std::chrono::steady_clock, in nanoseconds. On the supported
+     * platforms it reads the time stamp counter without a system call, for a few tens of
+     * nanoseconds per zone.
+     *
+     * The profiler is compiled in when ESSENTIALS_PROFILER is defined, otherwise
+     * ESSENTIALS_PROFILE_SCOPE() expands to nothing. When compiled in, it starts disabled, and a
+     * disabled zone costs a single relaxed load of the enabled flag and a branch.
+     *
+     * The recorded events are read by collect() and export_chrome_trace(). Both read the buffers
+     * of the other threads without synchronising with them, so they must only be called while no
+     * other thread is inside a zone, e.g. between the steps of the world, whose worker threads
+     * idle outside of its parallel loops.
+     *
+     * @section USAGE
+     *
+     * @code
+     *
+     * profiler::enable();
+     *
+     * {
+     *     ESSENTIALS_PROFILE_SCOPE("forces");
+     *     accumulate_forces();
+     * }
+     *
+     * profiler::export_chrome_trace("trace.json");
+     *
+     * @endcode
+     */
+    namespace profiler
+    {
+        /**
+         * @brief   Amount of events each thread's ring buffer holds.
+         */
+        static constexpr std::size_t BUFFER_CAPACITY = 16384;
+
+        /**
+         * @brief   A single execution of a zone.
+         */
+        struct Event
+        {
+            const char *name;     ///< Name of the zone, a string with static storage duration.
+            std::uint64_t start;  ///< Time the zone was entered, in nanoseconds.
+            std::uint64_t end;    ///< Time the zone was left, in nanoseconds.
+            std::size_t thread;   ///< Index of the thread, in the order of their first events.
+        };
+
+        /**
+         * @brief   True while the profiler records events, use enable() and disable() to set it.
+         */
+        inline std::atomic<bool> enabled_flag(false);
+
+        /**
+         * @brief   Starts recording events.
+         */
+        void enable(void);
+
+        /**
+         * @brief   Stops recording events, the recorded ones are kept.
+         */
+        void disable(void);
+
+        /**
+         * @brief   Returns true if the profiler records events, false otherwise.
+         */
+        inline bool get_is_enabled(void) { return enabled_flag.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief   Returns the current time in nanoseconds, on the clock of the events.
+         */
+        std::uint64_t now(void);
+
+        /**
+         * @brief   Records an event into the ring buffer of the calling thread.
+         *
+         * @param   *name       Name of the zone, a string with static storage duration.
+         * @param   start       Time the zone was entered, from now().
+         * @param   end         Time the zone was left, from now().
+         */
+        void record(const char *name, std::uint64_t start, std::uint64_t end);
+
+        /**
+         * @brief   Appends the events that ended after a point in time to a vector.
+         *
+         * @details
+         *
+         * The events of every thread are appended in the order they ended, the threads one after
+         * another. Only the events still held by the ring buffers are available.
+         *
+         * @param   since       Only events ending after this time are appended.
+         * @param   &events     The vector the events are appended to.
+         */
+        void collect(std::uint64_t since, std::vector<Event> &events);
+
+        /**
+         * @brief   Drops all the recorded events.
+         */
+        void clear(void);
+
+        /**
+         * @brief   Writes all the recorded events into a file in the Chrome trace event format.
+         *
+         * @details
+         *
+         * The file can be opened in chrome://tracing or Perfetto, which lay the zones of every
+         * thread out on a timeline.
+         *
+         * @param   &path       Path of the file.
+         *
+         * @throws  std::runtime_error if the file cannot be written.
+         */
+        void export_chrome_trace(const std::string &path);
+
+        /**
+         * @class   Scope
+         *
+         * @brief   Records an event spanning its lifetime, see ESSENTIALS_PROFILE_SCOPE().
+         */
+        class Scope
+        {
+        public:
+            /**
+             * @brief   Constructor, enters the zone if the profiler is enabled.
+             *
+             * @param   *name       Name of the zone, a string with static storage duration.
+             */
+            explicit Scope(const char *name)
+                : name_(get_is_enabled() ? name : nullptr), start_(name_ != nullptr ? now() : 0)
+            {
+            }
+
+            /**
+             * @brief   Destructor, leaves the zone and records its event.
+             */
+            ~Scope(void)
+            {
+                if (name_ != nullptr) {
+                    record(name_, start_, now());
+                }
+            }
+
+            Scope(const Scope &) = delete;
+            Scope &operator=(const Scope &) = delete;
+
+        protected:
+            const char *name_;     ///< Name of the zone, null if the profiler was disabled.
+            std::uint64_t start_;  ///< Time the zone was entered.
+        };
+    }
+}
+
+#define ESSENTIALS_PROFILE_CONCAT_(a, b) a##b
+#define ESSENTIALS_PROFILE_CONCAT(a, b) ESSENTIALS_PROFILE_CONCAT_(a, b)
+
+/**
+ * @brief   Measures the rest of the enclosing block as a zone of the given name.
+ */
+#ifdef ESSENTIALS_PROFILER
+#define ESSENTIALS_PROFILE_SCOPE(name) \
+    essentials::profiler::Scope ESSENTIALS_PROFILE_CONCAT(profile_scope_, __LINE__)(name)
+#else
+#define ESSENTIALS_PROFILE_SCOPE(name) static_cast<void>(0)
+#endif
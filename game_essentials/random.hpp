@@ -0,0 +1,149 @@
+/**
+ * @file    random.hpp
+ * @author  Martin Cagas
+ *
+ * @brief   Small and fast pseudo-random number generator.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+
+namespace essentials
+{
+    /**
+     * @class   Random
+     *
+     * @brief   Small and fast pseudo-random number generator.
+     *
+     * @section DESCRIPTION
+     *
+     * An implementation of the xoshiro256+ generator by David Blackman and Sebastiano Vigna, seeded
+     * through splitmix64. Its whole state is four 64-bit words and a number takes a handful of
+     * shifts, rotations and additions, so every emitter or job can own a generator of its own
+     * instead of sharing a locked global one. The same seed always gives the same sequence.
+     *
+     * The generator is meant for gameplay and visual effects, it is not suitable for cryptography.
+     *
+     * @section USAGE
+     *
+     * @code
+     *
+     * Random random(42);
+     *
+     * float spread = random.next_real<float>(-1.0f, 1.0f);
+     *
+     * @endcode
+     */
+    class Random
+    {
+    public:
+        /**
+         * @brief   Whole state of the generator.
+         */
+        typedef std::array<std::uint64_t, 4> State;
+
+        /**
+         * @brief   Constructor.
+         *
+         * @param   seed        Seed of the sequence.
+         */
+        constexpr Random(std::uint64_t seed = 0) noexcept;
+
+        /**
+         * @brief   Restarts the sequence from a new seed.
+         *
+         * @param   seed        Seed of the sequence.
+         */
+        constexpr void set_seed(std::uint64_t seed) noexcept;
+
+        /**
+         * @brief   Returns the state of the generator, e.g. to save it.
+         */
+        constexpr State get_state(void) const noexcept;
+
+        /**
+         * @brief   Continues the sequence from a state returned by get_state().
+         *
+         * @param   &state      State of the generator, must not be all zero.
+         */
+        constexpr void set_state(const State &state) noexcept;
+
+        /**
+         * @brief   Returns the next 64 random bits.
+         */
+        constexpr std::uint64_t next(void) noexcept;
+
+        /**
+         * @brief   Returns a random real number in the range [0, 1).
+         */
+        template <typename T>
+        constexpr T next_real(void) noexcept;
+
+        /**
+         * @brief   Returns a random real number in the range [min, max).
+         */
+        template <typename T>
+        constexpr T next_real(T min, T max) noexcept;
+
+    private:
+        std::uint64_t state_[4];  ///< State of the generator, never all zero.
+    };
+
+    constexpr Random::Random(std::uint64_t seed) noexcept : state_{} { set_seed(seed); }
+
+    constexpr void Random::set_seed(std::uint64_t seed) noexcept
+    {
+        // Spread the seed over the whole state with splitmix64, as recommended for xoshiro.
+        for (std::uint64_t &word : state_) {
+            seed += 0x9e3779b97f4a7c15ULL;
+            std::uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    constexpr Random::State Random::get_state(void) const noexcept
+    {
+        return State{state_[0], state_[1], state_[2], state_[3]};
+    }
+
+    constexpr void Random::set_state(const State &state) noexcept
+    {
+        for (std::size_t i = 0; i < state.size(); i++) {
+            state_[i] = state[i];
+        }
+    }
+
+    constexpr std::uint64_t Random::next(void) noexcept
+    {
+        const std::uint64_t result = state_[0] + state_[3];
+        const std::uint64_t t = state_[1] << 17;
+
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = (state_[3] << 45) | (state_[3] >> 19);
+
+        return result;
+    }
+
+    template <typename T>
+    constexpr T Random::next_real(void) noexcept
+    {
+        // The upper bits are the best ones of xoshiro256+, take as many as the mantissa holds.
+        constexpr int BITS = (sizeof(T) == sizeof(float)) ? 24 : 53;
+        return T(next() >> (64 - BITS)) * (T(1) / T(std::uint64_t(1) << BITS));
+    }
+
+    template <typename T>
+    constexpr T Random::next_real(T min, T max) noexcept
+    {
+        return min + (max - min) * next_real<T>();
+    }
+}  // namespace essentials
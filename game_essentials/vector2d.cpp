@@ -36,176 +36,31 @@
 
 using namespace essentials;
 
-Vector2D::Vector2D(void) : x(0.0), y(0.0) {}
-
-Vector2D::Vector2D(double x, double y) : x(x), y(y) {}
-
-inline double &Vector2D::operator[](int index) { return (index == 0) ? x : y; }
-
-inline const double &Vector2D::operator[](int index) const { return (index == 0) ? x : y; }
-
-inline Vector2D Vector2D::operator+(const Vector2D &rvalue) const
-{
-    return Vector2D(x + rvalue.x, y + rvalue.y);
-}
-
-inline void Vector2D::operator+=(const Vector2D &rvalue)
-{
-    x += rvalue.x;
-    y += rvalue.y;
-}
-
-inline Vector2D Vector2D::operator-(const Vector2D &rvalue) const
-{
-    return Vector2D(x - rvalue.x, y - rvalue.y);
-}
-
-inline void Vector2D::operator-=(const Vector2D &rvalue)
-{
-    x -= rvalue.x;
-    y -= rvalue.y;
-}
-
-inline Vector2D Vector2D::operator*(const Vector2D &rvalue) const
-{
-    return Vector2D(x * rvalue.x, y * rvalue.y);
-}
-
-inline Vector2D Vector2D::operator*(const double &rvalue) const
-{
-    return Vector2D(x * rvalue, y * rvalue);
-}
-
-inline void Vector2D::operator*=(const Vector2D &rvalue)
-{
-    x *= rvalue.x;
-    y *= rvalue.y;
-}
-
-inline void Vector2D::operator*=(const double &rvalue)
-{
-    x *= rvalue;
-    y *= rvalue;
-}
-
-inline Vector2D Vector2D::operator/(const Vector2D &rvalue) const
-{
-    return Vector2D(x / rvalue.x, y / rvalue.y);
-}
-
-inline Vector2D Vector2D::operator/(const double &rvalue) const
-{
-    return Vector2D(x / rvalue, y / rvalue);
-}
-
-inline void Vector2D::operator/=(const Vector2D &rvalue)
-{
-    x *= rvalue.x;
-    y *= rvalue.y;
-}
-
-inline void Vector2D::operator/=(const double &rvalue)
-{
-    x *= rvalue;
-    y *= rvalue;
-}
-
-inline Vector2D Vector2D::operator-(void) const { return Vector2D(-x, -y); }
-
-inline bool Vector2D::operator==(const Vector2D &rvalue) const
-{
-    return (x == rvalue.x && y == rvalue.y);
-}
-
-inline bool Vector2D::operator!=(const Vector2D &rvalue) const
-{
-    return (x != rvalue.x || y != rvalue.y);
-}
-
-inline bool Vector2D::operator<(const Vector2D &rvalue) const
-{
-    return x == rvalue.x ? (y < rvalue.y) : (x < rvalue.x);
-}
-
-inline bool Vector2D::operator>(const Vector2D &rvalue) const
-{
-    return x == rvalue.x ? (y > rvalue.y) : (x > rvalue.x);
-}
-
-inline bool Vector2D::operator<=(const Vector2D &rvalue) const
-{
-    return x == rvalue.x ? (y <= rvalue.y) : (x < rvalue.x);
-}
-
-inline bool Vector2D::operator>=(const Vector2D &rvalue) const
-{
-    return x == rvalue.x ? (y >= rvalue.y) : (x > rvalue.x);
-}
-
-inline void Vector2D::set_all(double xy) { x = y = xy; }
-
-void Vector2D::set_from_angle(double angle)
+template <typename T>
+void BasicVector2D<T>::set_from_angle(T angle) noexcept
 {
     x = std::cos(angle);
     y = std::sin(angle);
 }
 
-inline int Vector2D::min_axis(void) const { return x < y ? 0 : 1; }
-
-inline int Vector2D::max_axis(void) const { return x < y ? 1 : 0; }
-
-double Vector2D::length(void) const { return std::sqrt(x * x + y * y); }
-
-double Vector2D::length_squared(void) const { return (x * x + y * y); }
-
-double Vector2D::angle(void) const { return std::atan2(y, x); }
-
-void Vector2D::normalize(void)
+template <typename T>
+T BasicVector2D<T>::angle(void) const noexcept
 {
-    double l = x * x + y * y;
-    if (l != 0) {
-        l = std::sqrt(l);
-        x /= l;
-        y /= l;
-    }
+    return std::atan2(y, x);
 }
 
-Vector2D Vector2D::normalized(void) const
-{
-    Vector2D v = *this;
-    v.normalize();
-    return v;
-}
-
-double Vector2D::dot(const Vector2D &other_vector) const
-{
-    return x * other_vector.x + y * other_vector.y;
-}
-
-double Vector2D::cross(const Vector2D &other_vector) const
-{
-    return x * other_vector.y - y * other_vector.x;
-}
-
-double Vector2D::angle_formed_by(const Vector2D &other_vector) const
+template <typename T>
+T BasicVector2D<T>::angle_formed_by(const BasicVector2D<T> &other_vector) const noexcept
 {
     return std::atan2(cross(other_vector), dot(other_vector));
 }
 
-double Vector2D::angle_to_point(const Point2D &other_point) const
+template <typename T>
+T BasicVector2D<T>::angle_to_point(const BasicVector2D<T> &other_point) const noexcept
 {
     return (*this - other_point).angle();
 }
 
-double Vector2D::distance_to(const Point2D &other_point) const
-{
-    Vector2D ret(other_point.x - x, other_point.y - y);
-    return ret.length();
-}
-
-Vector2D Vector2D::direction_to(const Point2D &other_point) const
-{
-    Vector2D ret(other_point.x - x, other_point.y - y);
-    ret.normalize();
-    return ret;
-}
+// Explicitly instantiate all the supported precisions
+template struct essentials::BasicVector2D<float>;
+template struct essentials::BasicVector2D<double>;
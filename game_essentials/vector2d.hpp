@@ -41,7 +41,7 @@
 namespace essentials
 {
     /**
-     * @class   Vector2D
+     * @class   BasicVector2D
      *
      * @brief   Mathematical 2D vector.
      *
@@ -50,6 +50,10 @@ namespace essentials
      * A class representing a two-dimensional, mathematical vector with all the features that are
      * required for a game, such as adding, multiplying and normalising vectors.
      *
+     * The class is a template over the type of the components. Vector2D uses double precision and
+     * Vector2DF single precision, which is plenty for particle effects and halves the memory
+     * traffic.
+     *
      * @section USAGE
      *
      * @code
@@ -70,7 +74,8 @@ namespace essentials
      *
      * @endcode
      */
-    struct Vector2D
+    template <typename T>
+    struct BasicVector2D
     {
         /**
          * @brief   A set of anonymous unions and structures that hold the vector data.
@@ -81,16 +86,16 @@ namespace essentials
             {
                 union
                 {
-                    double x;      ///< The X component. Alternate name for width.
-                    double width;  ///< The width component. Alternate name for X.
+                    T x;       ///< The X component. Alternate name for width.
+                    T width;   ///< The width component. Alternate name for X.
                 };
                 union
                 {
-                    double y;       ///< The Y component. Alternate name for height.
-                    double height;  ///< The height component. Alternate name for Y.
+                    T y;       ///< The Y component. Alternate name for height.
+                    T height;  ///< The height component. Alternate name for Y.
                 };
             };
-            double coord[2] = {0};  ///< Both components as an array.
+            T coord[2] = {0};  ///< Both components as an array.
         };
 
         /**
@@ -100,7 +105,7 @@ namespace essentials
          *
          * Creates a [0; 0] vector.
          */
-        Vector2D(void);
+        constexpr BasicVector2D(void) noexcept;
 
         /**
          * @brief   Parametrised constructor.
@@ -108,154 +113,154 @@ namespace essentials
          * @param   x           Value to which to initialise the X axis.
          * @param   y           Value to which to initialise the Y axis.
          */
-        Vector2D(double x, double y);
+        constexpr BasicVector2D(T x, T y) noexcept;
 
         /**
          * @brief   The subscript operator.
          */
-        inline double &operator[](int index);
+        constexpr T &operator[](int index) noexcept;
 
         /**
          * @brief   The constant subscript operator.
          */
-        inline const double &operator[](int index) const;
+        constexpr const T &operator[](int index) const noexcept;
 
         /**
          * @brief   The addition operator.
          */
-        inline Vector2D operator+(const Vector2D &rvalue) const;
+        constexpr BasicVector2D<T> operator+(const BasicVector2D<T> &rvalue) const noexcept;
 
         /**
          * @brief   The addition assignment operator.
          */
-        inline void operator+=(const Vector2D &rvalue);
+        constexpr void operator+=(const BasicVector2D<T> &rvalue) noexcept;
 
         /**
          * @brief   The subtraction operator.
          */
-        inline Vector2D operator-(const Vector2D &rvalue) const;
+        constexpr BasicVector2D<T> operator-(const BasicVector2D<T> &rvalue) const noexcept;
 
         /**
          * @brief   The subtraction assignment operator.
          */
-        inline void operator-=(const Vector2D &rvalue);
+        constexpr void operator-=(const BasicVector2D<T> &rvalue) noexcept;
 
         /**
          * @brief   The vector multiplication operator.
          */
-        inline Vector2D operator*(const Vector2D &rvalue) const;
+        constexpr BasicVector2D<T> operator*(const BasicVector2D<T> &rvalue) const noexcept;
 
         /**
          * @brief   The scalar multiplication operator.
          */
-        inline Vector2D operator*(const double &rvalue) const;
+        constexpr BasicVector2D<T> operator*(const T &rvalue) const noexcept;
 
         /**
          * @brief   The vector multiplication assignment operator.
          */
-        inline void operator*=(const Vector2D &rvalue);
+        constexpr void operator*=(const BasicVector2D<T> &rvalue) noexcept;
 
         /**
          * @brief   The scalar multiplication assignment operator.
          */
-        inline void operator*=(const double &rvalue);
+        constexpr void operator*=(const T &rvalue) noexcept;
 
         /**
          * @brief   The vector division operator.
          */
-        inline Vector2D operator/(const Vector2D &rvalue) const;
+        constexpr BasicVector2D<T> operator/(const BasicVector2D<T> &rvalue) const noexcept;
 
         /**
          * @brief   The scalar division operator.
          */
-        inline Vector2D operator/(const double &rvalue) const;
+        constexpr BasicVector2D<T> operator/(const T &rvalue) const noexcept;
 
         /**
          * @brief   The vector division assignment operator.
          */
-        inline void operator/=(const Vector2D &rvalue);
+        constexpr void operator/=(const BasicVector2D<T> &rvalue) noexcept;
 
         /**
          * @brief   The scalar division assignment operator.
          */
-        inline void operator/=(const double &rvalue);
+        constexpr void operator/=(const T &rvalue) noexcept;
 
         /**
          * @brief   The unary negation operator.
          */
-        inline Vector2D operator-(void) const;
+        constexpr BasicVector2D<T> operator-(void) const noexcept;
 
         /**
          * @brief   The "equal to" operator.
          */
-        inline bool operator==(const Vector2D &rvalue) const;
+        constexpr bool operator==(const BasicVector2D<T> &rvalue) const noexcept;
 
         /**
          * @brief   The "not equal to" operator.
          */
-        inline bool operator!=(const Vector2D &rvalue) const;
+        constexpr bool operator!=(const BasicVector2D<T> &rvalue) const noexcept;
 
         /**
          * @brief   The "less than" operator.
          */
-        inline bool operator<(const Vector2D &rvalue) const;
+        constexpr bool operator<(const BasicVector2D<T> &rvalue) const noexcept;
 
         /**
          * @brief   The "greater than" operator.
          */
-        inline bool operator>(const Vector2D &rvalue) const;
+        constexpr bool operator>(const BasicVector2D<T> &rvalue) const noexcept;
 
         /**
          * @brief   The "less or equal than" operator.
          */
-        inline bool operator<=(const Vector2D &rvalue) const;
+        constexpr bool operator<=(const BasicVector2D<T> &rvalue) const noexcept;
 
         /**
          * @brief   The "greater or equal than" operator.
          */
-        inline bool operator>=(const Vector2D &rvalue) const;
+        constexpr bool operator>=(const BasicVector2D<T> &rvalue) const noexcept;
 
         /**
          * @brief   Sets both vector components to the specified value.
          *
          * @param   xy              The new value for components.
          */
-        inline void set_all(double xy);
+        constexpr void set_all(T xy) noexcept;
 
         /**
          * @brief   Sets both components to form a new unit vector with the given angle.
          *
          * @param   angle           Angle in radians.
          */
-        void set_from_angle(double angle);
+        void set_from_angle(T angle) noexcept;
 
         /**
          * @brief   Returns the axis with the lower value.
          *
          * @return  The axis with the lower value.
          */
-        inline int min_axis(void) const;
+        constexpr int min_axis(void) const noexcept;
 
         /**
          * @brief   Returns the axis with the greater value.
          *
          * @return  The axis with the greater value.
          */
-        inline int max_axis(void) const;
+        constexpr int max_axis(void) const noexcept;
 
         /**
          * @brief   Returns the length of this vector.
          *
          * @return  The length.
          */
-        double length(void) const;
+        T length(void) const noexcept;
 
         /**
          * @brief   Returns the length of this vector, squared.
          *
          * @return  The length.
          */
-        double length_squared(void) const;
+        constexpr T length_squared(void) const noexcept;
 
         /**
          * @brief   Returns this vector's angle with respect to the positive X axis, or [1; 0]
@@ -263,19 +268,19 @@ namespace essentials
          *
          * @return  Angle in radians.
          */
-        double angle(void) const;
+        T angle(void) const noexcept;
 
         /**
          * @brief   Normalises the vector in-place.
          */
-        void normalize(void);
+        void normalize(void) noexcept;
 
         /**
          * @brief   Returns a new vector that has values of the normalised original vector.
          *
          * @return  New instance of the vector with normalised axes.
          */
-        Vector2D normalized(void) const;
+        BasicVector2D<T> normalized(void) const noexcept;
 
         /**
          * @brief   Returns the dot product between this vector and other_vector.
@@ -284,7 +289,7 @@ namespace essentials
          *
          * @return  Dot product.
          */
-        double dot(const Vector2D &other_vector) const;
+        constexpr T dot(const BasicVector2D<T> &other_vector) const noexcept;
 
         /**
          * @brief   Returns the cross product between this vector and other_vector.
@@ -293,7 +298,7 @@ namespace essentials
          *
          * @return  Cross product.
          */
-        double cross(const Vector2D &other_vector) const;
+        constexpr T cross(const BasicVector2D<T> &other_vector) const noexcept;
 
         /**
          * @brief   Returns the angle in radians formed by two rays defined by this vector and the
@@ -303,7 +308,7 @@ namespace essentials
          *
          * @return  Angle in radians.
          */
-        double angle_formed_by(const Vector2D &other_vector) const;
+        T angle_formed_by(const BasicVector2D<T> &other_vector) const noexcept;
 
         /**
          * @brief   Returns the angle in radians between the line connecting the two points and the
@@ -313,7 +318,7 @@ namespace essentials
          *
          * @return  Angle in radians.
          */
-        double angle_to_point(const Point2D &other_point) const;
+        T angle_to_point(const BasicVector2D<T> &other_point) const noexcept;
 
         /**
          * @brief   Returns the distance to another point.
@@ -322,7 +327,7 @@ namespace essentials
          *
          * @return  Returns the distance.
          */
-        double distance_to(const Point2D &other_point) const;
+        T distance_to(const BasicVector2D<T> &other_point) const noexcept;
 
         /**
          * @brief   Returns the normalised vector pointing from this point (a) to the other point
@@ -332,9 +337,15 @@ namespace essentials
          *
          * @return  Returns the normalised vector that is the direction to the other_point.
          */
-        Vector2D direction_to(const Point2D &other_point) const;
+        BasicVector2D<T> direction_to(const BasicVector2D<T> &other_point) const noexcept;
     };
 
+
+    /**
+     * @brief   Double precision 2D vector.
+     */
+    typedef BasicVector2D<double> Vector2D;
+
     /**
      * @brief   Alternate name for the Vector2D class.
      */
@@ -344,4 +355,224 @@ namespace essentials
      * @brief   Alternate name for the Vector2D class.
      */
     typedef Vector2D Point2D;
+
+    /**
+     * @brief   Single precision 2D vector.
+     */
+    typedef BasicVector2D<float> Vector2DF;
+
+    /**
+     * @brief   Alternate name for the Vector2DF class.
+     */
+    typedef Vector2DF Size2DF;
+
+    /**
+     * @brief   Alternate name for the Vector2DF class.
+     */
+    typedef Vector2DF Point2DF;
+
+    /*
+     * The arithmetic is defined right here in the header, so that it can be inlined into (and
+     * constant-folded by) the callers in other libraries. Only the methods built on top of
+     * trigonometric functions live in vector2d.cpp.
+     */
+
+    template <typename T>
+    constexpr BasicVector2D<T>::BasicVector2D(void) noexcept : x(T(0)), y(T(0)) {}
+
+    template <typename T>
+    constexpr BasicVector2D<T>::BasicVector2D(T x, T y) noexcept : x(x), y(y) {}
+
+    template <typename T>
+    constexpr T &BasicVector2D<T>::operator[](int index) noexcept { return (index == 0) ? x : y; }
+
+    template <typename T>
+    constexpr const T &BasicVector2D<T>::operator[](int index) const noexcept
+    {
+        return (index == 0) ? x : y;
+    }
+
+    template <typename T>
+    constexpr BasicVector2D<T> BasicVector2D<T>::operator+(
+        const BasicVector2D<T> &rvalue) const noexcept
+    {
+        return BasicVector2D<T>(x + rvalue.x, y + rvalue.y);
+    }
+
+    template <typename T>
+    constexpr void BasicVector2D<T>::operator+=(const BasicVector2D<T> &rvalue) noexcept
+    {
+        x += rvalue.x;
+        y += rvalue.y;
+    }
+
+    template <typename T>
+    constexpr BasicVector2D<T> BasicVector2D<T>::operator-(
+        const BasicVector2D<T> &rvalue) const noexcept
+    {
+        return BasicVector2D<T>(x - rvalue.x, y - rvalue.y);
+    }
+
+    template <typename T>
+    constexpr void BasicVector2D<T>::operator-=(const BasicVector2D<T> &rvalue) noexcept
+    {
+        x -= rvalue.x;
+        y -= rvalue.y;
+    }
+
+    template <typename T>
+    constexpr BasicVector2D<T> BasicVector2D<T>::operator*(
+        const BasicVector2D<T> &rvalue) const noexcept
+    {
+        return BasicVector2D<T>(x * rvalue.x, y * rvalue.y);
+    }
+
+    template <typename T>
+    constexpr BasicVector2D<T> BasicVector2D<T>::operator*(const T &rvalue) const noexcept
+    {
+        return BasicVector2D<T>(x * rvalue, y * rvalue);
+    }
+
+    template <typename T>
+    constexpr void BasicVector2D<T>::operator*=(const BasicVector2D<T> &rvalue) noexcept
+    {
+        x *= rvalue.x;
+        y *= rvalue.y;
+    }
+
+    template <typename T>
+    constexpr void BasicVector2D<T>::operator*=(const T &rvalue) noexcept
+    {
+        x *= rvalue;
+        y *= rvalue;
+    }
+
+    template <typename T>
+    constexpr BasicVector2D<T> BasicVector2D<T>::operator/(
+        const BasicVector2D<T> &rvalue) const noexcept
+    {
+        return BasicVector2D<T>(x / rvalue.x, y / rvalue.y);
+    }
+
+    template <typename T>
+    constexpr BasicVector2D<T> BasicVector2D<T>::operator/(const T &rvalue) const noexcept
+    {
+        return BasicVector2D<T>(x / rvalue, y / rvalue);
+    }
+
+    template <typename T>
+    constexpr void BasicVector2D<T>::operator/=(const BasicVector2D<T> &rvalue) noexcept
+    {
+        x /= rvalue.x;
+        y /= rvalue.y;
+    }
+
+    template <typename T>
+    constexpr void BasicVector2D<T>::operator/=(const T &rvalue) noexcept
+    {
+        x /= rvalue;
+        y /= rvalue;
+    }
+
+    template <typename T>
+    constexpr BasicVector2D<T> BasicVector2D<T>::operator-(
+        void) const noexcept { return BasicVector2D<T>(-x, -y); }
+
+    template <typename T>
+    constexpr bool BasicVector2D<T>::operator==(const BasicVector2D<T> &rvalue) const noexcept
+    {
+        return (x == rvalue.x && y == rvalue.y);
+    }
+
+    template <typename T>
+    constexpr bool BasicVector2D<T>::operator!=(const BasicVector2D<T> &rvalue) const noexcept
+    {
+        return (x != rvalue.x || y != rvalue.y);
+    }
+
+    template <typename T>
+    constexpr bool BasicVector2D<T>::operator<(const BasicVector2D<T> &rvalue) const noexcept
+    {
+        return x == rvalue.x ? (y < rvalue.y) : (x < rvalue.x);
+    }
+
+    template <typename T>
+    constexpr bool BasicVector2D<T>::operator>(const BasicVector2D<T> &rvalue) const noexcept
+    {
+        return x == rvalue.x ? (y > rvalue.y) : (x > rvalue.x);
+    }
+
+    template <typename T>
+    constexpr bool BasicVector2D<T>::operator<=(const BasicVector2D<T> &rvalue) const noexcept
+    {
+        return x == rvalue.x ? (y <= rvalue.y) : (x < rvalue.x);
+    }
+
+    template <typename T>
+    constexpr bool BasicVector2D<T>::operator>=(const BasicVector2D<T> &rvalue) const noexcept
+    {
+        return x == rvalue.x ? (y >= rvalue.y) : (x > rvalue.x);
+    }
+
+    template <typename T>
+    constexpr void BasicVector2D<T>::set_all(T xy) noexcept { x = y = xy; }
+
+    template <typename T>
+    constexpr int BasicVector2D<T>::min_axis(void) const noexcept { return x < y ? 0 : 1; }
+
+    template <typename T>
+    constexpr int BasicVector2D<T>::max_axis(void) const noexcept { return x < y ? 1 : 0; }
+
+    template <typename T>
+    inline T BasicVector2D<T>::length(void) const noexcept { return std::sqrt(x * x + y * y); }
+
+    template <typename T>
+    constexpr T BasicVector2D<T>::length_squared(void) const noexcept { return (x * x + y * y); }
+
+    template <typename T>
+    inline void BasicVector2D<T>::normalize(void) noexcept
+    {
+        T l = x * x + y * y;
+        if (l != 0) {
+            l = std::sqrt(l);
+            x /= l;
+            y /= l;
+        }
+    }
+
+    template <typename T>
+    inline BasicVector2D<T> BasicVector2D<T>::normalized(void) const noexcept
+    {
+        BasicVector2D<T> v = *this;
+        v.normalize();
+        return v;
+    }
+
+    template <typename T>
+    constexpr T BasicVector2D<T>::dot(const BasicVector2D<T> &other_vector) const noexcept
+    {
+        return x * other_vector.x + y * other_vector.y;
+    }
+
+    template <typename T>
+    constexpr T BasicVector2D<T>::cross(const BasicVector2D<T> &other_vector) const noexcept
+    {
+        return x * other_vector.y - y * other_vector.x;
+    }
+
+    template <typename T>
+    inline T BasicVector2D<T>::distance_to(const BasicVector2D<T> &other_point) const noexcept
+    {
+        BasicVector2D<T> ret(other_point.x - x, other_point.y - y);
+        return ret.length();
+    }
+
+    template <typename T>
+    inline BasicVector2D<T> BasicVector2D<T>::direction_to(
+        const BasicVector2D<T> &other_point) const noexcept
+    {
+        BasicVector2D<T> ret(other_point.x - x, other_point.y - y);
+        ret.normalize();
+        return ret;
+    }
 }  // namespace essentials
@@ -0,0 +1,317 @@
+/**
+ * @file    vector2d_batch.cpp
+ * @author  Martin Cagas
+ *
+ * @brief   Vectorised Vector2D operations over whole arrays of vectors.
+ */
+
+#include "vector2d_batch.hpp"
+
+// Standard includes
+#include <atomic>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define VECTOR2D_BATCH_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define VECTOR2D_BATCH_NEON
+#include <arm_neon.h>
+#endif
+
+#include "vector2d_batch_kernels.hpp"
+
+using namespace essentials;
+using namespace essentials::batch;
+
+namespace
+{
+#ifdef VECTOR2D_BATCH_SSE2
+    /**
+     * @brief   Pack of two doubles in an SSE2 register.
+     */
+    struct Sse2Pack
+    {
+        typedef double Scalar;
+        typedef __m128d Type;
+        typedef __m128d Mask;
+        static constexpr std::size_t WIDTH = 2;
+
+        static Type load(const double *p) { return _mm_loadu_pd(p); }
+        static void store(double *p, Type a) { _mm_storeu_pd(p, a); }
+        static Type set1(double a) { return _mm_set1_pd(a); }
+        static Type add(Type a, Type b) { return _mm_add_pd(a, b); }
+        static Type sub(Type a, Type b) { return _mm_sub_pd(a, b); }
+        static Type mul(Type a, Type b) { return _mm_mul_pd(a, b); }
+        static Type div(Type a, Type b) { return _mm_div_pd(a, b); }
+        static Type sqrt(Type a) { return _mm_sqrt_pd(a); }
+        static Mask not_zero(Type a) { return _mm_cmpneq_pd(a, _mm_setzero_pd()); }
+        static Type select(Mask m, Type a, Type b)
+        {
+            return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b));
+        }
+    };
+
+    /**
+     * @brief   Pack of four floats in an SSE register.
+     */
+    struct Sse2PackF
+    {
+        typedef float Scalar;
+        typedef __m128 Type;
+        typedef __m128 Mask;
+        static constexpr std::size_t WIDTH = 4;
+
+        static Type load(const float *p) { return _mm_loadu_ps(p); }
+        static void store(float *p, Type a) { _mm_storeu_ps(p, a); }
+        static Type set1(float a) { return _mm_set1_ps(a); }
+        static Type add(Type a, Type b) { return _mm_add_ps(a, b); }
+        static Type sub(Type a, Type b) { return _mm_sub_ps(a, b); }
+        static Type mul(Type a, Type b) { return _mm_mul_ps(a, b); }
+        static Type div(Type a, Type b) { return _mm_div_ps(a, b); }
+        static Type sqrt(Type a) { return _mm_sqrt_ps(a); }
+        static Mask not_zero(Type a) { return _mm_cmpneq_ps(a, _mm_setzero_ps()); }
+        static Type select(Mask m, Type a, Type b)
+        {
+            return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+        }
+    };
+#endif
+
+#ifdef VECTOR2D_BATCH_NEON
+    /**
+     * @brief   Pack of two doubles in a NEON register.
+     */
+    struct NeonPack
+    {
+        typedef double Scalar;
+        typedef float64x2_t Type;
+        typedef uint64x2_t Mask;
+        static constexpr std::size_t WIDTH = 2;
+
+        static Type load(const double *p) { return vld1q_f64(p); }
+        static void store(double *p, Type a) { vst1q_f64(p, a); }
+        static Type set1(double a) { return vdupq_n_f64(a); }
+        static Type add(Type a, Type b) { return vaddq_f64(a, b); }
+        static Type sub(Type a, Type b) { return vsubq_f64(a, b); }
+        static Type mul(Type a, Type b) { return vmulq_f64(a, b); }
+        static Type div(Type a, Type b) { return vdivq_f64(a, b); }
+        static Type sqrt(Type a) { return vsqrtq_f64(a); }
+        static Mask not_zero(Type a)
+        {
+            uint64x2_t zero = vceqq_f64(a, vdupq_n_f64(0.0));
+            return veorq_u64(zero, vdupq_n_u64(~0ULL));
+        }
+        static Type select(Mask m, Type a, Type b) { return vbslq_f64(m, a, b); }
+    };
+
+    /**
+     * @brief   Pack of four floats in a NEON register.
+     */
+    struct NeonPackF
+    {
+        typedef float Scalar;
+        typedef float32x4_t Type;
+        typedef uint32x4_t Mask;
+        static constexpr std::size_t WIDTH = 4;
+
+        static Type load(const float *p) { return vld1q_f32(p); }
+        static void store(float *p, Type a) { vst1q_f32(p, a); }
+        static Type set1(float a) { return vdupq_n_f32(a); }
+        static Type add(Type a, Type b) { return vaddq_f32(a, b); }
+        static Type sub(Type a, Type b) { return vsubq_f32(a, b); }
+        static Type mul(Type a, Type b) { return vmulq_f32(a, b); }
+        static Type div(Type a, Type b) { return vdivq_f32(a, b); }
+        static Type sqrt(Type a) { return vsqrtq_f32(a); }
+        static Mask not_zero(Type a) { return vmvnq_u32(vceqq_f32(a, vdupq_n_f32(0.0f))); }
+        static Type select(Mask m, Type a, Type b) { return vbslq_f32(m, a, b); }
+    };
+#endif
+
+    /**
+     * @brief   The packs of each instruction set for a given precision.
+     */
+    template <typename T>
+    struct Packs;
+
+    template <>
+    struct Packs<double>
+    {
+#ifdef VECTOR2D_BATCH_SSE2
+        typedef Sse2Pack Sse2;
+#endif
+#ifdef VECTOR2D_BATCH_NEON
+        typedef NeonPack Neon;
+#endif
+    };
+
+    template <>
+    struct Packs<float>
+    {
+#ifdef VECTOR2D_BATCH_SSE2
+        typedef Sse2PackF Sse2;
+#endif
+#ifdef VECTOR2D_BATCH_NEON
+        typedef NeonPackF Neon;
+#endif
+    };
+
+    /**
+     * @brief   Returns true if the CPU supports AVX2.
+     */
+    bool cpu_supports_avx2(void)
+    {
+#if defined(VECTOR2D_BATCH_AVX2) && (defined(__GNUC__) || defined(__clang__))
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief   Returns the kernels of an instruction set, or nullptr if they are not available.
+     */
+    template <typename T>
+    const detail::KernelTable<T> *find_kernels(InstructionSet instruction_set)
+    {
+        static const detail::KernelTable<T> scalar_kernels = Kernels<ScalarPack<T>>::make_table();
+#ifdef VECTOR2D_BATCH_SSE2
+        static const detail::KernelTable<T> sse2_kernels =
+            Kernels<typename Packs<T>::Sse2>::make_table();
+#endif
+#ifdef VECTOR2D_BATCH_NEON
+        static const detail::KernelTable<T> neon_kernels =
+            Kernels<typename Packs<T>::Neon>::make_table();
+#endif
+
+        switch (instruction_set) {
+            case InstructionSet::SCALAR:
+                return &scalar_kernels;
+#ifdef VECTOR2D_BATCH_SSE2
+            case InstructionSet::SSE2:
+                return &sse2_kernels;
+#endif
+#ifdef VECTOR2D_BATCH_AVX2
+            case InstructionSet::AVX2:
+                return cpu_supports_avx2() ? &detail::get_avx2_kernels<T>() : nullptr;
+#endif
+#ifdef VECTOR2D_BATCH_NEON
+            case InstructionSet::NEON:
+                return &neon_kernels;
+#endif
+            default:
+                return nullptr;
+        }
+    }
+
+    /**
+     * @brief   Returns the best instruction set supported by both the build and the CPU.
+     */
+    InstructionSet detect_instruction_set(void)
+    {
+        const InstructionSet preferred[] = {InstructionSet::AVX2, InstructionSet::SSE2,
+                                            InstructionSet::NEON};
+        for (InstructionSet instruction_set : preferred) {
+            if (find_kernels<double>(instruction_set) != nullptr) {
+                return instruction_set;
+            }
+        }
+        return InstructionSet::SCALAR;
+    }
+
+    /**
+     * @brief   The instruction set in use, detected on first use.
+     */
+    std::atomic<InstructionSet> &active_instruction_set(void)
+    {
+        static std::atomic<InstructionSet> instruction_set(detect_instruction_set());
+        return instruction_set;
+    }
+
+    /**
+     * @brief   The kernels in use.
+     */
+    template <typename T>
+    const detail::KernelTable<T> &active_kernels(void)
+    {
+        return *find_kernels<T>(active_instruction_set().load(std::memory_order_relaxed));
+    }
+}  // namespace
+
+InstructionSet batch::get_instruction_set(void)
+{
+    return active_instruction_set().load(std::memory_order_relaxed);
+}
+
+bool batch::set_instruction_set(InstructionSet instruction_set)
+{
+    // Both precisions are always compiled for the same instruction sets.
+    if (find_kernels<double>(instruction_set) == nullptr) {
+        return false;
+    }
+
+    active_instruction_set().store(instruction_set, std::memory_order_relaxed);
+    return true;
+}
+
+template <typename T>
+void batch::add(T *x, T *y, const T *other_x, const T *other_y, std::size_t count)
+{
+    active_kernels<T>().add(x, y, other_x, other_y, count);
+}
+
+template <typename T>
+void batch::scale(T *x, T *y, T factor, std::size_t count)
+{
+    active_kernels<T>().scale(x, y, factor, count);
+}
+
+template <typename T>
+void batch::multiply_add(T *x, T *y, const T *other_x, const T *other_y, T factor,
+                         std::size_t count)
+{
+    active_kernels<T>().multiply_add(x, y, other_x, other_y, factor, count);
+}
+
+template <typename T>
+void batch::length(const T *x, const T *y, T *out, std::size_t count)
+{
+    active_kernels<T>().length(x, y, out, count);
+}
+
+template <typename T>
+void batch::normalize(T *x, T *y, std::size_t count)
+{
+    active_kernels<T>().normalize(x, y, count);
+}
+
+template <typename T>
+void batch::distance_to(const T *x, const T *y, const BasicVector2D<T> &other_point, T *out,
+                        std::size_t count)
+{
+    active_kernels<T>().distance_to(x, y, other_point, out, count);
+}
+
+template <typename T>
+void batch::direction_to(const T *x, const T *y, const BasicVector2D<T> &other_point, T *out_x,
+                         T *out_y, std::size_t count)
+{
+    active_kernels<T>().direction_to(x, y, other_point, out_x, out_y, count);
+}
+
+// Explicitly instantiate all the supported precisions
+#define VECTOR2D_BATCH_INSTANTIATE(T)                                                          \
+    template void batch::add<T>(T *, T *, const T *, const T *, std::size_t);                  \
+    template void batch::scale<T>(T *, T *, T, std::size_t);                                   \
+    template void batch::multiply_add<T>(T *, T *, const T *, const T *, T, std::size_t);      \
+    template void batch::length<T>(const T *, const T *, T *, std::size_t);                    \
+    template void batch::normalize<T>(T *, T *, std::size_t);                                  \
+    template void batch::distance_to<T>(const T *, const T *, const BasicVector2D<T> &, T *,   \
+                                        std::size_t);                                          \
+    template void batch::direction_to<T>(const T *, const T *, const BasicVector2D<T> &, T *,  \
+                                         T *, std::size_t);
+
+VECTOR2D_BATCH_INSTANTIATE(float)
+VECTOR2D_BATCH_INSTANTIATE(double)
@@ -0,0 +1,134 @@
+/**
+ * @file    vector2d_batch.hpp
+ * @author  Martin Cagas
+ *
+ * @brief   Vectorised Vector2D operations over whole arrays of vectors.
+ */
+
+#pragma once
+
+#include <cstdlib>
+
+#include "vector2d.hpp"
+
+namespace essentials
+{
+    /**
+     * @brief   Batched counterparts of the Vector2D methods.
+     *
+     * @section DESCRIPTION
+     *
+     * Every function applies one Vector2D operation to a whole array of vectors, given as separate
+     * arrays of X and Y components (the layout of ParticleStore). The work is done by SIMD kernels
+     * picked at runtime for the best instruction set supported by the CPU - AVX2 or SSE2 on x86,
+     * NEON on ARM64 - with a portable scalar fallback for everything else.
+     *
+     * The kernels perform exactly the same IEEE operations in the same order as the corresponding
+     * Vector2D methods and all of those operations are correctly rounded in every instruction set,
+     * so the results match the scalar methods bit-for-bit. The only exception is multiply_add(),
+     * which is never fused - on targets where the compiler contracts the scalar "v += o * s" into
+     * an FMA instruction, the results may differ from it by 1 ULP.
+     *
+     * All functions are available for float and double components. The float kernels process twice
+     * as many vectors per instruction.
+     *
+     * The arrays may alias only where a function writes in-place into its own input.
+     *
+     * @section USAGE
+     *
+     * @code
+     *
+     * batch::add(x.data(), y.data(), vx.data(), vy.data(), x.size());
+     *
+     * batch::normalize(vx.data(), vy.data(), vx.size());
+     *
+     * @endcode
+     */
+    namespace batch
+    {
+        /**
+         * @brief   Instruction sets the kernels are available for.
+         */
+        enum class InstructionSet
+        {
+            SCALAR,  ///< Portable fallback without SIMD.
+            SSE2,    ///< 128-bit x86 SIMD.
+            AVX2,    ///< 256-bit x86 SIMD.
+            NEON,    ///< 128-bit ARM64 SIMD.
+        };
+
+        /**
+         * @brief   Returns the instruction set of the kernels currently in use.
+         */
+        InstructionSet get_instruction_set(void);
+
+        /**
+         * @brief   Forces the kernels of a specific instruction set to be used.
+         *
+         * @details
+         *
+         * Mostly useful for comparing the kernels against each other.
+         *
+         * @param   instruction_set     The requested instruction set.
+         *
+         * @return  True on success, false if the instruction set is not supported by the CPU or
+         *          not compiled in. The kernels in use stay unchanged in that case.
+         */
+        bool set_instruction_set(InstructionSet instruction_set);
+
+        /**
+         * @brief   Adds the other vectors to the vectors in-place, like Vector2D::operator+=().
+         */
+        template <typename T>
+        void add(T *x, T *y, const T *other_x, const T *other_y, std::size_t count);
+
+        /**
+         * @brief   Multiplies the vectors by a scalar in-place, like Vector2D::operator*=().
+         */
+        template <typename T>
+        void scale(T *x, T *y, T factor, std::size_t count);
+
+        /**
+         * @brief   Adds the other vectors multiplied by a scalar to the vectors in-place.
+         *
+         * @details
+         *
+         * Equivalent to "v += o * factor" - rounded twice, not fused.
+         */
+        template <typename T>
+        void multiply_add(T *x, T *y, const T *other_x, const T *other_y, T factor,
+                          std::size_t count);
+
+        /**
+         * @brief   Writes the lengths of the vectors, like Vector2D::length().
+         */
+        template <typename T>
+        void length(const T *x, const T *y, T *out, std::size_t count);
+
+        /**
+         * @brief   Normalises the vectors in-place, like Vector2D::normalize().
+         *
+         * @details
+         *
+         * Zero vectors are left as they are.
+         */
+        template <typename T>
+        void normalize(T *x, T *y, std::size_t count);
+
+        /**
+         * @brief   Writes the distances from the points to another point, like
+         * Vector2D::distance_to().
+         */
+        template <typename T>
+        void distance_to(const T *x, const T *y, const BasicVector2D<T> &other_point, T *out,
+                         std::size_t count);
+
+        /**
+         * @brief   Writes the normalised directions from the points to another point, like
+         * Vector2D::direction_to().
+         */
+        template <typename T>
+        void direction_to(const T *x, const T *y, const BasicVector2D<T> &other_point, T *out_x,
+                          T *out_y, std::size_t count);
+    }  // namespace batch
+}  // namespace essentials
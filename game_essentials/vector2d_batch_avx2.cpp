@@ -0,0 +1,82 @@
+/**
+ * @file    vector2d_batch_avx2.cpp
+ * @author  Martin Cagas
+ *
+ * @brief   AVX2 kernels of the batched Vector2D operations.
+ *
+ * @section DESCRIPTION
+ *
+ * This translation unit is the only one compiled with AVX2 enabled. Its kernels are only ever
+ * called after the CPU has been checked for AVX2 support, see vector2d_batch.cpp.
+ */
+
+#include <immintrin.h>
+
+#include "vector2d_batch_kernels.hpp"
+
+namespace
+{
+    /**
+     * @brief   Pack of four doubles in an AVX register.
+     */
+    struct Avx2Pack
+    {
+        typedef double Scalar;
+        typedef __m256d Type;
+        typedef __m256d Mask;
+        static constexpr std::size_t WIDTH = 4;
+
+        static Type load(const double *p) { return _mm256_loadu_pd(p); }
+        static void store(double *p, Type a) { _mm256_storeu_pd(p, a); }
+        static Type set1(double a) { return _mm256_set1_pd(a); }
+        static Type add(Type a, Type b) { return _mm256_add_pd(a, b); }
+        static Type sub(Type a, Type b) { return _mm256_sub_pd(a, b); }
+        static Type mul(Type a, Type b) { return _mm256_mul_pd(a, b); }
+        static Type div(Type a, Type b) { return _mm256_div_pd(a, b); }
+        static Type sqrt(Type a) { return _mm256_sqrt_pd(a); }
+        static Mask not_zero(Type a) { return _mm256_cmp_pd(a, _mm256_setzero_pd(), _CMP_NEQ_UQ); }
+        static Type select(Mask m, Type a, Type b) { return _mm256_blendv_pd(b, a, m); }
+    };
+
+    /**
+     * @brief   Pack of eight floats in an AVX register.
+     */
+    struct Avx2PackF
+    {
+        typedef float Scalar;
+        typedef __m256 Type;
+        typedef __m256 Mask;
+        static constexpr std::size_t WIDTH = 8;
+
+        static Type load(const float *p) { return _mm256_loadu_ps(p); }
+        static void store(float *p, Type a) { _mm256_storeu_ps(p, a); }
+        static Type set1(float a) { return _mm256_set1_ps(a); }
+        static Type add(Type a, Type b) { return _mm256_add_ps(a, b); }
+        static Type sub(Type a, Type b) { return _mm256_sub_ps(a, b); }
+        static Type mul(Type a, Type b) { return _mm256_mul_ps(a, b); }
+        static Type div(Type a, Type b) { return _mm256_div_ps(a, b); }
+        static Type sqrt(Type a) { return _mm256_sqrt_ps(a); }
+        static Mask not_zero(Type a) { return _mm256_cmp_ps(a, _mm256_setzero_ps(), _CMP_NEQ_UQ); }
+        static Type select(Mask m, Type a, Type b) { return _mm256_blendv_ps(b, a, m); }
+    };
+
+    constexpr essentials::batch::detail::KernelTable<double> avx2_kernels =
+        Kernels<Avx2Pack>::make_table();
+
+    constexpr essentials::batch::detail::KernelTable<float> avx2_kernels_f =
+        Kernels<Avx2PackF>::make_table();
+}  // namespace
+
+template <>
+const essentials::batch::detail::KernelTable<double> &
+essentials::batch::detail::get_avx2_kernels<double>(void)
+{
+    return avx2_kernels;
+}
+
+template <>
+const essentials::batch::detail::KernelTable<float> &
+essentials::batch::detail::get_avx2_kernels<float>(void)
+{
+    return avx2_kernels_f;
+}
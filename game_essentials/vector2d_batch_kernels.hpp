@@ -0,0 +1,226 @@
+/**
+ * @file    vector2d_batch_kernels.hpp
+ * @author  Martin Cagas
+ *
+ * @brief   Instruction set independent implementation of the batched Vector2D operations.
+ *
+ * @section DESCRIPTION
+ *
+ * Private header of the batch module, only to be included by its translation units. Each kernel is
+ * written once against a "pack" - a small traits struct wrapping the SIMD register type and
+ * intrinsics of one instruction set - and instantiated by every translation unit for the packs it
+ * is compiled for. The kernels live in an anonymous namespace, so instantiations compiled with
+ * different target flags never get merged by the linker.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdlib>
+#include <math.h>
+
+#include "vector2d.hpp"
+
+namespace essentials
+{
+    namespace batch
+    {
+        namespace detail
+        {
+            /**
+             * @brief   Table of kernels of a single instruction set and precision.
+             */
+            template <typename T>
+            struct KernelTable
+            {
+                void (*add)(T *, T *, const T *, const T *, std::size_t);
+                void (*scale)(T *, T *, T, std::size_t);
+                void (*multiply_add)(T *, T *, const T *, const T *, T, std::size_t);
+                void (*length)(const T *, const T *, T *, std::size_t);
+                void (*normalize)(T *, T *, std::size_t);
+                void (*distance_to)(const T *, const T *, const BasicVector2D<T> &, T *,
+                                    std::size_t);
+                void (*direction_to)(const T *, const T *, const BasicVector2D<T> &, T *, T *,
+                                     std::size_t);
+            };
+
+            /**
+             * @brief   Returns the AVX2 kernels, defined in vector2d_batch_avx2.cpp.
+             */
+            template <typename T>
+            const KernelTable<T> &get_avx2_kernels(void);
+        }  // namespace detail
+    }      // namespace batch
+}  // namespace essentials
+
+namespace
+{
+    /**
+     * @brief   Square root calling the C library directly.
+     *
+     * @details
+     *
+     * std::sqrt(float) is an inline function with external linkage. Compiled without optimisations
+     * into the AVX2 translation unit, it leaves an out-of-line AVX2 copy behind, which the linker
+     * may pick for the whole program. The C functions are never compiled into the kernels.
+     */
+    inline float scalar_sqrt(float a) { return ::sqrtf(a); }
+
+    /**
+     * @brief   Square root calling the C library directly, see scalar_sqrt(float).
+     */
+    inline double scalar_sqrt(double a) { return ::sqrt(a); }
+
+    /**
+     * @brief   Pack of a single scalar, used as the fallback and for the tails of all arrays.
+     */
+    template <typename T>
+    struct ScalarPack
+    {
+        typedef T Scalar;
+        typedef T Type;
+        typedef bool Mask;
+        static constexpr std::size_t WIDTH = 1;
+
+        static Type load(const T *p) { return *p; }
+        static void store(T *p, Type a) { *p = a; }
+        static Type set1(T a) { return a; }
+        static Type add(Type a, Type b) { return a + b; }
+        static Type sub(Type a, Type b) { return a - b; }
+        static Type mul(Type a, Type b) { return a * b; }
+        static Type div(Type a, Type b) { return a / b; }
+        static Type sqrt(Type a) { return scalar_sqrt(a); }
+        static Mask not_zero(Type a) { return a != T(0); }
+        static Type select(Mask m, Type a, Type b) { return m ? a : b; }
+    };
+
+    /**
+     * @brief   The kernels, parametrised by the pack they run on.
+     *
+     * @details
+     *
+     * Every kernel processes whole packs first and hands the remaining tail to its own scalar
+     * instantiation. The order of operations follows the Vector2D methods exactly.
+     */
+    template <typename P>
+    struct Kernels
+    {
+        typedef typename P::Scalar T;
+        typedef typename P::Type V;
+        typedef Kernels<ScalarPack<T>> Tail;
+
+        static void add(T *x, T *y, const T *other_x, const T *other_y, std::size_t count)
+        {
+            std::size_t i = 0;
+            for (; i + P::WIDTH <= count; i += P::WIDTH) {
+                P::store(x + i, P::add(P::load(x + i), P::load(other_x + i)));
+                P::store(y + i, P::add(P::load(y + i), P::load(other_y + i)));
+            }
+            if (i < count) {
+                Tail::add(x + i, y + i, other_x + i, other_y + i, count - i);
+            }
+        }
+
+        static void scale(T *x, T *y, T factor, std::size_t count)
+        {
+            const V f = P::set1(factor);
+            std::size_t i = 0;
+            for (; i + P::WIDTH <= count; i += P::WIDTH) {
+                P::store(x + i, P::mul(P::load(x + i), f));
+                P::store(y + i, P::mul(P::load(y + i), f));
+            }
+            if (i < count) {
+                Tail::scale(x + i, y + i, factor, count - i);
+            }
+        }
+
+        static void multiply_add(T *x, T *y, const T *other_x, const T *other_y, T factor,
+                                 std::size_t count)
+        {
+            const V f = P::set1(factor);
+            std::size_t i = 0;
+            for (; i + P::WIDTH <= count; i += P::WIDTH) {
+                P::store(x + i, P::add(P::load(x + i), P::mul(P::load(other_x + i), f)));
+                P::store(y + i, P::add(P::load(y + i), P::mul(P::load(other_y + i), f)));
+            }
+            if (i < count) {
+                Tail::multiply_add(x + i, y + i, other_x + i, other_y + i, factor, count - i);
+            }
+        }
+
+        static void length(const T *x, const T *y, T *out, std::size_t count)
+        {
+            std::size_t i = 0;
+            for (; i + P::WIDTH <= count; i += P::WIDTH) {
+                V vx = P::load(x + i);
+                V vy = P::load(y + i);
+                P::store(out + i, P::sqrt(P::add(P::mul(vx, vx), P::mul(vy, vy))));
+            }
+            if (i < count) {
+                Tail::length(x + i, y + i, out + i, count - i);
+            }
+        }
+
+        static void normalize(T *x, T *y, std::size_t count)
+        {
+            const V one = P::set1(T(1));
+            std::size_t i = 0;
+            for (; i + P::WIDTH <= count; i += P::WIDTH) {
+                V vx = P::load(x + i);
+                V vy = P::load(y + i);
+                V l = P::add(P::mul(vx, vx), P::mul(vy, vy));
+                // Dividing zero vectors by one leaves them unchanged, like Vector2D::normalize().
+                V divisor = P::select(P::not_zero(l), P::sqrt(l), one);
+                P::store(x + i, P::div(vx, divisor));
+                P::store(y + i, P::div(vy, divisor));
+            }
+            if (i < count) {
+                Tail::normalize(x + i, y + i, count - i);
+            }
+        }
+
+        static void distance_to(const T *x, const T *y,
+                                const essentials::BasicVector2D<T> &other_point, T *out,
+                                std::size_t count)
+        {
+            const V ox = P::set1(T(other_point.x));
+            const V oy = P::set1(T(other_point.y));
+            std::size_t i = 0;
+            for (; i + P::WIDTH <= count; i += P::WIDTH) {
+                V dx = P::sub(ox, P::load(x + i));
+                V dy = P::sub(oy, P::load(y + i));
+                P::store(out + i, P::sqrt(P::add(P::mul(dx, dx), P::mul(dy, dy))));
+            }
+            if (i < count) {
+                Tail::distance_to(x + i, y + i, other_point, out + i, count - i);
+            }
+        }
+
+        static void direction_to(const T *x, const T *y,
+                                 const essentials::BasicVector2D<T> &other_point, T *out_x,
+                                 T *out_y, std::size_t count)
+        {
+            const V ox = P::set1(T(other_point.x));
+            const V oy = P::set1(T(other_point.y));
+            const V one = P::set1(T(1));
+            std::size_t i = 0;
+            for (; i + P::WIDTH <= count; i += P::WIDTH) {
+                V dx = P::sub(ox, P::load(x + i));
+                V dy = P::sub(oy, P::load(y + i));
+                V l = P::add(P::mul(dx, dx), P::mul(dy, dy));
+                V divisor = P::select(P::not_zero(l), P::sqrt(l), one);
+                P::store(out_x + i, P::div(dx, divisor));
+                P::store(out_y + i, P::div(dy, divisor));
+            }
+            if (i < count) {
+                Tail::direction_to(x + i, y + i, other_point, out_x + i, out_y + i, count - i);
+            }
+        }
+
+        static constexpr essentials::batch::detail::KernelTable<T> make_table(void)
+        {
+            return essentials::batch::detail::KernelTable<T>{
+                &add, &scale, &multiply_add, &length, &normalize, &distance_to, &direction_to};
+        }
+    };
+}  // namespace
@@ -0,0 +1,216 @@
+/**
+ * @file    main.cpp
+ * @author  Martin Cagas
+ *
+ * @brief   Headless simulation driver for batch runs and profiling.
+ *
+ * @section DESCRIPTION
+ *
+ * Builds a world from a scenario file, runs its steps back to back as fast as possible without any
+ * window or rendering and prints the throughput and the time spent in every phase of the steps.
+ * Meant for performance regression checks in CI and for profiling sessions on servers without a
+ * display. See Scenario for the format of the scenario files.
+ *
+ * @section USAGE
+ *
+ * particle-game-headless SCENARIO [--steps COUNT] [--threads COUNT] [--trace FILE]
+ *                        [--load SNAPSHOT] [--save SNAPSHOT] [--record FILE] [--replay FILE]
+ *
+ * The --steps and --threads options override the corresponding settings of the scenario. With
+ * --trace, the profiler records the run and its events are written into the file as a Chrome
+ * trace. Its ring buffers only hold the last events of every thread, so for long runs the trace
+ * covers the last steps.
+ *
+ * With --load, the world starts from the state saved in a snapshot instead of being built from the
+ * scenario, whose precision must match. With --save, the world is saved into a snapshot after the
+ * last step, e.g. to start later runs right where this one ended.
+ *
+ * With --record, the inputs and the steps of the run are recorded into a replay stream, see
+ * replay.hpp. With --replay, the world instead starts from the state at the start of a recording
+ * and runs all its steps, ignoring --steps, while its state is verified against the hashes in the
+ * stream. A divergence ends the run with an error naming the first step that differs.
+ */
+
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <string>
+
+// "Game essentials" library includes
+#include <profiler.hpp>
+
+// "Particle game core" library includes
+#include <replay.hpp>
+#include <world.hpp>
+
+// Local includes
+#include "scenario.hpp"
+
+/**
+ * @brief   Names of the step phases, in the order of StepPhase.
+ */
+static const char *const PHASE_NAMES[STEP_PHASE_COUNT] = {
+    "emission", "forces", "integration", "collisions", "obstacles", "expiry", "spatial grid",
+};
+
+/**
+ * @brief   Options of a run given on the command line.
+ */
+struct RunOptions
+{
+    const char *trace_path;   ///< File to write the trace into, null for none.
+    const char *load_path;    ///< Snapshot to start from, null to build the world of the scenario.
+    const char *save_path;    ///< Snapshot to save the world into after the run, null for none.
+    const char *record_path;  ///< Replay stream to record the run into, null for none.
+    const char *replay_path;  ///< Replay stream to run instead of the scenario, null for none.
+};
+
+/**
+ * @brief   Builds the world of a scenario, runs all its steps and prints the timings.
+ */
+template <typename T>
+static void run(const Scenario &scenario, const RunOptions &options)
+{
+    BasicWorld<T> world;
+    std::unique_ptr<BasicReplayPlayer<T>> player;
+    if (options.load_path == nullptr && options.replay_path == nullptr) {
+        build_world(scenario, world);
+    }
+    else {
+        // The snapshot holds the whole simulation, only the threads still come from the scenario.
+        world.set_thread_count(scenario.threads);
+        world.set_deterministic(scenario.deterministic);
+
+        const auto load_start = std::chrono::steady_clock::now();
+        if (options.replay_path != nullptr) {
+            player = std::make_unique<BasicReplayPlayer<T>>(options.replay_path, world);
+        }
+        else {
+            world.load_snapshot(options.load_path);
+        }
+        const std::chrono::duration<double> load_time =
+            std::chrono::steady_clock::now() - load_start;
+        std::printf("snapshot load time:   %.3f ms\n", 1000.0 * load_time.count());
+    }
+
+    std::unique_ptr<BasicReplayRecorder<T>> recorder;
+    if (options.record_path != nullptr) {
+        recorder = std::make_unique<BasicReplayRecorder<T>>(world, options.record_path);
+    }
+
+    const std::size_t initial_particles = world.get_particle_count();
+    std::size_t particle_steps = 0;
+    std::size_t step_count = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    while (player != nullptr ? player->step() : step_count < scenario.steps) {
+        if (player == nullptr) {
+            world.step();
+        }
+        step_count++;
+        particle_steps += world.get_particle_count();
+    }
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (recorder != nullptr) {
+        recorder->finish();
+    }
+
+    const double steps = static_cast<double>(std::max<std::size_t>(step_count, 1));
+    std::printf("precision:            %s\n", scenario.double_precision ? "double" : "float");
+    std::printf("threads:              %zu\n", world.get_thread_count());
+    std::printf("particles:            %zu initial, %zu final\n", initial_particles,
+                world.get_particle_count());
+    std::printf("steps:                %zu\n", step_count);
+    if (player != nullptr) {
+        std::printf("verified hashes:      %zu\n", player->get_verified_hash_count());
+    }
+    std::printf("total time:           %.3f s\n", seconds);
+    std::printf("time per step:        %.3f ms\n", 1000.0 * seconds / steps);
+    std::printf("steps per second:     %.1f\n", steps / seconds);
+    std::printf("particle steps per s: %.4g\n", static_cast<double>(particle_steps) / seconds);
+    std::printf("\n%-14s %12s %12s %8s\n", "phase", "total ms", "ms per step", "share");
+
+    for (std::size_t phase = 0; phase < STEP_PHASE_COUNT; phase++) {
+        const double phase_seconds = world.get_phase_time(static_cast<StepPhase>(phase));
+        std::printf("%-14s %12.3f %12.4f %7.1f%%\n", PHASE_NAMES[phase], 1000.0 * phase_seconds,
+                    1000.0 * phase_seconds / steps, 100.0 * phase_seconds / seconds);
+    }
+
+    if (options.save_path != nullptr) {
+        world.save_snapshot(options.save_path);
+    }
+    if (options.trace_path != nullptr) {
+        essentials::profiler::export_chrome_trace(options.trace_path);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2 || argc % 2 != 0) {
+        std::cerr << "Usage: " << argv[0]
+                  << " SCENARIO [--steps COUNT] [--threads COUNT] [--trace FILE]"
+                     " [--load SNAPSHOT] [--save SNAPSHOT] [--record FILE] [--replay FILE]"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    try {
+        Scenario scenario = load_scenario(argv[1]);
+        RunOptions options = {nullptr, nullptr, nullptr, nullptr, nullptr};
+
+        for (int i = 2; i < argc; i += 2) {
+            if (std::strcmp(argv[i], "--steps") == 0) {
+                scenario.steps = std::stoul(argv[i + 1]);
+            }
+            else if (std::strcmp(argv[i], "--threads") == 0) {
+                scenario.threads = std::stoul(argv[i + 1]);
+            }
+            else if (std::strcmp(argv[i], "--trace") == 0) {
+                options.trace_path = argv[i + 1];
+                essentials::profiler::enable();
+            }
+            else if (std::strcmp(argv[i], "--load") == 0) {
+                options.load_path = argv[i + 1];
+            }
+            else if (std::strcmp(argv[i], "--save") == 0) {
+                options.save_path = argv[i + 1];
+            }
+            else if (std::strcmp(argv[i], "--record") == 0) {
+                options.record_path = argv[i + 1];
+            }
+            else if (std::strcmp(argv[i], "--replay") == 0) {
+                options.replay_path = argv[i + 1];
+            }
+            else {
+                std::cerr << "Unknown option " << argv[i] << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+
+        if (options.load_path != nullptr && options.replay_path != nullptr) {
+            std::cerr << "The --load and --replay options cannot be combined" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        if (scenario.double_precision) {
+            run<double>(scenario, options);
+        }
+        else {
+            run<float>(scenario, options);
+        }
+    }
+    catch (const std::exception &exception) {
+        std::cerr << exception.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,375 @@
+/**
+ * @file    scenario.cpp
+ * @author  Martin Cagas
+ *
+ * @brief   Description of a simulation run, loaded from a scenario file.
+ */
+
+#include "scenario.hpp"
+
+// Standard includes
+#include <algorithm>
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+// "Game essentials" library includes
+#include <angle.hpp>
+#include <random.hpp>
+#include <vector2d.hpp>
+
+// "Particle game core" library includes
+#include <emitter.hpp>
+#include <gravity_constant.hpp>
+#include <gravity_object.hpp>
+
+using namespace essentials;
+
+/**
+ * @brief   Returns a string without its leading and trailing whitespace.
+ */
+static std::string trim(const std::string &string)
+{
+    const char *whitespace = " \t\r\n";
+    const std::size_t first = string.find_first_not_of(whitespace);
+    if (first == std::string::npos) {
+        return std::string();
+    }
+    return string.substr(first, string.find_last_not_of(whitespace) - first + 1);
+}
+
+/**
+ * @brief   Reads values of a setting into numbers.
+ *
+ * @details
+ *
+ * Reads the first required values into the numbers, then as many of the optional ones as the
+ * setting has. Fails on missing, malformed or surplus values.
+ *
+ * @param   &value          The value of the setting.
+ * @param   numbers         The numbers, optional ones keep their contents if not given.
+ * @param   required        Amount of values the setting must have.
+ *
+ * @return  True on success, false otherwise.
+ */
+static bool parse_numbers(const std::string &value, std::vector<double *> numbers,
+                          std::size_t required)
+{
+    std::istringstream stream(value);
+    std::size_t parsed = 0;
+
+    for (double *number : numbers) {
+        if (!(stream >> *number)) {
+            break;
+        }
+        parsed++;
+    }
+
+    std::string rest;
+    return parsed >= required && (parsed == numbers.size() || stream.eof()) && !(stream >> rest);
+}
+
+/**
+ * @brief   Reads a single number of a setting.
+ */
+template <typename Number>
+static bool parse_number(const std::string &value, Number &number)
+{
+    std::istringstream stream(value);
+    std::string rest;
+    return (stream >> number) && !(stream >> rest);
+}
+
+/**
+ * @brief   Reads a boolean setting, given as 0, 1, false or true.
+ */
+static bool parse_bool(const std::string &value, bool &flag)
+{
+    if (value == "1" || value == "true") {
+        flag = true;
+        return true;
+    }
+    else if (value == "0" || value == "false") {
+        flag = false;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief   Applies a single setting to a scenario.
+ *
+ * @return  True on success, false if the setting is unknown or its value invalid.
+ */
+static bool apply_setting(Scenario &scenario, const std::string &key, const std::string &value)
+{
+    if (key == "precision") {
+        scenario.double_precision = (value == "double");
+        return value == "double" || value == "float";
+    }
+    else if (key == "steps") {
+        return parse_number(value, scenario.steps);
+    }
+    else if (key == "time_step") {
+        return parse_number(value, scenario.time_step);
+    }
+    else if (key == "particles") {
+        return parse_number(value, scenario.particles);
+    }
+    else if (key == "particle_limit") {
+        return parse_number(value, scenario.particle_limit);
+    }
+    else if (key == "spawn_radius") {
+        return parse_number(value, scenario.spawn_radius);
+    }
+    else if (key == "particle_mass") {
+        return parse_number(value, scenario.particle_mass);
+    }
+    else if (key == "particle_lifetime") {
+        return parse_number(value, scenario.particle_lifetime);
+    }
+    else if (key == "particle_radius") {
+        return parse_number(value, scenario.particle_radius);
+    }
+    else if (key == "seed") {
+        return parse_number(value, scenario.seed);
+    }
+    else if (key == "integrator") {
+        if (value == "symplectic_euler") {
+            scenario.integrator = Integrator::SYMPLECTIC_EULER;
+        }
+        else if (value == "velocity_verlet") {
+            scenario.integrator = Integrator::VELOCITY_VERLET;
+        }
+        else if (value == "runge_kutta_4") {
+            scenario.integrator = Integrator::RUNGE_KUTTA_4;
+        }
+        else {
+            return false;
+        }
+        return true;
+    }
+    else if (key == "gravity_solver") {
+        if (value == "direct") {
+            scenario.gravity_solver = GravitySolver::DIRECT;
+        }
+        else if (value == "barnes_hut") {
+            scenario.gravity_solver = GravitySolver::BARNES_HUT;
+        }
+        else {
+            return false;
+        }
+        return true;
+    }
+    else if (key == "barnes_hut_theta") {
+        return parse_number(value, scenario.barnes_hut_theta);
+    }
+    else if (key == "particle_self_gravity") {
+        return parse_bool(value, scenario.particle_self_gravity);
+    }
+    else if (key == "particle_collisions") {
+        return parse_bool(value, scenario.particle_collisions);
+    }
+    else if (key == "collision_restitution") {
+        return parse_number(value, scenario.collision_restitution);
+    }
+    else if (key == "boundary") {
+        if (value == "none") {
+            scenario.boundary = BoundaryMode::NONE;
+        }
+        else if (value == "wrap") {
+            scenario.boundary = BoundaryMode::WRAP;
+        }
+        else if (value == "bounce") {
+            scenario.boundary = BoundaryMode::BOUNCE;
+        }
+        else if (value == "kill") {
+            scenario.boundary = BoundaryMode::KILL;
+        }
+        else {
+            return false;
+        }
+        return true;
+    }
+    else if (key == "bounds") {
+        double *bounds = scenario.bounds;
+        return parse_numbers(value, {&bounds[0], &bounds[1], &bounds[2], &bounds[3]}, 4);
+    }
+    else if (key == "obstacle_restitution") {
+        return parse_number(value, scenario.obstacle_restitution);
+    }
+    else if (key == "max_time_step_level") {
+        return parse_number(value, scenario.max_time_step_level);
+    }
+    else if (key == "time_step_accuracy") {
+        return parse_number(value, scenario.time_step_accuracy);
+    }
+    else if (key == "grid_cell_size") {
+        return parse_number(value, scenario.grid_cell_size);
+    }
+    else if (key == "threads") {
+        return parse_number(value, scenario.threads);
+    }
+    else if (key == "deterministic") {
+        return parse_bool(value, scenario.deterministic);
+    }
+    else if (key == "constant_gravity") {
+        return parse_number(value, scenario.constant_gravity);
+    }
+    else if (key == "constant_gravity_angle") {
+        return parse_number(value, scenario.constant_gravity_angle);
+    }
+    else if (key == "point_mass") {
+        ScenarioPointMass point_mass = {0.0, 0.0, 0.0, 0.0, 0.0};
+        scenario.point_masses.push_back(point_mass);
+        ScenarioPointMass &added = scenario.point_masses.back();
+        return parse_numbers(
+            value, {&added.x, &added.y, &added.mass, &added.softening, &added.cutoff_radius}, 3);
+    }
+    else if (key == "emitter") {
+        ScenarioEmitter emitter = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 90.0, 360.0};
+        scenario.emitters.push_back(emitter);
+        ScenarioEmitter &added = scenario.emitters.back();
+        return parse_numbers(value,
+                             {&added.x, &added.y, &added.rate, &added.lifetime, &added.min_speed,
+                              &added.max_speed, &added.direction, &added.spread},
+                             6);
+    }
+    else if (key == "line") {
+        ScenarioLine line = {0.0, 0.0, 0.0, 0.0};
+        scenario.lines.push_back(line);
+        ScenarioLine &added = scenario.lines.back();
+        return parse_numbers(value, {&added.x, &added.y, &added.normal_x, &added.normal_y}, 4) &&
+               (added.normal_x != 0.0 || added.normal_y != 0.0);
+    }
+    else if (key == "segment") {
+        ScenarioSegment segment = {0.0, 0.0, 0.0, 0.0, 0.0};
+        scenario.segments.push_back(segment);
+        ScenarioSegment &added = scenario.segments.back();
+        return parse_numbers(
+            value, {&added.start_x, &added.start_y, &added.end_x, &added.end_y, &added.thickness},
+            4);
+    }
+    else if (key == "circle") {
+        ScenarioCircle circle = {0.0, 0.0, 0.0};
+        scenario.circles.push_back(circle);
+        ScenarioCircle &added = scenario.circles.back();
+        return parse_numbers(value, {&added.x, &added.y, &added.radius}, 3);
+    }
+    return false;
+}
+
+Scenario load_scenario(const std::string &path)
+{
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("Cannot open scenario " + path);
+    }
+
+    Scenario scenario;
+    std::string line;
+    for (std::size_t line_number = 1; std::getline(file, line); line_number++) {
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) {
+            continue;
+        }
+
+        const std::size_t equals = line.find('=');
+        if (equals == std::string::npos ||
+            !apply_setting(scenario, trim(line.substr(0, equals)), trim(line.substr(equals + 1)))) {
+            throw std::runtime_error(path + ":" + std::to_string(line_number) +
+                                     ": invalid setting \"" + line + "\"");
+        }
+    }
+
+    return scenario;
+}
+
+template <typename T>
+void build_world(const Scenario &scenario, BasicWorld<T> &world)
+{
+    world.set_thread_count(scenario.threads);
+    world.set_deterministic(scenario.deterministic);
+    world.set_time_step(T(scenario.time_step));
+    world.set_integrator(scenario.integrator);
+    world.set_gravity_solver(scenario.gravity_solver);
+    world.set_barnes_hut_theta(T(scenario.barnes_hut_theta));
+    world.set_particle_self_gravity(scenario.particle_self_gravity);
+    world.set_particle_collisions(scenario.particle_collisions);
+    world.set_collision_restitution(T(scenario.collision_restitution));
+    world.set_boundary_mode(scenario.boundary);
+    world.set_bounds(BasicVector2D<T>(T(scenario.bounds[0]), T(scenario.bounds[1])),
+                     BasicVector2D<T>(T(scenario.bounds[2]), T(scenario.bounds[3])));
+    world.set_obstacle_restitution(T(scenario.obstacle_restitution));
+    world.set_max_time_step_level(scenario.max_time_step_level);
+    world.set_time_step_accuracy(T(scenario.time_step_accuracy));
+    world.set_grid_cell_size(T(scenario.grid_cell_size));
+    world.set_particle_limit(std::max(scenario.particle_limit, scenario.particles));
+
+    if (scenario.constant_gravity != 0.0) {
+        auto gravity = std::make_unique<BasicGravityConstant<T>>();
+        gravity->set_gravity_strength(T(scenario.constant_gravity));
+        gravity->set_gravity_angle_from_deg(T(scenario.constant_gravity_angle));
+        world.add_gravity_object(std::move(gravity));
+    }
+
+    for (const ScenarioPointMass &point_mass : scenario.point_masses) {
+        auto gravity = std::make_unique<BasicGravityObject<T>>(
+            BasicVector2D<T>(T(point_mass.x), T(point_mass.y)));
+        gravity->set_mass(T(point_mass.mass));
+        gravity->set_softening(T(point_mass.softening));
+        gravity->set_cutoff_radius(T(point_mass.cutoff_radius));
+        gravity->enable();
+        world.add_gravity_object(std::move(gravity));
+    }
+
+    BasicObstacleSet<T> &obstacles = world.get_obstacles();
+    for (const ScenarioLine &line : scenario.lines) {
+        obstacles.add_line(BasicVector2D<T>(T(line.x), T(line.y)),
+                           BasicVector2D<T>(T(line.normal_x), T(line.normal_y)));
+    }
+    for (const ScenarioSegment &segment : scenario.segments) {
+        obstacles.add_segment(BasicVector2D<T>(T(segment.start_x), T(segment.start_y)),
+                              BasicVector2D<T>(T(segment.end_x), T(segment.end_y)),
+                              T(segment.thickness));
+    }
+    for (const ScenarioCircle &circle : scenario.circles) {
+        obstacles.add_circle(BasicVector2D<T>(T(circle.x), T(circle.y)), T(circle.radius));
+    }
+
+    // Every emitter gets a seed of its own, derived from the scenario's one.
+    for (std::size_t i = 0; i < scenario.emitters.size(); i++) {
+        const ScenarioEmitter &settings = scenario.emitters[i];
+        auto emitter = std::make_unique<BasicEmitter<T>>(
+            BasicVector2D<T>(T(settings.x), T(settings.y)));
+        emitter->set_rate(T(settings.rate));
+        emitter->set_lifetime(T(settings.lifetime));
+        emitter->set_speed_range(T(settings.min_speed), T(settings.max_speed));
+        emitter->set_direction(BasicAngle<T>(T(settings.direction)));
+        emitter->set_spread(BasicAngle<T>(T(settings.spread)));
+        emitter->set_particle_radius(T(scenario.particle_radius));
+        emitter->set_seed(scenario.seed + i + 1);
+        world.add_emitter(std::move(emitter));
+    }
+
+    const T lifetime = (scenario.particle_lifetime > 0.0) ? T(scenario.particle_lifetime)
+                                                         : std::numeric_limits<T>::infinity();
+    Random random(scenario.seed);
+    for (std::size_t i = 0; i < scenario.particles; i++) {
+        T angle = random.next_real<T>(T(0), T(2 * M_PI));
+        T radius = T(scenario.spawn_radius) * std::sqrt(random.next_real<T>());
+        BasicVector2D<T> position(radius * std::cos(angle), radius * std::sin(angle));
+        ParticleHandle handle =
+            world.spawn_particle(position, BasicVector2D<T>(), T(scenario.particle_mass));
+        world.get_particle(handle).set_lifetime(lifetime);
+        world.get_particle(handle).set_radius(T(scenario.particle_radius));
+    }
+}
+
+// Explicitly instantiate all the supported precisions
+template void build_world<float>(const Scenario &scenario, BasicWorld<float> &world);
+template void build_world<double>(const Scenario &scenario, BasicWorld<double> &world);
@@ -0,0 +1,167 @@
+/**
+ * @file    scenario.hpp
+ * @author  Martin Cagas
+ *
+ * @brief   Description of a simulation run, loaded from a scenario file.
+ */
+
+#pragma once
+
+// Standard includes
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// "Particle game core" library includes
+#include <world.hpp>
+
+/**
+ * @brief   Point mass placed into the world of a scenario.
+ */
+struct ScenarioPointMass
+{
+    double x;              ///< X component of the position.
+    double y;              ///< Y component of the position.
+    double mass;           ///< Mass.
+    double softening;      ///< Plummer softening length, 0.0 for none.
+    double cutoff_radius;  ///< Distance beyond which the mass exerts no force, 0.0 for none.
+};
+
+/**
+ * @brief   Emitter placed into the world of a scenario.
+ */
+struct ScenarioEmitter
+{
+    double x;          ///< X component of the position.
+    double y;          ///< Y component of the position.
+    double rate;       ///< Amount of particles spawned per unit of time.
+    double lifetime;   ///< Time after which the spawned particles expire.
+    double min_speed;  ///< Lowest speed of the spawned particles.
+    double max_speed;  ///< Highest speed of the spawned particles.
+    double direction;  ///< Direction of the cone of the particles in degrees.
+    double spread;     ///< Full width of the cone of the particles in degrees.
+};
+
+/**
+ * @brief   Line placed into the world of a scenario, the half-plane behind it is solid.
+ */
+struct ScenarioLine
+{
+    double x;         ///< X component of a point of the line.
+    double y;         ///< Y component of a point of the line.
+    double normal_x;  ///< X component of the direction of the free side.
+    double normal_y;  ///< Y component of the direction of the free side.
+};
+
+/**
+ * @brief   Segment placed into the world of a scenario.
+ */
+struct ScenarioSegment
+{
+    double start_x;    ///< X component of the first end point.
+    double start_y;    ///< Y component of the first end point.
+    double end_x;      ///< X component of the second end point.
+    double end_y;      ///< Y component of the second end point.
+    double thickness;  ///< Distance up to which the segment keeps the particles away.
+};
+
+/**
+ * @brief   Circle placed into the world of a scenario.
+ */
+struct ScenarioCircle
+{
+    double x;       ///< X component of the center.
+    double y;       ///< Y component of the center.
+    double radius;  ///< Radius.
+};
+
+/**
+ * @struct  Scenario
+ *
+ * @brief   Description of a simulation run, loaded from a scenario file.
+ *
+ * @section DESCRIPTION
+ *
+ * A scenario file holds one "key = value" setting per line. Empty lines and everything after a '#'
+ * are ignored. Settings missing from the file keep the defaults below. The point_mass, emitter,
+ * line, segment and circle settings may be repeated, each adding one more object:
+ *
+ * - point_mass = X Y MASS [SOFTENING [CUTOFF_RADIUS]]
+ * - emitter = X Y RATE LIFETIME MIN_SPEED MAX_SPEED [DIRECTION SPREAD]
+ * - line = X Y NORMAL_X NORMAL_Y
+ * - segment = START_X START_Y END_X END_Y [THICKNESS]
+ * - circle = X Y RADIUS
+ *
+ * The bounds of the world are given as bounds = MIN_X MIN_Y MAX_X MAX_Y and only take effect with
+ * a boundary mode of wrap, bounce or kill.
+ *
+ * The initial particles are spread uniformly over a disc of the spawn radius around the origin,
+ * at rest, from a generator seeded by the seed setting, so every run of a scenario simulates
+ * exactly the same world.
+ *
+ * @section USAGE
+ *
+ * @code
+ *
+ * Scenario scenario = load_scenario("scenarios/galaxy.scenario");
+ *
+ * WorldF world;
+ * build_world(scenario, world);
+ *
+ * @endcode
+ */
+struct Scenario
+{
+    bool double_precision = false;   ///< True to simulate in double precision.
+    std::size_t steps = 600;         ///< Amount of steps to run.
+    double time_step = 1.0 / 60.0;   ///< Length of a step.
+    std::size_t particles = 100000;  ///< Amount of particles spawned up front.
+    std::size_t particle_limit = 0;  ///< Maximum amount of particles, 0 for particles.
+    double spawn_radius = 100.0;     ///< Radius of the disc of the initial particles.
+    double particle_mass = 0.0;      ///< Mass of the initial particles.
+    double particle_lifetime = 0.0;  ///< Lifetime of the initial ones, 0.0 for infinite.
+    double particle_radius = 0.0;    ///< Radius of all the particles, 0.0 for none.
+    std::uint64_t seed = 1;          ///< Seed of the initial particles and emitters.
+    Integrator integrator = Integrator::SYMPLECTIC_EULER;  ///< Integrator of the world.
+    GravitySolver gravity_solver = GravitySolver::DIRECT;  ///< Gravity solver of the world.
+    double barnes_hut_theta = 0.5;          ///< Opening angle of the Barnes-Hut solver.
+    bool particle_self_gravity = false;     ///< True to make the particles attract each other.
+    bool particle_collisions = false;       ///< True to make the particles collide.
+    double collision_restitution = 1.0;     ///< Restitution of the collisions.
+    std::size_t max_time_step_level = 0;    ///< Finest block time step level, 0 for none.
+    double time_step_accuracy = 0.01;       ///< Accuracy of the block time steps.
+    double grid_cell_size = 0.0;            ///< Cell size of the spatial grid, 0.0 for none.
+    std::size_t threads = 0;                ///< Amount of threads, 0 for one per hardware one.
+    bool deterministic = true;              ///< True to split the work deterministically.
+    double constant_gravity = 0.0;          ///< Strength of the constant gravity, 0.0 for none.
+    double constant_gravity_angle = 270.0;  ///< Direction of the constant gravity in degrees.
+    std::vector<ScenarioPointMass> point_masses;  ///< Point masses in the world.
+    std::vector<ScenarioEmitter> emitters;        ///< Emitters in the world.
+    BoundaryMode boundary = BoundaryMode::NONE;   ///< Fate of the particles leaving the bounds.
+    double bounds[4] = {0.0, 0.0, 0.0, 0.0};      ///< Lowest x and y, then highest x and y.
+    double obstacle_restitution = 1.0;            ///< Restitution of the bounces off the obstacles.
+    std::vector<ScenarioLine> lines;              ///< Lines in the world.
+    std::vector<ScenarioSegment> segments;        ///< Segments in the world.
+    std::vector<ScenarioCircle> circles;          ///< Circles in the world.
+};
+
+/**
+ * @brief   Loads a scenario file.
+ *
+ * @param   &path       Path of the file.
+ *
+ * @return  The scenario.
+ *
+ * @throws  std::runtime_error if the file cannot be read or holds an invalid setting.
+ */
+Scenario load_scenario(const std::string &path);
+
+/**
+ * @brief   Sets up an empty world as described by a scenario.
+ *
+ * @param   &scenario   The scenario.
+ * @param   &world      The world, freshly constructed.
+ */
+template <typename T>
+void build_world(const Scenario &scenario, BasicWorld<T> &world);
@@ -7,21 +7,246 @@
  * @section DESCRIPTION
  *
  * A particle simulation game built using C++ and a low-level game creation library.
+ *
+ * @section USAGE
+ *
+ * particle-game [--particles COUNT] [--headless FRAMES [--output IMAGE]] [--trace FILE]
+ *
+ * The world is simulated in fixed steps of 1/60 of a second, independently of the frame rate, and
+ * drawn interpolated between its last two steps.
+ *
+ * With --headless, the window stays hidden and the given amount of frames is rendered into an
+ * offscreen texture as fast as possible, each frame simulating exactly one step, then the average
+ * frame time is printed. The last frame can be saved as an image with --output. The game still
+ * needs an OpenGL 3.3 context, on machines without a display run it under a virtual one, e.g.
+ * xvfb-run with Mesa's software rasteriser.
+ *
+ * F3 toggles the profiler and its overlay with the rolling time of every phase of the frame and the
+ * particle counts, F4 exports the events recorded so far as a Chrome trace. With --trace, the
+ * profiler runs from the start and the trace is written to the given file at exit.
  */
 
 #include "main.hpp"
 
-int main()
+// Standard includes
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+
+// "Game essentials" library includes
+#include <fixed_timestep.hpp>
+#include <profiler.hpp>
+
+// "Particle game core" library includes
+#include <world.hpp>
+
+// Local includes
+#include "particle_renderer.hpp"
+#include "profiler_overlay.hpp"
+
+/**
+ * @brief   Width of the window and of the offscreen target.
+ */
+static constexpr int SCREEN_WIDTH = 800;
+
+/**
+ * @brief   Height of the window and of the offscreen target.
+ */
+static constexpr int SCREEN_HEIGHT = 450;
+
+/**
+ * @brief   File the trace is exported into by F4.
+ */
+static const char *TRACE_PATH = "particle-game-trace.json";
+
+/**
+ * @brief   Fills the world with particles drifting out of a disc around the origin.
+ */
+static void spawn_particles(WorldF &world, std::size_t count)
 {
-    InitWindow(800, 450, "Particle Game v0.1");
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
 
-    while (!WindowShouldClose()) {
-        BeginDrawing();
+    world.set_particle_limit(count);
+    for (std::size_t i = 0; i < count; i++) {
+        float angle = 2.0f * float(M_PI) * unit(generator);
+        float radius = 200.0f * std::sqrt(unit(generator));
+        float speed = 3.0f * unit(generator);
+        essentials::Point2DF position(radius * std::cos(angle), radius * std::sin(angle));
+        essentials::Vector2DF velocity(speed * std::cos(angle), speed * std::sin(angle));
+        world.spawn_particle(position, velocity);
+    }
+}
 
-        ClearBackground(RAYWHITE);
-        DrawText("It's something!", 190, 200, 20, LIGHTGRAY);
+/**
+ * @brief   Advances the world by the time of a frame and draws it into the current target.
+ */
+static void run_frame(WorldF &world, essentials::FixedTimestep &timestep, double frame_time,
+                      ParticleRenderer &renderer, const Camera2D &camera)
+{
+    ESSENTIALS_PROFILE_SCOPE("frame");
+    for (std::size_t steps = timestep.advance(frame_time); steps > 0; steps--) {
+        world.step();
+    }
+    renderer.upload(world.get_particles(), world.get_particle_count(),
+                    static_cast<float>(timestep.get_alpha()));
+
+    ClearBackground(BLACK);
+    BeginMode2D(camera);
+    renderer.draw();
+    EndMode2D();
+}
+
+/**
+ * @brief   Writes the events recorded by the profiler into a trace file, reporting failures.
+ */
+static void export_trace(const char *path)
+{
+    try {
+        essentials::profiler::export_chrome_trace(path);
+        std::cout << "Trace written to " << path << std::endl;
+    }
+    catch (const std::runtime_error &error) {
+        std::cerr << error.what() << std::endl;
+    }
+}
+
+/**
+ * @brief   Parses an option value made of a non-negative number and nothing else.
+ *
+ * @param   *value      The value.
+ * @param   &number     Receives the number.
+ *
+ * @return  True if the value is a valid number, false otherwise.
+ */
+static bool parse_number(const char *value, long &number)
+{
+    char *end = nullptr;
+    errno = 0;
+    number = std::strtol(value, &end, 10);
+    return end != value && *end == '\0' && errno == 0 && number >= 0;
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t particle_count = 100000;
+    long headless_frames = -1;
+    const char *output_path = nullptr;
+    const char *trace_path = nullptr;
+
+    for (int i = 1; i < argc; i += 2) {
+        long number = 0;
+        if (i + 1 == argc) {
+            std::cerr << "Missing value of option " << argv[i] << std::endl;
+            return EXIT_FAILURE;
+        }
+        else if (std::strcmp(argv[i], "--particles") == 0) {
+            if (!parse_number(argv[i + 1], number)) {
+                std::cerr << "Invalid value of option " << argv[i] << std::endl;
+                return EXIT_FAILURE;
+            }
+            particle_count = static_cast<std::size_t>(number);
+        }
+        else if (std::strcmp(argv[i], "--headless") == 0) {
+            if (!parse_number(argv[i + 1], number)) {
+                std::cerr << "Invalid value of option " << argv[i] << std::endl;
+                return EXIT_FAILURE;
+            }
+            headless_frames = number;
+        }
+        else if (std::strcmp(argv[i], "--output") == 0) {
+            output_path = argv[i + 1];
+        }
+        else if (std::strcmp(argv[i], "--trace") == 0) {
+            trace_path = argv[i + 1];
+            essentials::profiler::enable();
+        }
+        else {
+            std::cerr << "Unknown option " << argv[i] << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (headless_frames >= 0) {
+        SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    }
+    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Particle Game v0.1");
+
+    essentials::FixedTimestep timestep;
+
+    WorldF world;
+    world.set_time_step(static_cast<float>(timestep.get_time_step()));
+    spawn_particles(world, particle_count);
+
+    Camera2D camera = {};
+    camera.offset = Vector2{SCREEN_WIDTH / 2.0f, SCREEN_HEIGHT / 2.0f};
+    camera.zoom = 1.0f;
+
+    // The renderer owns GPU resources, it has to go away before the window does.
+    {
+        ParticleRenderer renderer;
+        renderer.set_color(Color{255, 161, 0, 160});
+
+        if (headless_frames >= 0) {
+            RenderTexture2D target = LoadRenderTexture(SCREEN_WIDTH, SCREEN_HEIGHT);
+
+            double start = GetTime();
+            for (long frame = 0; frame < headless_frames; frame++) {
+                BeginTextureMode(target);
+                run_frame(world, timestep, timestep.get_time_step(), renderer, camera);
+                EndTextureMode();
+            }
+            double seconds = GetTime() - start;
+
+            std::cout << particle_count << " particles, " << headless_frames << " frames, "
+                      << 1000.0 * seconds / std::max(headless_frames, 1L) << " ms per frame"
+                      << std::endl;
+
+            if (output_path != nullptr) {
+                Image image = LoadImageFromTexture(target.texture);
+                ImageFlipVertical(&image);
+                ExportImage(image, output_path);
+                UnloadImage(image);
+            }
+            UnloadRenderTexture(target);
+        }
+        else {
+            ProfilerOverlay overlay;
+            for (const char *zone : {"frame", "step", "spawn", "forces", "integrate", "collisions",
+                                     "obstacles", "expiry", "spatial grid", "render upload"}) {
+                overlay.add_zone(zone);
+            }
+
+            while (!WindowShouldClose()) {
+                if (IsKeyPressed(KEY_F3)) {
+                    if (essentials::profiler::get_is_enabled()) {
+                        essentials::profiler::disable();
+                    }
+                    else {
+                        essentials::profiler::enable();
+                    }
+                }
+                if (IsKeyPressed(KEY_F4)) {
+                    export_trace(TRACE_PATH);
+                }
+
+                BeginDrawing();
+                run_frame(world, timestep, GetFrameTime(), renderer, camera);
+                DrawFPS(10, 10);
+                if (essentials::profiler::get_is_enabled()) {
+                    overlay.update(world.get_particle_count(), world.get_particle_limit());
+                    overlay.draw(10, 40);
+                }
+                EndDrawing();
+            }
+        }
+    }
 
-        EndDrawing();
+    if (trace_path != nullptr) {
+        export_trace(trace_path);
     }
 
     CloseWindow();
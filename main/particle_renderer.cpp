@@ -0,0 +1,260 @@
+/**
+ * @file    particle_renderer.cpp
+ * @author  Martin Cagas
+ *
+ * @brief   Draws all the particles of a world in a single instanced draw call.
+ */
+
+#include "particle_renderer.hpp"
+
+// Standard includes
+#include <type_traits>
+
+#include <raymath.h>
+#include <rlgl.h>
+
+// "Game essentials" library includes
+#include <profiler.hpp>
+
+/**
+ * @brief   Vertex shader moving the quad of every instance to its particle.
+ */
+static const char *VERTEX_SHADER = R"(
+#version 330
+in vec2 vertexCorner;
+in float instanceX;
+in float instanceY;
+in vec4 instanceColor;
+in float instanceSize;
+uniform mat4 mvp;
+out vec2 fragCorner;
+out vec4 fragColor;
+void main()
+{
+    fragCorner = vertexCorner;
+    fragColor = instanceColor;
+    gl_Position = mvp * vec4(vec2(instanceX, instanceY) + vertexCorner * instanceSize, 0.0, 1.0);
+}
+)";
+
+/**
+ * @brief   Fragment shader cutting the quads into discs.
+ */
+static const char *FRAGMENT_SHADER = R"(
+#version 330
+in vec2 fragCorner;
+in vec4 fragColor;
+out vec4 finalColor;
+void main()
+{
+    if (dot(fragCorner, fragCorner) > 1.0) {
+        discard;
+    }
+    finalColor = fragColor;
+}
+)";
+
+/**
+ * @brief   Corners of the quad as two triangles, spanning [-1, 1] on both axes.
+ */
+static float QUAD_CORNERS[12] = {-1.0f, -1.0f, 1.0f, -1.0f, 1.0f,  1.0f,
+                                 -1.0f, -1.0f, 1.0f, 1.0f,  -1.0f, 1.0f};
+
+/**
+ * @brief   Amount of particles the buffers are created for.
+ */
+static constexpr std::size_t INITIAL_CAPACITY = 1024;
+
+ParticleRenderer::ParticleRenderer(void)
+    : color_(WHITE),
+      size_(1.0f),
+      count_(0),
+      capacity_(0),
+      has_colors_(false),
+      has_sizes_(false),
+      x_buffer_(0),
+      y_buffer_(0),
+      color_buffer_(0),
+      size_buffer_(0)
+{
+    shader_ = rlLoadShaderCode(VERTEX_SHADER, FRAGMENT_SHADER);
+    mvp_location_ = rlGetLocationUniform(shader_, "mvp");
+    corner_location_ = rlGetLocationAttrib(shader_, "vertexCorner");
+    x_location_ = rlGetLocationAttrib(shader_, "instanceX");
+    y_location_ = rlGetLocationAttrib(shader_, "instanceY");
+    color_location_ = rlGetLocationAttrib(shader_, "instanceColor");
+    size_location_ = rlGetLocationAttrib(shader_, "instanceSize");
+
+    vertex_array_ = rlLoadVertexArray();
+    rlEnableVertexArray(vertex_array_);
+    corner_buffer_ = rlLoadVertexBuffer(QUAD_CORNERS, sizeof(QUAD_CORNERS), false);
+    rlSetVertexAttribute(corner_location_, 2, RL_FLOAT, false, 0, 0);
+    rlEnableVertexAttribute(corner_location_);
+    rlDisableVertexArray();
+
+    reserve(INITIAL_CAPACITY);
+}
+
+ParticleRenderer::~ParticleRenderer(void)
+{
+    rlUnloadVertexBuffer(size_buffer_);
+    rlUnloadVertexBuffer(color_buffer_);
+    rlUnloadVertexBuffer(y_buffer_);
+    rlUnloadVertexBuffer(x_buffer_);
+    rlUnloadVertexBuffer(corner_buffer_);
+    rlUnloadVertexArray(vertex_array_);
+    rlUnloadShaderProgram(shader_);
+}
+
+void ParticleRenderer::set_color(Color color) { color_ = color; }
+
+Color ParticleRenderer::get_color(void) const { return color_; }
+
+void ParticleRenderer::set_size(float size) { size_ = size; }
+
+float ParticleRenderer::get_size(void) const { return size_; }
+
+template <typename T>
+void ParticleRenderer::upload(const BasicParticleStore<T> &store, std::size_t count, float alpha)
+{
+    ESSENTIALS_PROFILE_SCOPE("render upload");
+    reserve(count);
+    count_ = count;
+    has_colors_ = false;
+    has_sizes_ = false;
+
+    if (std::is_same<T, float>::value && alpha == 1.0f) {
+        upload_buffer(x_buffer_, store.x.data(), count * sizeof(T));
+        upload_buffer(y_buffer_, store.y.data(), count * sizeof(T));
+        return;
+    }
+
+    staging_x_.resize(capacity_);
+    staging_y_.resize(capacity_);
+
+    if (alpha == 1.0f) {
+        for (std::size_t i = 0; i < count; i++) {
+            staging_x_[i] = static_cast<float>(store.x[i]);
+            staging_y_[i] = static_cast<float>(store.y[i]);
+        }
+    }
+    else {
+        const T a = alpha;
+        for (std::size_t i = 0; i < count; i++) {
+            staging_x_[i] = static_cast<float>(store.px[i] + (store.x[i] - store.px[i]) * a);
+            staging_y_[i] = static_cast<float>(store.py[i] + (store.y[i] - store.py[i]) * a);
+        }
+    }
+
+    upload_buffer(x_buffer_, staging_x_.data(), count * sizeof(float));
+    upload_buffer(y_buffer_, staging_y_.data(), count * sizeof(float));
+}
+
+void ParticleRenderer::upload_colors(const Color *colors)
+{
+    upload_buffer(color_buffer_, colors, count_ * sizeof(Color));
+    has_colors_ = true;
+}
+
+void ParticleRenderer::upload_sizes(const float *sizes)
+{
+    upload_buffer(size_buffer_, sizes, count_ * sizeof(float));
+    has_sizes_ = true;
+}
+
+std::size_t ParticleRenderer::get_count(void) const { return count_; }
+
+void ParticleRenderer::draw(void)
+{
+    if (count_ == 0) {
+        return;
+    }
+
+    // Whatever raylib has batched so far goes first, to keep the drawing order.
+    rlDrawRenderBatchActive();
+
+    rlEnableShader(shader_);
+    rlSetUniformMatrix(mvp_location_,
+                       MatrixMultiply(rlGetMatrixModelview(), rlGetMatrixProjection()));
+
+    rlEnableVertexArray(vertex_array_);
+
+    // Without per-particle values, the disabled attributes read the constant defaults instead.
+    if (has_colors_) {
+        rlEnableVertexAttribute(color_location_);
+    }
+    else {
+        const float color[4] = {color_.r / 255.0f, color_.g / 255.0f, color_.b / 255.0f,
+                                color_.a / 255.0f};
+        rlDisableVertexAttribute(color_location_);
+        rlSetVertexAttributeDefault(color_location_, color, SHADER_ATTRIB_VEC4, 4);
+    }
+
+    if (has_sizes_) {
+        rlEnableVertexAttribute(size_location_);
+    }
+    else {
+        rlDisableVertexAttribute(size_location_);
+        rlSetVertexAttributeDefault(size_location_, &size_, SHADER_ATTRIB_FLOAT, 1);
+    }
+
+    rlDrawVertexArrayInstanced(0, 6, static_cast<int>(count_));
+
+    rlDisableVertexArray();
+    rlDisableShader();
+}
+
+void ParticleRenderer::reserve(std::size_t count)
+{
+    if (count <= capacity_) {
+        return;
+    }
+
+    std::size_t capacity = (capacity_ == 0) ? INITIAL_CAPACITY : capacity_;
+    while (capacity < count) {
+        capacity *= 2;
+    }
+
+    rlUnloadVertexBuffer(size_buffer_);
+    rlUnloadVertexBuffer(color_buffer_);
+    rlUnloadVertexBuffer(y_buffer_);
+    rlUnloadVertexBuffer(x_buffer_);
+
+    // The buffers are only allocated here, their contents are streamed in by upload_buffer().
+    rlEnableVertexArray(vertex_array_);
+
+    x_buffer_ = rlLoadVertexBuffer(nullptr, static_cast<int>(capacity * sizeof(float)), true);
+    rlSetVertexAttribute(x_location_, 1, RL_FLOAT, false, 0, 0);
+    rlSetVertexAttributeDivisor(x_location_, 1);
+    rlEnableVertexAttribute(x_location_);
+
+    y_buffer_ = rlLoadVertexBuffer(nullptr, static_cast<int>(capacity * sizeof(float)), true);
+    rlSetVertexAttribute(y_location_, 1, RL_FLOAT, false, 0, 0);
+    rlSetVertexAttributeDivisor(y_location_, 1);
+    rlEnableVertexAttribute(y_location_);
+
+    color_buffer_ = rlLoadVertexBuffer(nullptr, static_cast<int>(capacity * sizeof(Color)), true);
+    rlSetVertexAttribute(color_location_, 4, RL_UNSIGNED_BYTE, true, 0, 0);
+    rlSetVertexAttributeDivisor(color_location_, 1);
+
+    size_buffer_ = rlLoadVertexBuffer(nullptr, static_cast<int>(capacity * sizeof(float)), true);
+    rlSetVertexAttribute(size_location_, 1, RL_FLOAT, false, 0, 0);
+    rlSetVertexAttributeDivisor(size_location_, 1);
+
+    rlDisableVertexArray();
+
+    capacity_ = capacity;
+}
+
+void ParticleRenderer::upload_buffer(unsigned int buffer, const void *data, std::size_t size)
+{
+    if (size > 0) {
+        rlUpdateVertexBuffer(buffer, const_cast<void *>(data), static_cast<int>(size), 0);
+    }
+}
+
+// Explicitly instantiate all the supported precisions
+template void ParticleRenderer::upload<float>(const BasicParticleStore<float> &, std::size_t,
+                                              float);
+template void ParticleRenderer::upload<double>(const BasicParticleStore<double> &, std::size_t,
+                                               float);
@@ -0,0 +1,180 @@
+/**
+ * @file    particle_renderer.hpp
+ * @author  Martin Cagas
+ *
+ * @brief   Draws all the particles of a world in a single instanced draw call.
+ */
+
+#pragma once
+
+// Standard includes
+#include <cstdlib>
+#include <vector>
+
+#include <raylib.h>
+
+// "Particle game core" library includes
+#include <particle_store.hpp>
+
+/**
+ * @class   ParticleRenderer
+ *
+ * @brief   Draws all the particles of a world in a single instanced draw call.
+ *
+ * @section DESCRIPTION
+ *
+ * Drawing the particles one by one costs a draw call, or at least a few vertices pushed through
+ * raylib's batch, per particle. The renderer instead keeps one quad and a set of dynamic
+ * per-instance vertex buffers on the GPU. Every frame the positions of the live particles are
+ * uploaded into the buffers and all the particles are drawn as instances of the quad in one call,
+ * the vertex shader moving each quad to its particle and the fragment shader cutting it into a
+ * disc.
+ *
+ * Positions are uploaded in single precision. Those of a single precision store go to the GPU as
+ * they are, those of a double precision store or interpolated between the previous and current
+ * positions are computed in a staging buffer first. Colours and
+ * sizes can be uploaded per particle, particles without them use the renderer's colour and size.
+ *
+ * The particles are drawn with the current rlgl transformation, so they follow the camera of an
+ * enclosing BeginMode2D(), and into the current target, so they can be drawn offscreen within
+ * BeginTextureMode(). The renderer needs an OpenGL 3.3 context, it must only be created after
+ * InitWindow() and destroyed before CloseWindow().
+ *
+ * @section USAGE
+ *
+ * @code
+ *
+ * ParticleRenderer renderer;
+ *
+ * renderer.upload(world.get_particles(), world.get_particle_count());
+ *
+ * BeginDrawing();
+ * BeginMode2D(camera);
+ * renderer.draw();
+ * EndMode2D();
+ * EndDrawing();
+ *
+ * @endcode
+ */
+class ParticleRenderer
+{
+public:
+    /**
+     * @brief   Constructor.
+     *
+     * @details
+     *
+     * Compiles the shaders and creates the vertex buffers, the colour defaults to white and the
+     * size to 1.0.
+     */
+    ParticleRenderer(void);
+
+    /**
+     * @brief   Destructor.
+     *
+     * @details
+     *
+     * Releases the shaders and the vertex buffers.
+     */
+    ~ParticleRenderer(void);
+
+    ParticleRenderer(const ParticleRenderer &) = delete;
+    ParticleRenderer &operator=(const ParticleRenderer &) = delete;
+
+    /**
+     * @brief   color_ setter.
+     *
+     * @param   color       Colour of the particles without a colour of their own.
+     */
+    void set_color(Color color);
+
+    /**
+     * @brief   color_ getter.
+     */
+    Color get_color(void) const;
+
+    /**
+     * @brief   size_ setter.
+     *
+     * @param   size        Radius of the particles without a size of their own, in world units.
+     */
+    void set_size(float size);
+
+    /**
+     * @brief   size_ getter.
+     */
+    float get_size(void) const;
+
+    /**
+     * @brief   Uploads the positions of the particles to draw.
+     *
+     * @details
+     *
+     * Also forgets the colours and sizes of the previous upload, they have to be uploaded again
+     * after the positions.
+     *
+     * @param   &store      Store of the particles.
+     * @param   count       Amount of particles, drawn from the slots [0, count).
+     * @param   alpha       Where to draw the particles between their previous positions (0.0) and
+     *                      their current positions (1.0).
+     */
+    template <typename T>
+    void upload(const BasicParticleStore<T> &store, std::size_t count, float alpha = 1.0f);
+
+    /**
+     * @brief   Uploads one colour per particle.
+     *
+     * @param   *colors     Colours of the particles, as many as in the last upload().
+     */
+    void upload_colors(const Color *colors);
+
+    /**
+     * @brief   Uploads one size per particle.
+     *
+     * @param   *sizes      Radii of the particles in world units, as many as in the last upload().
+     */
+    void upload_sizes(const float *sizes);
+
+    /**
+     * @brief   Returns the amount of particles drawn by draw().
+     */
+    std::size_t get_count(void) const;
+
+    /**
+     * @brief   Draws the uploaded particles.
+     */
+    void draw(void);
+
+protected:
+    /**
+     * @brief   Makes sure the per-instance buffers can hold a given amount of particles.
+     */
+    void reserve(std::size_t count);
+
+    /**
+     * @brief   Uploads part of a per-instance buffer.
+     */
+    void upload_buffer(unsigned int buffer, const void *data, std::size_t size);
+
+    Color color_;                   ///< Colour of the particles without a colour of their own.
+    float size_;                    ///< Radius of the particles without a size of their own.
+    std::size_t count_;             ///< Amount of uploaded particles.
+    std::size_t capacity_;          ///< Amount of particles the buffers can hold.
+    bool has_colors_;               ///< True if colours were uploaded with the positions.
+    bool has_sizes_;                ///< True if sizes were uploaded with the positions.
+    unsigned int shader_;           ///< Shader program.
+    int mvp_location_;              ///< Location of the model-view-projection matrix.
+    int corner_location_;           ///< Location of the quad corner attribute.
+    int x_location_;                ///< Location of the x position attribute.
+    int y_location_;                ///< Location of the y position attribute.
+    int color_location_;            ///< Location of the colour attribute.
+    int size_location_;             ///< Location of the size attribute.
+    unsigned int vertex_array_;     ///< Vertex array binding all the buffers.
+    unsigned int corner_buffer_;    ///< Corners of the quad, shared by all instances.
+    unsigned int x_buffer_;         ///< X components of the positions, per instance.
+    unsigned int y_buffer_;         ///< Y components of the positions, per instance.
+    unsigned int color_buffer_;     ///< Colours, per instance.
+    unsigned int size_buffer_;      ///< Sizes, per instance.
+    std::vector<float> staging_x_;  ///< X components of the positions to upload.
+    std::vector<float> staging_y_;  ///< Y components of the positions to upload.
+};
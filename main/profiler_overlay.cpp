@@ -0,0 +1,106 @@
+/**
+ * @file    profiler_overlay.cpp
+ * @author  Martin Cagas
+ *
+ * @brief   Draws the rolling per-zone times of the profiler and the particle counts over the game.
+ */
+
+#include "profiler_overlay.hpp"
+
+// Standard includes
+#include <algorithm>
+#include <cstring>
+
+using namespace essentials;
+
+/**
+ * @brief   Height of a line of text in the overlay, in pixels.
+ */
+static constexpr int LINE_HEIGHT = 12;
+
+/**
+ * @brief   Size of the font of the overlay, in pixels.
+ */
+static constexpr int FONT_SIZE = 10;
+
+/**
+ * @brief   Width of the overlay, in pixels.
+ */
+static constexpr int OVERLAY_WIDTH = 200;
+
+/**
+ * @brief   Horizontal offset of the column of values, in pixels.
+ */
+static constexpr int VALUE_OFFSET = 100;
+
+ProfilerOverlay::ProfilerOverlay(void)
+    : last_event_end_(0), frame_count_(0), particle_count_(0), particle_limit_(0)
+{
+}
+
+void ProfilerOverlay::add_zone(const char *name)
+{
+    Zone zone;
+    zone.name = name;
+    zone.milliseconds.fill(0.0);
+    zones_.push_back(zone);
+}
+
+void ProfilerOverlay::update(std::size_t particle_count, std::size_t particle_limit)
+{
+    particle_count_ = particle_count;
+    particle_limit_ = particle_limit;
+
+    events_.clear();
+    profiler::collect(last_event_end_, events_);
+
+    const std::size_t slot = frame_count_ % FRAME_WINDOW;
+    for (Zone &zone : zones_) {
+        zone.milliseconds[slot] = 0.0;
+    }
+
+    // Zones are matched by their names, the same literal may live at different addresses.
+    for (const profiler::Event &event : events_) {
+        last_event_end_ = std::max(last_event_end_, event.end);
+        for (Zone &zone : zones_) {
+            if (std::strcmp(zone.name, event.name) == 0) {
+                zone.milliseconds[slot] += (event.end - event.start) / 1e6;
+                break;
+            }
+        }
+    }
+
+    frame_count_++;
+}
+
+void ProfilerOverlay::draw(int x, int y) const
+{
+    const int line_count = static_cast<int>(zones_.size()) + 2;
+    DrawRectangle(x, y, OVERLAY_WIDTH, line_count * LINE_HEIGHT + 8, Color{0, 0, 0, 160});
+    x += 4;
+    y += 4;
+
+#ifdef ESSENTIALS_PROFILER
+    DrawText("F3 hides, F4 exports a trace", x, y, FONT_SIZE, LIGHTGRAY);
+#else
+    DrawText("profiler not compiled in", x, y, FONT_SIZE, LIGHTGRAY);
+#endif
+    y += LINE_HEIGHT;
+
+    DrawText("particles", x, y, FONT_SIZE, RAYWHITE);
+    DrawText(TextFormat("%zu / %zu", particle_count_, particle_limit_), x + VALUE_OFFSET, y,
+             FONT_SIZE, RAYWHITE);
+    y += LINE_HEIGHT;
+
+    const std::size_t frames = std::max<std::size_t>(std::min(frame_count_, FRAME_WINDOW), 1);
+    for (const Zone &zone : zones_) {
+        double sum = 0.0;
+        for (double milliseconds : zone.milliseconds) {
+            sum += milliseconds;
+        }
+
+        DrawText(zone.name, x, y, FONT_SIZE, RAYWHITE);
+        DrawText(TextFormat("%.3f ms", sum / frames), x + VALUE_OFFSET, y, FONT_SIZE, RAYWHITE);
+        y += LINE_HEIGHT;
+    }
+}
@@ -0,0 +1,99 @@
+/**
+ * @file    profiler_overlay.hpp
+ * @author  Martin Cagas
+ *
+ * @brief   Draws the rolling per-zone times of the profiler and the particle counts over the game.
+ */
+
+#pragma once
+
+// Standard includes
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <raylib.h>
+
+// "Game essentials" library includes
+#include <profiler.hpp>
+
+/**
+ * @class   ProfilerOverlay
+ *
+ * @brief   Draws the rolling per-zone times of the profiler and the particle counts over the game.
+ *
+ * @section DESCRIPTION
+ *
+ * Once per frame, update() collects the events the profiler has recorded since the last frame and
+ * adds up the time spent in each of the zones of interest. draw() shows those times averaged over
+ * the last FRAME_WINDOW frames, in milliseconds per frame, which keeps them readable while still
+ * following changes within a second. The times of nested zones are included in the times of their
+ * enclosing zones, and a zone running on several threads counts the time of all of them.
+ *
+ * The overlay shows nothing but zeros while the profiler is disabled or not compiled in.
+ *
+ * @section USAGE
+ *
+ * @code
+ *
+ * ProfilerOverlay overlay;
+ * overlay.add_zone("step");
+ *
+ * overlay.update(world.get_particle_count(), world.get_particle_limit());
+ * overlay.draw(10, 40);
+ *
+ * @endcode
+ */
+class ProfilerOverlay
+{
+public:
+    static constexpr std::size_t FRAME_WINDOW = 60;  ///< Amount of frames the times average over.
+
+    /**
+     * @brief   Empty constructor.
+     */
+    ProfilerOverlay(void);
+
+    /**
+     * @brief   Adds a zone to show, the zones are listed in the order they were added.
+     *
+     * @param   *name       Name of the zone, as given to ESSENTIALS_PROFILE_SCOPE().
+     */
+    void add_zone(const char *name);
+
+    /**
+     * @brief   Collects the events of the last frame.
+     *
+     * @details
+     *
+     * Must be called once per frame, outside of all the zones and while no other thread is inside
+     * one, see profiler::collect().
+     *
+     * @param   particle_count  Amount of live particles.
+     * @param   particle_limit  Maximum amount of particles.
+     */
+    void update(std::size_t particle_count, std::size_t particle_limit);
+
+    /**
+     * @brief   Draws the overlay with its top left corner at a point of the screen.
+     */
+    void draw(int x, int y) const;
+
+protected:
+    /**
+     * @brief   A zone shown by the overlay.
+     */
+    struct Zone
+    {
+        const char *name;                                ///< Name of the zone.
+        std::array<double, FRAME_WINDOW> milliseconds;   ///< Time spent in the last frames.
+    };
+
+    std::vector<Zone> zones_;                            ///< Zones shown by the overlay.
+    std::vector<essentials::profiler::Event> events_;    ///< Scratch, events of the last frame.
+    std::uint64_t last_event_end_;                       ///< End of the last collected event.
+    std::size_t frame_count_;                            ///< Amount of frames collected so far.
+    std::size_t particle_count_;                         ///< Amount of live particles.
+    std::size_t particle_limit_;                         ///< Maximum amount of particles.
+};
@@ -0,0 +1,242 @@
+/**
+ * @file    barnes_hut_tree.cpp
+ * @author  Martin Cagas
+ *
+ * @brief   Quadtree approximating the gravitational pull of many point masses.
+ */
+
+#include "barnes_hut_tree.hpp"
+
+// Standard includes
+#include <algorithm>
+
+using namespace essentials;
+
+/**
+ * @brief   Adds the pull of a point mass on a test particle of unit mass to the accumulators.
+ *
+ * @details
+ *
+ * Same force law as GravityObject::calculate_point_mass_force(), without the target's mass, which
+ * is multiplied in once for the whole traversal.
+ */
+template <typename T>
+static inline void accumulate_pull(T dx, T dy, T source_mass, T &fx, T &fy)
+{
+    T distance_squared = dx * dx + dy * dy;
+
+    if (distance_squared != T(0)) {
+        T inverse_distance = T(1) / std::sqrt(distance_squared);
+        T scale = source_mass * inverse_distance * inverse_distance * inverse_distance;
+        fx += dx * scale;
+        fy += dy * scale;
+    }
+}
+
+template <typename T>
+BasicBarnesHutTree<T>::BasicBarnesHutTree(void) : theta_(0.5) {}
+
+template <typename T>
+void BasicBarnesHutTree<T>::set_theta(T theta) { theta_ = theta; }
+
+template <typename T>
+T BasicBarnesHutTree<T>::get_theta(void) const { return theta_; }
+
+template <typename T>
+void BasicBarnesHutTree<T>::build(const T *x, const T *y, const T *mass, std::size_t count)
+{
+    nodes_.clear();
+    body_x_.clear();
+    body_y_.clear();
+    body_mass_.clear();
+    body_ids_.clear();
+
+    for (std::size_t i = 0; i < count; i++) {
+        if (mass[i] > T(0)) {
+            body_x_.push_back(x[i]);
+            body_y_.push_back(y[i]);
+            body_mass_.push_back(mass[i]);
+            body_ids_.push_back(i);
+        }
+    }
+
+    const std::size_t body_count = body_ids_.size();
+    body_next_.resize(body_count);
+
+    if (body_count == 0) {
+        return;
+    }
+
+    // The root cell is the smallest square around all the bodies, enlarged a bit so that the bodies
+    // on its upper edges still fall inside.
+    T min_x = body_x_[0], max_x = body_x_[0];
+    T min_y = body_y_[0], max_y = body_y_[0];
+    for (std::size_t i = 1; i < body_count; i++) {
+        min_x = std::min(min_x, body_x_[i]);
+        max_x = std::max(max_x, body_x_[i]);
+        min_y = std::min(min_y, body_y_[i]);
+        max_y = std::max(max_y, body_y_[i]);
+    }
+
+    T half_size = T(0.5) * std::max(max_x - min_x, max_y - min_y);
+    half_size = (half_size > T(0)) ? half_size * T(1.0001) : T(1);
+
+    nodes_.push_back(
+        Node{T(0.5) * (min_x + max_x), T(0.5) * (min_y + max_y), half_size, 0, 0, 0, -1, -1});
+
+    for (std::size_t i = 0; i < body_count; i++) {
+        insert(static_cast<std::int32_t>(i));
+    }
+
+    // Children are always stored after their parents, so a single backwards pass visits every node
+    // after all of its children.
+    for (std::size_t i = nodes_.size(); i-- > 0;) {
+        Node &node = nodes_[i];
+        T total_mass = 0, weighted_x = 0, weighted_y = 0;
+
+        if (node.first_child < 0) {
+            for (std::int32_t b = node.first_body; b >= 0; b = body_next_[b]) {
+                total_mass += body_mass_[b];
+                weighted_x += body_mass_[b] * body_x_[b];
+                weighted_y += body_mass_[b] * body_y_[b];
+            }
+        }
+        else {
+            for (std::int32_t c = node.first_child; c < node.first_child + 4; c++) {
+                total_mass += nodes_[c].mass;
+                weighted_x += nodes_[c].mass * nodes_[c].mass_center_x;
+                weighted_y += nodes_[c].mass * nodes_[c].mass_center_y;
+            }
+        }
+
+        node.mass = total_mass;
+        if (total_mass > T(0)) {
+            node.mass_center_x = weighted_x / total_mass;
+            node.mass_center_y = weighted_y / total_mass;
+        }
+    }
+}
+
+template <typename T>
+BasicVector2D<T> BasicBarnesHutTree<T>::calculate_force(BasicVector2D<T> position, T mass,
+                                                       std::size_t skip_body) const
+{
+    T fx = 0, fy = 0;
+
+    if (nodes_.empty()) {
+        return BasicVector2D<T>(0, 0);
+    }
+
+    const T theta_squared = theta_ * theta_;
+
+    // Every visited level pops one node and pushes at most four.
+    std::int32_t stack[3 * MAX_DEPTH + 4];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        const Node &node = nodes_[stack[--top]];
+
+        if (node.mass == T(0)) {
+            continue;
+        }
+
+        if (node.first_child < 0) {
+            for (std::int32_t b = node.first_body; b >= 0; b = body_next_[b]) {
+                if (body_ids_[b] != skip_body) {
+                    accumulate_pull(body_x_[b] - position.x, body_y_[b] - position.y,
+                                    body_mass_[b], fx, fy);
+                }
+            }
+            continue;
+        }
+
+        T dx = node.mass_center_x - position.x;
+        T dy = node.mass_center_y - position.y;
+        T size = T(2) * node.half_size;
+
+        if (size * size < theta_squared * (dx * dx + dy * dy)) {
+            accumulate_pull(dx, dy, node.mass, fx, fy);
+        }
+        else {
+            for (std::int32_t c = node.first_child; c < node.first_child + 4; c++) {
+                stack[top++] = c;
+            }
+        }
+    }
+
+    // A target without mass is a test particle of unit mass.
+    const T target_mass = (mass == T(0)) ? T(1) : mass;
+    return BasicVector2D<T>(fx * target_mass, fy * target_mass);
+}
+
+template <typename T>
+void BasicBarnesHutTree<T>::insert(std::int32_t body)
+{
+    std::int32_t node = 0;
+    int depth = 0;
+
+    while (true) {
+        if (nodes_[node].first_child >= 0) {
+            node = select_child(node, body);
+            depth++;
+        }
+        else if (nodes_[node].first_body < 0) {
+            nodes_[node].first_body = body;
+            body_next_[body] = -1;
+            return;
+        }
+        else if (depth >= MAX_DEPTH) {
+            // Bodies this close together are only ever visited as a whole leaf.
+            body_next_[body] = nodes_[node].first_body;
+            nodes_[node].first_body = body;
+            return;
+        }
+        else {
+            // Split the leaf and push its bodies one level down, then retry from the same node.
+            std::int32_t list = nodes_[node].first_body;
+            nodes_[node].first_body = -1;
+            subdivide(node);
+
+            while (list >= 0) {
+                std::int32_t next = body_next_[list];
+                std::int32_t child = select_child(node, list);
+                body_next_[list] = nodes_[child].first_body;
+                nodes_[child].first_body = list;
+                list = next;
+            }
+        }
+    }
+}
+
+template <typename T>
+std::int32_t BasicBarnesHutTree<T>::subdivide(std::int32_t node)
+{
+    const std::int32_t first_child = static_cast<std::int32_t>(nodes_.size());
+    const T quarter_size = T(0.5) * nodes_[node].half_size;
+    const T center_x = nodes_[node].center_x;
+    const T center_y = nodes_[node].center_y;
+
+    // Children are ordered by quadrant, see select_child().
+    for (int quadrant = 0; quadrant < 4; quadrant++) {
+        T child_x = (quadrant & 1) ? center_x + quarter_size : center_x - quarter_size;
+        T child_y = (quadrant & 2) ? center_y + quarter_size : center_y - quarter_size;
+        nodes_.push_back(Node{child_x, child_y, quarter_size, 0, 0, 0, -1, -1});
+    }
+
+    nodes_[node].first_child = first_child;
+    return first_child;
+}
+
+template <typename T>
+std::int32_t BasicBarnesHutTree<T>::select_child(std::int32_t node, std::int32_t body) const
+{
+    const Node &parent = nodes_[node];
+    int quadrant = (body_x_[body] >= parent.center_x ? 1 : 0) |
+                   (body_y_[body] >= parent.center_y ? 2 : 0);
+    return parent.first_child + quadrant;
+}
+
+// Explicitly instantiate all the supported precisions
+template class BasicBarnesHutTree<float>;
+template class BasicBarnesHutTree<double>;
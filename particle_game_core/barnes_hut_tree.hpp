@@ -0,0 +1,164 @@
+/**
+ * @file    barnes_hut_tree.hpp
+ * @author  Martin Cagas
+ *
+ * @brief   Quadtree approximating the gravitational pull of many point masses.
+ */
+
+#pragma once
+
+// Standard includes
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+// "Game essentials" library includes
+#include <vector2d.hpp>
+
+/**
+ * @class   BasicBarnesHutTree
+ *
+ * @brief   Quadtree approximating the gravitational pull of many point masses.
+ *
+ * @section DESCRIPTION
+ *
+ * Summing up the pull of every point mass on every object is quadratic in the amount of bodies.
+ * The Barnes-Hut algorithm sorts the bodies into a quadtree, where every node knows the total mass
+ * and the centre of mass of the bodies below it. When calculating the force acting on an object,
+ * nodes that are far enough away are treated as a single point mass instead of visiting all their
+ * bodies, which brings the cost of a force evaluation down to a logarithmic one.
+ *
+ * A node of a given size is considered far enough when size / distance < theta (the opening angle).
+ * Lower angles are more accurate and slower, 0.0 visits every body and gives the exact sum. The
+ * force law is the one of GravityObject::calculate_point_mass_force().
+ *
+ * The tree is meant to be rebuilt every step. All memory is kept between the builds, so after the
+ * first few steps building the tree does not allocate.
+ *
+ * BarnesHutTree works in double precision and BarnesHutTreeF in single precision.
+ *
+ * @section USAGE
+ *
+ * @code
+ *
+ * BarnesHutTree tree;
+ *
+ * tree.set_theta(0.5);
+ * tree.build(x.data(), y.data(), mass.data(), x.size());
+ *
+ * Vector2D force = tree.calculate_force(Point2D(0.0, 0.0), 1.0, BarnesHutTree::NO_BODY);
+ *
+ * @endcode
+ */
+template <typename T>
+class BasicBarnesHutTree
+{
+public:
+    static constexpr std::size_t NO_BODY = static_cast<std::size_t>(-1);  ///< No body to skip.
+    static constexpr int MAX_DEPTH = 32;  ///< Depth below which coincident bodies share a leaf.
+
+    /**
+     * @brief   Constructor.
+     *
+     * @details
+     *
+     * Initialises the opening angle to 0.5.
+     */
+    BasicBarnesHutTree(void);
+
+    /**
+     * @brief   theta_ setter.
+     *
+     * @param   theta       The opening angle, 0.0 or greater.
+     */
+    void set_theta(T theta);
+
+    /**
+     * @brief   theta_ getter.
+     */
+    T get_theta(void) const;
+
+    /**
+     * @brief   Rebuilds the tree over a new set of bodies.
+     *
+     * @details
+     *
+     * Bodies without a positive mass exert no force and are left out of the tree. The arrays are
+     * only read during the build, they do not need to outlive it.
+     *
+     * @param   *x          X components of the positions of the bodies.
+     * @param   *y          Y components of the positions of the bodies.
+     * @param   *mass       Masses of the bodies.
+     * @param   count       Amount of bodies.
+     */
+    void build(const T *x, const T *y, const T *mass, std::size_t count);
+
+    /**
+     * @brief   Calculates the approximate gravitational force of all bodies on an object.
+     *
+     * @param   position    Position of the object.
+     * @param   mass        Mass of the object.
+     * @param   skip_body   Index of a body to leave out - the object itself if it is one of the
+     *                      bodies, NO_BODY otherwise.
+     *
+     * @return  Vector2D representing the gravitational force.
+     */
+    essentials::BasicVector2D<T> calculate_force(essentials::BasicVector2D<T> position, T mass,
+                                                 std::size_t skip_body) const;
+
+protected:
+    /**
+     * @brief   A single square cell of the quadtree.
+     */
+    struct Node
+    {
+        T center_x;                ///< X component of the centre of the cell.
+        T center_y;                ///< Y component of the centre of the cell.
+        T half_size;               ///< Half of the length of the cell's side.
+        T mass;                    ///< Total mass of the bodies in the cell.
+        T mass_center_x;           ///< X component of the centre of mass of the bodies in the cell.
+        T mass_center_y;           ///< Y component of the centre of mass of the bodies in the cell.
+        std::int32_t first_child;  ///< Index of the first of four consecutive children, or -1.
+        std::int32_t first_body;   ///< Index of the first body of a leaf, or -1.
+    };
+
+    /**
+     * @brief   Inserts a body into the tree, subdividing the leaves as needed.
+     *
+     * @param   body        Index of the body.
+     */
+    void insert(std::int32_t body);
+
+    /**
+     * @brief   Appends four children to a node and returns the index of the first one.
+     *
+     * @param   node        Index of the parent node.
+     */
+    std::int32_t subdivide(std::int32_t node);
+
+    /**
+     * @brief   Returns the index of the child of a node containing the given body.
+     *
+     * @param   node        Index of the parent node.
+     * @param   body        Index of the body.
+     */
+    std::int32_t select_child(std::int32_t node, std::int32_t body) const;
+
+    T theta_;                              ///< The opening angle.
+    std::vector<Node> nodes_;              ///< All nodes, children always stored after parents.
+    std::vector<T> body_x_;                ///< X components of the positions of the bodies.
+    std::vector<T> body_y_;                ///< Y components of the positions of the bodies.
+    std::vector<T> body_mass_;             ///< Masses of the bodies.
+    std::vector<std::size_t> body_ids_;    ///< Original indices of the bodies.
+    std::vector<std::int32_t> body_next_;  ///< Next body in the same leaf, or -1.
+};
+
+/**
+ * @brief   Double precision Barnes-Hut tree.
+ */
+typedef BasicBarnesHutTree<double> BarnesHutTree;
+
+/**
+ * @brief   Single precision Barnes-Hut tree.
+ */
+typedef BasicBarnesHutTree<float> BarnesHutTreeF;
@@ -0,0 +1,173 @@
+/**
+ * @file    emitter.cpp
+ * @author  Martin Cagas
+ *
+ * @brief   Class spawning particles into the game world.
+ */
+
+#include "emitter.hpp"
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace essentials;
+
+template <typename T>
+BasicEmitter<T>::BasicEmitter(BasicVector2D<T> position)
+    : BasicPhysicsObject<T>(position),
+      rate_(0.0),
+      accumulator_(0.0),
+      burst_count_(0),
+      pending_(0),
+      direction_(90.0),
+      spread_(360.0),
+      min_speed_(1.0),
+      max_speed_(1.0),
+      lifetime_(std::numeric_limits<T>::infinity()),
+      particle_mass_(0.0),
+      particle_radius_(0.0)
+{
+}
+
+template <typename T>
+void BasicEmitter<T>::set_rate(T rate) { rate_ = rate; }
+
+template <typename T>
+T BasicEmitter<T>::get_rate(void) const { return rate_; }
+
+template <typename T>
+void BasicEmitter<T>::set_burst_count(std::size_t burst_count) { burst_count_ = burst_count; }
+
+template <typename T>
+std::size_t BasicEmitter<T>::get_burst_count(void) const { return burst_count_; }
+
+template <typename T>
+void BasicEmitter<T>::burst(void) { pending_ += burst_count_; }
+
+template <typename T>
+void BasicEmitter<T>::set_direction(BasicAngle<T> direction) { direction_ = direction; }
+
+template <typename T>
+BasicAngle<T> BasicEmitter<T>::get_direction(void) const { return direction_; }
+
+template <typename T>
+void BasicEmitter<T>::set_spread(BasicAngle<T> spread) { spread_ = spread; }
+
+template <typename T>
+BasicAngle<T> BasicEmitter<T>::get_spread(void) const { return spread_; }
+
+template <typename T>
+void BasicEmitter<T>::set_speed_range(T min_speed, T max_speed)
+{
+    min_speed_ = min_speed;
+    max_speed_ = max_speed;
+}
+
+template <typename T>
+T BasicEmitter<T>::get_min_speed(void) const { return min_speed_; }
+
+template <typename T>
+T BasicEmitter<T>::get_max_speed(void) const { return max_speed_; }
+
+template <typename T>
+void BasicEmitter<T>::set_lifetime(T lifetime) { lifetime_ = lifetime; }
+
+template <typename T>
+T BasicEmitter<T>::get_lifetime(void) const { return lifetime_; }
+
+template <typename T>
+void BasicEmitter<T>::set_particle_mass(T particle_mass) { particle_mass_ = particle_mass; }
+
+template <typename T>
+T BasicEmitter<T>::get_particle_mass(void) const { return particle_mass_; }
+
+template <typename T>
+void BasicEmitter<T>::set_particle_radius(T particle_radius) { particle_radius_ = particle_radius; }
+
+template <typename T>
+T BasicEmitter<T>::get_particle_radius(void) const { return particle_radius_; }
+
+template <typename T>
+void BasicEmitter<T>::set_seed(std::uint64_t seed) { random_.set_seed(seed); }
+
+template <typename T>
+std::size_t BasicEmitter<T>::advance(T elapsed)
+{
+    accumulator_ += rate_ * elapsed;
+
+    T whole = std::floor(accumulator_);
+    accumulator_ -= whole;
+
+    std::size_t count = static_cast<std::size_t>(whole) + pending_;
+    pending_ = 0;
+    return count;
+}
+
+template <typename T>
+void BasicEmitter<T>::initialize_particles(BasicParticleStore<T> &store, std::size_t first,
+                                           std::size_t count)
+{
+    const BasicVector2D<T> position = this->position_;
+    const BasicVector2D<T> velocity = this->velocity_;
+    const T min_angle = direction_.get_as_radians() - T(0.5) * spread_.get_as_radians();
+    const T max_angle = direction_.get_as_radians() + T(0.5) * spread_.get_as_radians();
+
+    // Only the velocities are random, the rest of the batch is filled with constants.
+    for (std::size_t i = first; i < first + count; i++) {
+        T angle = random_.next_real(min_angle, max_angle);
+        T speed = random_.next_real(min_speed_, max_speed_);
+        store.vx[i] = velocity.x + std::cos(angle) * speed;
+        store.vy[i] = velocity.y + std::sin(angle) * speed;
+    }
+
+    std::fill(store.x.begin() + first, store.x.begin() + first + count, position.x);
+    std::fill(store.y.begin() + first, store.y.begin() + first + count, position.y);
+    std::fill(store.px.begin() + first, store.px.begin() + first + count, position.x);
+    std::fill(store.py.begin() + first, store.py.begin() + first + count, position.y);
+    std::fill(store.mass.begin() + first, store.mass.begin() + first + count, particle_mass_);
+    std::fill(store.lifetime.begin() + first, store.lifetime.begin() + first + count, lifetime_);
+    std::fill(store.radius.begin() + first, store.radius.begin() + first + count,
+              particle_radius_);
+}
+
+template <typename T>
+void BasicEmitter<T>::save(SnapshotWriter &writer) const
+{
+    BasicPhysicsObject<T>::save(writer);
+    writer.write_value(rate_);
+    writer.write_value(accumulator_);
+    writer.write_value(static_cast<std::uint64_t>(burst_count_));
+    writer.write_value(static_cast<std::uint64_t>(pending_));
+    writer.write_value(direction_.get_as_radians());
+    writer.write_value(spread_.get_as_radians());
+    writer.write_value(min_speed_);
+    writer.write_value(max_speed_);
+    writer.write_value(lifetime_);
+    writer.write_value(particle_mass_);
+    writer.write_value(particle_radius_);
+    writer.write_value(random_.get_state());
+}
+
+template <typename T>
+void BasicEmitter<T>::load(SnapshotReader &reader)
+{
+    BasicPhysicsObject<T>::load(reader);
+    rate_ = reader.read_value<T>();
+    accumulator_ = reader.read_value<T>();
+    burst_count_ = reader.read_value<std::uint64_t>();
+    pending_ = reader.read_value<std::uint64_t>();
+    direction_.set_from_radians(reader.read_value<T>());
+    spread_.set_from_radians(reader.read_value<T>());
+    min_speed_ = reader.read_value<T>();
+    max_speed_ = reader.read_value<T>();
+    lifetime_ = reader.read_value<T>();
+    particle_mass_ = reader.read_value<T>();
+    particle_radius_ = reader.read_value<T>();
+    random_.set_state(reader.read_value<Random::State>());
+}
+
+// Explicitly instantiate all the supported precisions
+template class BasicEmitter<float>;
+template class BasicEmitter<double>;
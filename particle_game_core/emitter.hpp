@@ -0,0 +1,268 @@
+/**
+ * @file    emitter.hpp
+ * @author  Martin Cagas
+ *
+ * @brief   Class spawning particles into the game world.
+ */
+
+#pragma once
+
+// Standard includes
+#include <cstdint>
+#include <cstdlib>
+
+// "Game essentials" library includes
+#include <angle.hpp>
+#include <random.hpp>
+#include <vector2d.hpp>
+
+// Local includes
+#include "particle_store.hpp"
+#include "physics_object.hpp"
+
+/**
+ * @class   BasicEmitter
+ *
+ * @brief   Class spawning particles into the game world.
+ *
+ * @section DESCRIPTION
+ *
+ * An emitter spawns particles at its position, continuously at a given rate and in bursts on
+ * demand. The particles fly off in a random direction within a cone around the emitter's direction,
+ * at a random speed within the speed range, on top of the emitter's own velocity.
+ *
+ * Emitters never spawn particles one by one. The world asks every emitter how many particles it
+ * wants to spawn in a step, spawns all of them as one batch of contiguous slots of the particle
+ * store and lets the emitter initialise the whole batch at once. Each emitter draws its random
+ * numbers from a generator of its own, so the batches of different emitters are initialised in
+ * parallel and the results only depend on the seeds.
+ *
+ * Emitter uses double precision and EmitterF single precision.
+ *
+ * @section USAGE
+ *
+ * @code
+ *
+ * auto emitter = std::make_unique<Emitter>(Point2D(0.0, 0.0));
+ *
+ * emitter->set_rate(500.0);
+ * emitter->set_spread(Angle(30.0));
+ * emitter->set_speed_range(5.0, 10.0);
+ * emitter->set_lifetime(2.0);
+ *
+ * world.add_emitter(std::move(emitter));
+ *
+ * @endcode
+ */
+template <typename T>
+class BasicEmitter : public BasicPhysicsObject<T>
+{
+public:
+    /**
+     * @brief   Contructor.
+     *
+     * @details
+     *
+     * The emitter starts without a rate and without bursts, pointing up with a spread of a full
+     * circle, a speed of 1.0 and an infinite lifetime of the particles.
+     *
+     * @param   position    Initial position.
+     */
+    BasicEmitter(essentials::BasicVector2D<T> position);
+
+    /**
+     * @brief   Destructor.
+     *
+     * @details
+     *
+     * Virtual, because the game world owns its emitters through pointers to this class.
+     */
+    virtual ~BasicEmitter(void) = default;
+
+    /**
+     * @brief   rate_ setter.
+     *
+     * @param   rate        Amount of particles spawned per unit of time.
+     */
+    void set_rate(T rate);
+
+    /**
+     * @brief   rate_ getter.
+     */
+    T get_rate(void) const;
+
+    /**
+     * @brief   burst_count_ setter.
+     *
+     * @param   burst_count     Amount of particles spawned by every burst().
+     */
+    void set_burst_count(std::size_t burst_count);
+
+    /**
+     * @brief   burst_count_ getter.
+     */
+    std::size_t get_burst_count(void) const;
+
+    /**
+     * @brief   Makes the emitter spawn burst_count_ extra particles in the next step.
+     */
+    void burst(void);
+
+    /**
+     * @brief   direction_ setter.
+     *
+     * @param   direction   Direction of the axis of the cone the particles fly off in.
+     */
+    void set_direction(essentials::BasicAngle<T> direction);
+
+    /**
+     * @brief   direction_ getter.
+     */
+    essentials::BasicAngle<T> get_direction(void) const;
+
+    /**
+     * @brief   spread_ setter.
+     *
+     * @param   spread      Full width of the cone the particles fly off in.
+     */
+    void set_spread(essentials::BasicAngle<T> spread);
+
+    /**
+     * @brief   spread_ getter.
+     */
+    essentials::BasicAngle<T> get_spread(void) const;
+
+    /**
+     * @brief   Sets the range of the speeds the particles fly off at.
+     *
+     * @param   min_speed   Lowest speed.
+     * @param   max_speed   Highest speed.
+     */
+    void set_speed_range(T min_speed, T max_speed);
+
+    /**
+     * @brief   min_speed_ getter.
+     */
+    T get_min_speed(void) const;
+
+    /**
+     * @brief   max_speed_ getter.
+     */
+    T get_max_speed(void) const;
+
+    /**
+     * @brief   lifetime_ setter.
+     *
+     * @param   lifetime    Time after which the spawned particles expire.
+     */
+    void set_lifetime(T lifetime);
+
+    /**
+     * @brief   lifetime_ getter.
+     */
+    T get_lifetime(void) const;
+
+    /**
+     * @brief   particle_mass_ setter.
+     *
+     * @param   particle_mass   Mass of the spawned particles.
+     */
+    void set_particle_mass(T particle_mass);
+
+    /**
+     * @brief   particle_mass_ getter.
+     */
+    T get_particle_mass(void) const;
+
+    /**
+     * @brief   particle_radius_ setter.
+     *
+     * @param   particle_radius     Radius of the spawned particles, 0.0 for particles that never
+     *                              collide.
+     */
+    void set_particle_radius(T particle_radius);
+
+    /**
+     * @brief   particle_radius_ getter.
+     */
+    T get_particle_radius(void) const;
+
+    /**
+     * @brief   Restarts the emitter's random number generator from a seed.
+     */
+    void set_seed(std::uint64_t seed);
+
+    /**
+     * @brief   Advances the emission by a step and returns the amount of particles to spawn.
+     *
+     * @details
+     *
+     * Fractions of particles are carried over to the next steps, so low rates still spawn the
+     * right amount of particles over time. Pending bursts are included and cleared.
+     *
+     * @param   elapsed     Length of the step.
+     */
+    std::size_t advance(T elapsed);
+
+    /**
+     * @brief   Initialises a batch of freshly spawned particles.
+     *
+     * @details
+     *
+     * Called by the world for the slots it spawned for this emitter, possibly concurrently with
+     * the other emitters. Derived classes may override it to spawn other shapes, as long as they
+     * only touch the given slots and their own state.
+     *
+     * @param   &store      Store of the particles.
+     * @param   first       Index of the first slot of the batch.
+     * @param   count       Amount of slots in the batch.
+     */
+    virtual void initialize_particles(BasicParticleStore<T> &store, std::size_t first,
+                                      std::size_t count);
+
+    /**
+     * @brief   Writes the settings and the state of the emission into a snapshot.
+     *
+     * @details
+     *
+     * The state includes the carried fraction of a particle, the pending bursts and the state of
+     * the random generator, so a loaded emitter continues with exactly the same particles. Derived
+     * classes with a state of their own must override both save() and load().
+     *
+     * @param   &writer     Writer of the snapshot.
+     */
+    virtual void save(SnapshotWriter &writer) const;
+
+    /**
+     * @brief   Reads the settings and the state of the emission written by save().
+     *
+     * @param   &reader     Reader of the snapshot.
+     *
+     * @throws  std::runtime_error if the snapshot is malformed.
+     */
+    virtual void load(SnapshotReader &reader);
+
+protected:
+    T rate_;                               ///< Amount of particles spawned per unit of time.
+    T accumulator_;                        ///< Fraction of a particle carried over between steps.
+    std::size_t burst_count_;              ///< Amount of particles spawned by every burst.
+    std::size_t pending_;                  ///< Amount of burst particles waiting for the next step.
+    essentials::BasicAngle<T> direction_;  ///< Direction of the axis of the cone of the particles.
+    essentials::BasicAngle<T> spread_;     ///< Full width of the cone of the particles.
+    T min_speed_;                          ///< Lowest speed of the particles.
+    T max_speed_;                          ///< Highest speed of the particles.
+    T lifetime_;                           ///< Time after which the particles expire.
+    T particle_mass_;                      ///< Mass of the particles.
+    T particle_radius_;                    ///< Radius of the particles.
+    essentials::Random random_;            ///< Generator of the emitter's random numbers.
+};
+
+/**
+ * @brief   Double precision emitter.
+ */
+typedef BasicEmitter<double> Emitter;
+
+/**
+ * @brief   Single precision emitter.
+ */
+typedef BasicEmitter<float> EmitterF;
@@ -9,41 +9,121 @@
 
 using namespace essentials;
 
-GravityConstant::GravityConstant(void)
-    : GravityObject(Vector2D(0.0, 0.0)), gravity_angle_(270.0), gravity_strength_(10.0)
+template <typename T>
+BasicGravityConstant<T>::BasicGravityConstant(void)
+    : BasicGravityObject<T>(BasicVector2D<T>(0.0, 0.0)),
+      gravity_angle_(270.0),
+      gravity_strength_(10.0)
 {
+    this->enable();
+    update_acceleration();
 }
 
-void GravityConstant::set_gravity_angle_from_rad(double gravity_rad_angle)
+template <typename T>
+void BasicGravityConstant<T>::set_gravity_angle_from_rad(T gravity_rad_angle)
 {
     gravity_angle_.set_from_radians(gravity_rad_angle);
+    update_acceleration();
 }
 
-void GravityConstant::set_gravity_angle_from_deg(double gravity_deg_angle)
+template <typename T>
+void BasicGravityConstant<T>::set_gravity_angle_from_deg(T gravity_deg_angle)
 {
     gravity_angle_.set_from_degrees(gravity_deg_angle);
+    update_acceleration();
 }
 
-double GravityConstant::get_gravity_angle_as_rad(void) const
+template <typename T>
+T BasicGravityConstant<T>::get_gravity_angle_as_rad(void) const
 {
     return gravity_angle_.get_as_radians();
 }
 
-double GravityConstant::get_gravity_angle_as_deg(void) const
+template <typename T>
+T BasicGravityConstant<T>::get_gravity_angle_as_deg(void) const
 {
     return gravity_angle_.get_as_degrees();
 }
 
-void GravityConstant::set_gravity_strength(double gravity_strength)
+template <typename T>
+void BasicGravityConstant<T>::set_gravity_strength(T gravity_strength)
 {
     gravity_strength_ = gravity_strength;
+    update_acceleration();
 }
 
-double GravityConstant::get_gravity_strength(void) const { return gravity_strength_; }
+template <typename T>
+T BasicGravityConstant<T>::get_gravity_strength(void) const { return gravity_strength_; }
 
-Vector2D GravityConstant::calculate_force(const PhysicsObject &to_object) const
+template <typename T>
+BasicVector2D<T> BasicGravityConstant<T>::calculate_force(
+    const BasicPhysicsObject<T> &to_object) const
 {
-    Vector2D ret = Vector2D();
-    ret.set_from_angle(gravity_angle_.get_as_radians());
-    return ret * gravity_strength_;
+    if (!this->is_enabled_) {
+        return BasicVector2D<T>(0.0, 0.0);
+    }
+
+    const T mass = to_object.get_mass();
+    return acceleration_ * ((mass != T(0)) ? mass : T(1));
+}
+
+template <typename T>
+void BasicGravityConstant<T>::accumulate_forces(const T *x, const T *y, const T *mass, T *fx,
+                                                T *fy, std::size_t count) const
+{
+    if (!this->is_enabled_) {
+        return;
+    }
+
+    const T acceleration_x = acceleration_.x;
+    const T acceleration_y = acceleration_.y;
+
+    for (std::size_t i = 0; i < count; i++) {
+        T scale = (mass[i] != T(0)) ? mass[i] : T(1);
+        fx[i] += acceleration_x * scale;
+        fy[i] += acceleration_y * scale;
+    }
+}
+
+template <typename T>
+bool BasicGravityConstant<T>::is_point_mass(void) const { return false; }
+
+template <typename T>
+bool BasicGravityConstant<T>::get_uniform_acceleration(BasicVector2D<T> &acceleration) const
+{
+    // A disabled constant exerts no force at all, so it has no acceleration to add up either.
+    if (!this->is_enabled_) {
+        return false;
+    }
+
+    acceleration = acceleration_;
+    return true;
 }
+
+template <typename T>
+void BasicGravityConstant<T>::update_acceleration(void)
+{
+    acceleration_.set_from_angle(gravity_angle_.get_as_radians());
+    acceleration_ *= gravity_strength_;
+}
+
+template <typename T>
+void BasicGravityConstant<T>::save(SnapshotWriter &writer) const
+{
+    BasicGravityObject<T>::save(writer);
+    writer.write_value(gravity_angle_.get_as_radians());
+    writer.write_value(gravity_strength_);
+}
+
+template <typename T>
+void BasicGravityConstant<T>::load(SnapshotReader &reader)
+{
+    BasicGravityObject<T>::load(reader);
+    gravity_angle_.set_from_radians(reader.read_value<T>());
+    gravity_strength_ = reader.read_value<T>();
+    update_acceleration();
+}
+
+// Explicitly instantiate all the supported precisions
+template class BasicGravityConstant<float>;
+template class BasicGravityConstant<double>;
@@ -20,15 +20,24 @@
 #include "gravity_object.hpp"
 
 /**
- * @class   GravityConstant
+ * @class   BasicGravityConstant
  *
  * @brief   Class exerting the same gravitational pull on all objects.
  *
  * @section DESCRIPTION
  *
  * This class derives from GravityObject. The gravitational force caluculation method is overriden
- * with a method returning a constant vector (i.e. this GravityObject exerts the exact same force on
- * all other objects).
+ * with a method returning a constant vector scaled by the mass of the object it acts on (i.e. this
+ * GravityObject gives the exact same acceleration to all other objects). Objects without mass are
+ * treated as having a unit mass. Unlike a plain GravityObject, the constant gravity starts enabled,
+ * disable() turns it off.
+ *
+ * The acceleration vector is computed once whenever the angle or the strength changes, so applying
+ * the gravity never evaluates any trigonometric functions. The world recognises the constant
+ * gravity through get_uniform_acceleration() and adds it straight to the velocities of all the
+ * particles.
+ *
+ * GravityConstant uses double precision and GravityConstantF single precision.
  *
  * @section USAGE
  *
@@ -36,7 +45,8 @@
  *
  * @endcode
  */
-class GravityConstant : public GravityObject
+template <typename T>
+class BasicGravityConstant : public BasicGravityObject<T>
 {
 public:
     /**
@@ -47,46 +57,48 @@ public:
      * Initialises the angle to 270 degrees - i.e. "straight down".
      *
      * Initialises the strength to 10.0.
+     *
+     * Enables the gravity, so it pulls right away.
      */
-    GravityConstant(void);
+    BasicGravityConstant(void);
 
     /**
      * @brief   gravity_angle_ setter.
      *
      * @param   New angle in radians.
      */
-    void set_gravity_angle_from_rad(double gravity_rad_angle);
+    void set_gravity_angle_from_rad(T gravity_rad_angle);
 
     /**
      * @brief   Alternate gravity_angle_ setter.
      *
      * @param   New angle in degrees.
      */
-    void set_gravity_angle_from_deg(double gravity_deg_angle);
+    void set_gravity_angle_from_deg(T gravity_deg_angle);
 
     /**
      * @brief   gravity_angle_ getter.
      *
      * @return  Gravity angle in radians.
      */
-    double get_gravity_angle_as_rad(void) const;
+    T get_gravity_angle_as_rad(void) const;
 
     /**
      * @brief   Alternate gravity_angle_ getter.
      *
      * @return  Gravity angle in degrees.
      */
-    double get_gravity_angle_as_deg(void) const;
+    T get_gravity_angle_as_deg(void) const;
 
     /**
      * @brief   gravity_strength_ setter.
      */
-    void set_gravity_strength(double gravity_strength);
+    void set_gravity_strength(T gravity_strength);
 
     /**
      * @brief   gravity_strength_ getter.
      */
-    double get_gravity_strength(void) const;
+    T get_gravity_strength(void) const;
 
     /**
      * @brief   Calculates the gravitational force exerted on another object.
@@ -100,9 +112,59 @@ public:
      *
      * @return  Vector2D representing the gravitational force.
      */
-    essentials::Vector2D calculate_force(const PhysicsObject &to_object) const;
+    essentials::BasicVector2D<T> calculate_force(const BasicPhysicsObject<T> &to_object) const;
+
+    /**
+     * @brief   Adds the constant gravitational pull to the forces of a whole range of objects.
+     *
+     * @see     GravityObject::accumulate_forces()
+     */
+    void accumulate_forces(const T *x, const T *y, const T *mass, T *fx, T *fy,
+                           std::size_t count) const;
+
+    /**
+     * @brief   Returns false, the constant gravity does not act as a point mass.
+     */
+    bool is_point_mass(void) const;
+
+    /**
+     * @brief   Returns true and the constant acceleration.
+     *
+     * @see     GravityObject::get_uniform_acceleration()
+     */
+    bool get_uniform_acceleration(essentials::BasicVector2D<T> &acceleration) const;
+
+    /**
+     * @brief   Writes the state of the gravity object, the angle and the strength into a snapshot.
+     *
+     * @see     GravityObject::save()
+     */
+    void save(SnapshotWriter &writer) const;
+
+    /**
+     * @brief   Reads the state written by save().
+     *
+     * @see     GravityObject::load()
+     */
+    void load(SnapshotReader &reader);
 
 protected:
-    essentials::Angle gravity_angle_;  ///< Direction of the gravity in radians.
-    double gravity_strength_;          ///< Strength of the gravitational force.
+    /**
+     * @brief   Recomputes acceleration_ from the angle and the strength.
+     */
+    void update_acceleration(void);
+
+    essentials::BasicAngle<T> gravity_angle_;    ///< Direction of the gravity in radians.
+    T gravity_strength_;                         ///< Strength of the gravitational force.
+    essentials::BasicVector2D<T> acceleration_;  ///< Acceleration given to every object.
 };
+
+/**
+ * @brief   Double precision constant gravity.
+ */
+typedef BasicGravityConstant<double> GravityConstant;
+
+/**
+ * @brief   Single precision constant gravity.
+ */
+typedef BasicGravityConstant<float> GravityConstantF;
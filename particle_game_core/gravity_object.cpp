@@ -7,45 +7,168 @@
 
 #include "gravity_object.hpp"
 
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 using namespace essentials;
 
-GravityObject::GravityObject(Point2D position) : PhysicsObject(position), is_enabled_(false) {}
+template <typename T>
+BasicGravityObject<T>::BasicGravityObject(BasicVector2D<T> position)
+    : BasicPhysicsObject<T>(position), is_enabled_(false), softening_(0.0), cutoff_radius_(0.0)
+{
+}
+
+template <typename T>
+void BasicGravityObject<T>::enable(void) { is_enabled_ = true; }
+
+template <typename T>
+void BasicGravityObject<T>::disable(void) { is_enabled_ = false; }
+
+template <typename T>
+bool BasicGravityObject<T>::get_is_enabled(void) const { return is_enabled_; }
+
+template <typename T>
+void BasicGravityObject<T>::set_softening(T softening) { softening_ = softening; }
 
-void GravityObject::enable(void) { is_enabled_ = true; }
+template <typename T>
+T BasicGravityObject<T>::get_softening(void) const { return softening_; }
 
-void GravityObject::disable(void) { is_enabled_ = false; }
+template <typename T>
+void BasicGravityObject<T>::set_cutoff_radius(T cutoff_radius) { cutoff_radius_ = cutoff_radius; }
 
-bool GravityObject::get_is_enabled(void) { return is_enabled_; }
+template <typename T>
+T BasicGravityObject<T>::get_cutoff_radius(void) const { return cutoff_radius_; }
 
-Vector2D GravityObject::calculate_force(const PhysicsObject &to_object) const
+template <typename T>
+bool BasicGravityObject<T>::can_reach(BasicVector2D<T> min, BasicVector2D<T> max) const
+{
+    if (cutoff_radius_ <= T(0)) {
+        return true;
+    }
+
+    const T dx = std::max({min.x - this->position_.x, this->position_.x - max.x, T(0)});
+    const T dy = std::max({min.y - this->position_.y, this->position_.y - max.y, T(0)});
+    return dx * dx + dy * dy < cutoff_radius_ * cutoff_radius_;
+}
+
+template <typename T>
+BasicVector2D<T> BasicGravityObject<T>::calculate_force(
+    const BasicPhysicsObject<T> &to_object) const
 {
     if (!is_enabled_) {
-        return Vector2D(0.0, 0.0);
+        return BasicVector2D<T>(0.0, 0.0);
+    }
+
+    BasicVector2D<T> offset = this->position_ - to_object.get_position();
+    T distance_squared = offset.x * offset.x + offset.y * offset.y;
+
+    if (cutoff_radius_ > T(0) && distance_squared >= cutoff_radius_ * cutoff_radius_) {
+        return BasicVector2D<T>(0.0, 0.0);
     }
     else {
         // Simplified computation, see doxygen comments in the header file for explanation.
-        double combined_mass = 0.0;
-        double this_mass = mass_;
-        double other_mass = to_object.get_mass();
-
-        double distance = position_.distance_to(to_object.get_position());
-        Vector2D direction = position_.direction_to(to_object.get_position());
-
-        if (to_object.get_mass() == 0.0) {
-            combined_mass == this_mass;
-        }
-        else if (mass_ == 0.0) {
-            combined_mass == other_mass;
-        }
-        else {
-            combined_mass = this_mass * other_mass;
-        }
-
-        if (combined_mass == 0.0) {
-            return Vector2D(0.0, 0.0);
-        }
-        else {
-            return direction * (combined_mass / (distance * distance));
-        }
+        return calculate_point_mass_force(this->position_, this->mass_, to_object.get_position(),
+                                          to_object.get_mass(), softening_);
+    }
+}
+
+template <typename T>
+void BasicGravityObject<T>::accumulate_forces(const T *x, const T *y, const T *mass, T *fx, T *fy,
+                                              std::size_t count) const
+{
+    if (!is_enabled_ || this->mass_ == T(0)) {
+        return;
+    }
+
+    const T source_x = this->position_.x;
+    const T source_y = this->position_.y;
+    const T source_mass = this->mass_;
+    const T softening_squared = softening_ * softening_;
+    const T cutoff_squared = (cutoff_radius_ > T(0)) ? cutoff_radius_ * cutoff_radius_
+                                                     : std::numeric_limits<T>::infinity();
+
+    // Same operations as calculate_point_mass_force(), with the branches turned into selects, so
+    // that the targets beyond the cutoff cost a compare instead of a square root and a division.
+    for (std::size_t i = 0; i < count; i++) {
+        T dx = source_x - x[i];
+        T dy = source_y - y[i];
+        T distance_squared = dx * dx + dy * dy;
+        T softened_squared = distance_squared + softening_squared;
+        bool acts = (distance_squared < cutoff_squared) && (softened_squared != T(0));
+        T combined_mass = (mass[i] == T(0)) ? source_mass : source_mass * mass[i];
+        T inverse_distance = T(1) / std::sqrt(acts ? softened_squared : T(1));
+        T scale = acts ? combined_mass * inverse_distance * inverse_distance * inverse_distance
+                       : T(0);
+
+        fx[i] += dx * scale;
+        fy[i] += dy * scale;
     }
 }
+
+template <typename T>
+bool BasicGravityObject<T>::is_point_mass(void) const
+{
+    return softening_ == T(0) && cutoff_radius_ <= T(0);
+}
+
+template <typename T>
+bool BasicGravityObject<T>::get_uniform_acceleration(BasicVector2D<T> &acceleration) const
+{
+    return false;
+}
+
+template <typename T>
+BasicVector2D<T> BasicGravityObject<T>::calculate_point_mass_force(BasicVector2D<T> source,
+                                                                   T source_mass,
+                                                                   BasicVector2D<T> target,
+                                                                   T target_mass, T softening)
+{
+    T combined_mass = 0.0;
+
+    if (source_mass == T(0)) {
+        return BasicVector2D<T>(0.0, 0.0);
+    }
+    else if (target_mass == T(0)) {
+        combined_mass = source_mass;
+    }
+    else {
+        combined_mass = source_mass * target_mass;
+    }
+
+    T dx = source.x - target.x;
+    T dy = source.y - target.y;
+    T softened_squared = dx * dx + dy * dy + softening * softening;
+
+    if (softened_squared == T(0)) {
+        return BasicVector2D<T>(0.0, 0.0);
+    }
+    else {
+        T inverse_distance = T(1) / std::sqrt(softened_squared);
+        T scale = combined_mass * inverse_distance * inverse_distance * inverse_distance;
+        return BasicVector2D<T>(dx * scale, dy * scale);
+    }
+}
+
+template <typename T>
+void BasicGravityObject<T>::save(SnapshotWriter &writer) const
+{
+    BasicPhysicsObject<T>::save(writer);
+    writer.write_value(static_cast<std::uint8_t>(is_enabled_));
+    writer.write_value(softening_);
+    writer.write_value(cutoff_radius_);
+}
+
+template <typename T>
+void BasicGravityObject<T>::load(SnapshotReader &reader)
+{
+    BasicPhysicsObject<T>::load(reader);
+    is_enabled_ = reader.read_value<std::uint8_t>() != 0;
+    softening_ = reader.read_value<T>();
+    cutoff_radius_ = reader.read_value<T>();
+}
+
+// Explicitly instantiate all the supported precisions
+template class BasicGravityObject<float>;
+template class BasicGravityObject<double>;
@@ -17,7 +17,7 @@
 #include "physics_object.hpp"
 
 /**
- * @class   GravityObject
+ * @class   BasicGravityObject
  *
  * @brief   Class capable of computing its own gravitational pull on other objects.
  *
@@ -26,6 +26,14 @@
  * A part of a particle simulation game, this class derives PhysicsObject and provides a method for
  * gravitational force calculation exerted on other objects.
  *
+ * Two optional settings tame the point mass force law. Plummer softening adds the squared softening
+ * length to the squared distance, so the force stays finite and fades to zero as the objects get
+ * close instead of blowing up. A cutoff radius ignores all objects farther than it, which lets the
+ * world skip the object altogether for whole groups of particles out of its reach. Objects using
+ * either of them are evaluated directly rather than through the Barnes-Hut tree.
+ *
+ * GravityObject uses double precision and GravityObjectF single precision.
+ *
  * @section USAGE
  *
  * @code
@@ -38,13 +46,23 @@
  *
  * @endcode
  */
-class GravityObject : public PhysicsObject
+template <typename T>
+class BasicGravityObject : public BasicPhysicsObject<T>
 {
 public:
     /**
      * @brief   Contructor.
      */
-    GravityObject(essentials::Point2D position);
+    BasicGravityObject(essentials::BasicVector2D<T> position);
+
+    /**
+     * @brief   Destructor.
+     *
+     * @details
+     *
+     * Virtual, because the game world owns its gravity objects through pointers to this class.
+     */
+    virtual ~BasicGravityObject(void) = default;
 
     /**
      * @brief   Enables the gravity object by setting is_enabled_ to true.
@@ -59,7 +77,45 @@ public:
     /**
      * @brief   Returns true if the gravity object is enabled, false otherwise.
      */
-    bool get_is_enabled(void);
+    bool get_is_enabled(void) const;
+
+    /**
+     * @brief   softening_ setter.
+     *
+     * @param   softening   Plummer softening length, 0.0 for the plain inverse-square law.
+     */
+    void set_softening(T softening);
+
+    /**
+     * @brief   softening_ getter.
+     */
+    T get_softening(void) const;
+
+    /**
+     * @brief   cutoff_radius_ setter.
+     *
+     * @param   cutoff_radius   Distance beyond which the object exerts no force, 0.0 for none.
+     */
+    void set_cutoff_radius(T cutoff_radius);
+
+    /**
+     * @brief   cutoff_radius_ getter.
+     */
+    T get_cutoff_radius(void) const;
+
+    /**
+     * @brief   Returns false if the object cannot exert any force inside a box, true otherwise.
+     *
+     * @details
+     *
+     * A cheap conservative test for culling the object for a whole group of targets at once,
+     * based on the distance from the object to the nearest point of the box.
+     *
+     * @param   min         Corner of the box with the lowest coordinates.
+     * @param   max         Corner of the box with the highest coordinates.
+     */
+    virtual bool can_reach(essentials::BasicVector2D<T> min,
+                           essentials::BasicVector2D<T> max) const;
 
     /**
      * @brief   Calculates the gravitational force exerted on another object.
@@ -74,9 +130,111 @@ public:
      * @param   &to_object      A reference to the other object.
      *
      * @return  Vector2D representing the gravitational force.
+     *
+     * @see     GravityObject::calculate_point_mass_force()
+     */
+    virtual essentials::BasicVector2D<T> calculate_force(
+        const BasicPhysicsObject<T> &to_object) const;
+
+    /**
+     * @brief   Adds the gravitational force exerted on a whole range of objects to their forces.
+     *
+     * @details
+     *
+     * Batched equivalent of calculate_force(), applying the object to many targets with a single
+     * call. The objects are given as parallel arrays, as kept by ParticleStore.
+     *
+     * @param   *x          X components of the positions of the targets.
+     * @param   *y          Y components of the positions of the targets.
+     * @param   *mass       Masses of the targets.
+     * @param   *fx         X components of the force accumulators of the targets.
+     * @param   *fy         Y components of the force accumulators of the targets.
+     * @param   count       Amount of targets.
+     */
+    virtual void accumulate_forces(const T *x, const T *y, const T *mass, T *fx, T *fy,
+                                   std::size_t count) const;
+
+    /**
+     * @brief   Returns true if the object acts as a point mass, false otherwise.
+     *
+     * @details
+     *
+     * The force exerted by a point mass is fully described by its position and mass, which allows
+     * the world to approximate groups of point masses in the Barnes-Hut tree. Derived classes with
+     * a different force law must return false, so that they are always evaluated directly. So does
+     * an object with softening or a cutoff radius.
+     */
+    virtual bool is_point_mass(void) const;
+
+    /**
+     * @brief   Returns true if the object gives all objects the same acceleration, false otherwise.
+     *
+     * @details
+     *
+     * The world does not accumulate the forces of such objects particle by particle. It adds their
+     * accelerations up once per step and adds the sum to the velocities in the integration pass.
+     *
+     * @param   &acceleration   Receives the acceleration if the object has a uniform one.
+     */
+    virtual bool get_uniform_acceleration(essentials::BasicVector2D<T> &acceleration) const;
+
+    /**
+     * @brief   The force law shared by all point masses in the game world.
+     *
+     * @details
+     *
+     * The force points from the target towards the source and its magnitude is the product of the
+     * masses divided by the squared distance. A source without mass exerts no force. A target
+     * without mass is treated as a test particle of unit mass, so that it still falls towards the
+     * source. Coincident objects exert no force on each other.
+     *
+     * With softening, the magnitude is the product of the masses times the distance divided by
+     * (distance^2 + softening^2)^(3/2). The force only takes a single square root either way.
+     *
+     * @param   source          Position of the object exerting the force.
+     * @param   source_mass     Mass of the object exerting the force.
+     * @param   target          Position of the object the force acts on.
+     * @param   target_mass     Mass of the object the force acts on.
+     * @param   softening       Plummer softening length.
+     *
+     * @return  Vector2D representing the gravitational force.
+     */
+    static essentials::BasicVector2D<T> calculate_point_mass_force(
+        essentials::BasicVector2D<T> source, T source_mass, essentials::BasicVector2D<T> target,
+        T target_mass, T softening = 0.0);
+
+    /**
+     * @brief   Writes the state of the gravity object into a snapshot.
+     *
+     * @details
+     *
+     * Derived classes with a state of their own must override both save() and load().
+     *
+     * @param   &writer         Writer of the snapshot.
      */
-    virtual essentials::Vector2D calculate_force(const PhysicsObject &to_object) const;
+    virtual void save(SnapshotWriter &writer) const;
+
+    /**
+     * @brief   Reads the state of the gravity object written by save().
+     *
+     * @param   &reader         Reader of the snapshot.
+     *
+     * @throws  std::runtime_error if the snapshot is malformed.
+     */
+    virtual void load(SnapshotReader &reader);
 
 protected:
     bool is_enabled_;  ///< True if the gravity object is enabled, false otherwise.
+    T softening_;      ///< Plummer softening length of the force.
+    T cutoff_radius_;  ///< Distance beyond which the object exerts no force, 0.0 for none.
 };
+
+/**
+ * @brief   Double precision gravity object.
+ */
+typedef BasicGravityObject<double> GravityObject;
+
+/**
+ * @brief   Single precision gravity object.
+ */
+typedef BasicGravityObject<float> GravityObjectF;
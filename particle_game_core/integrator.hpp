@@ -0,0 +1,281 @@
+/**
+ * @file    integrator.hpp
+ * @author  Martin Cagas
+ *
+ * @brief   Numerical integrators advancing the particles of the game world in time.
+ *
+ * @section DESCRIPTION
+ *
+ * Every integrator is a policy class describing one step as a fixed amount of stages. A stage
+ * moves the particles to where the forces are to be evaluated, lets the world evaluate them and
+ * then consumes them. The world runs the stages of the integrator picked at runtime, but each
+ * integrator's per-particle operations are compiled into loops of their own, so the loops over the
+ * particles never branch on the integrator or on the stage.
+ *
+ * The integrators turn forces into accelerations by dividing them by the mass of the particle.
+ * Particles without mass are treated as having a unit mass, like the gravity objects treat them.
+ * The acceleration shared by all the particles, such as a constant gravity, is added on top of
+ * that instead of going through the force accumulators.
+ */
+
+#pragma once
+
+// Standard includes
+#include <cstdlib>
+
+/**
+ * @brief   Numerical integrator advancing the particles in time.
+ */
+enum class Integrator
+{
+    SYMPLECTIC_EULER,  ///< First order, one force evaluation per step.
+    VELOCITY_VERLET,   ///< Second order, one force evaluation per step.
+    RUNGE_KUTTA_4,     ///< Fourth order, four force evaluations per step.
+};
+
+/**
+ * @brief   Pointers to the arrays of the particles the integrators work on.
+ *
+ * @details
+ *
+ * The scratch arrays are only used by some of the integrators and may be null for the others.
+ */
+template <typename T>
+struct IntegratorArrays
+{
+    T *x;              ///< X components of the positions.
+    T *y;              ///< Y components of the positions.
+    T *px;             ///< X components of the previous positions.
+    T *py;             ///< Y components of the previous positions.
+    T *vx;             ///< X components of the velocities.
+    T *vy;             ///< Y components of the velocities.
+    T *fx;             ///< X components of the accumulated forces.
+    T *fy;             ///< Y components of the accumulated forces.
+    T *ax;             ///< X components of the accelerations of the last step.
+    T *ay;             ///< Y components of the accelerations of the last step.
+    const T *mass;     ///< Masses.
+    T *start_vx;       ///< Scratch, x components of the velocities at the start of the step.
+    T *start_vy;       ///< Scratch, y components of the velocities at the start of the step.
+    T *slope_x;        ///< Scratch, weighted sum of the x components of the velocity slopes.
+    T *slope_y;        ///< Scratch, weighted sum of the y components of the velocity slopes.
+    T *slope_vx;       ///< Scratch, weighted sum of the x components of the acceleration slopes.
+    T *slope_vy;       ///< Scratch, weighted sum of the y components of the acceleration slopes.
+    T *external_fx;    ///< Scratch, x components of the forces applied before the step.
+    T *external_fy;    ///< Scratch, y components of the forces applied before the step.
+    T uniform_ax;      ///< X component of the acceleration shared by all the particles.
+    T uniform_ay;      ///< Y component of the acceleration shared by all the particles.
+    T time_step;       ///< Length of the step.
+};
+
+/**
+ * @brief   Returns the factor turning a force acting on a particle into its acceleration.
+ */
+template <typename T>
+inline T inverse_mass(T mass)
+{
+    return (mass != T(0)) ? T(1) / mass : T(1);
+}
+
+/**
+ * @class   SymplecticEuler
+ *
+ * @brief   Semi-implicit Euler integrator.
+ *
+ * @details
+ *
+ * Kicks the velocity by the acceleration at the start of the step and then drifts the position
+ * with the new velocity. First order, but symplectic, so orbits neither spiral in nor out over
+ * time. The cheapest of the integrators, in one pass over the particles per step.
+ */
+template <typename T>
+struct SymplecticEuler
+{
+    static constexpr std::size_t STAGES = 1;  ///< Amount of force evaluations per step.
+
+    /**
+     * @brief   Returns true if the stage has work to do before the forces are evaluated.
+     */
+    static constexpr bool moves_before_forces(std::size_t stage) { return false; }
+
+    /**
+     * @brief   Prepares a particle for the evaluation of the forces of a stage.
+     */
+    template <std::size_t STAGE>
+    static void before_forces(const IntegratorArrays<T> &a, std::size_t i)
+    {
+    }
+
+    /**
+     * @brief   Consumes the forces evaluated in a stage for a particle.
+     */
+    template <std::size_t STAGE>
+    static void after_forces(const IntegratorArrays<T> &a, std::size_t i)
+    {
+        const T kick = inverse_mass(a.mass[i]) * a.time_step;
+
+        a.vx[i] += a.fx[i] * kick + a.uniform_ax * a.time_step;
+        a.vy[i] += a.fy[i] * kick + a.uniform_ay * a.time_step;
+        a.fx[i] = T(0);
+        a.fy[i] = T(0);
+        a.px[i] = a.x[i];
+        a.py[i] = a.y[i];
+        a.x[i] += a.vx[i] * a.time_step;
+        a.y[i] += a.vy[i] * a.time_step;
+    }
+};
+
+/**
+ * @class   VelocityVerlet
+ *
+ * @brief   Velocity Verlet integrator.
+ *
+ * @details
+ *
+ * Kicks the velocity by half of the acceleration of the last step, drifts the position with it,
+ * evaluates the forces at the new position and kicks the velocity by the other half of the new
+ * acceleration. Second order and symplectic, for the price of a single force evaluation per step,
+ * as the acceleration is kept for the next step.
+ *
+ * Freshly spawned particles have no acceleration of a last step, their first half kick is zero.
+ */
+template <typename T>
+struct VelocityVerlet
+{
+    static constexpr std::size_t STAGES = 1;  ///< Amount of force evaluations per step.
+
+    /**
+     * @brief   Returns true if the stage has work to do before the forces are evaluated.
+     */
+    static constexpr bool moves_before_forces(std::size_t stage) { return true; }
+
+    /**
+     * @brief   Prepares a particle for the evaluation of the forces of a stage.
+     */
+    template <std::size_t STAGE>
+    static void before_forces(const IntegratorArrays<T> &a, std::size_t i)
+    {
+        const T half_step = T(0.5) * a.time_step;
+
+        a.vx[i] += a.ax[i] * half_step;
+        a.vy[i] += a.ay[i] * half_step;
+        a.px[i] = a.x[i];
+        a.py[i] = a.y[i];
+        a.x[i] += a.vx[i] * a.time_step;
+        a.y[i] += a.vy[i] * a.time_step;
+    }
+
+    /**
+     * @brief   Consumes the forces evaluated in a stage for a particle.
+     */
+    template <std::size_t STAGE>
+    static void after_forces(const IntegratorArrays<T> &a, std::size_t i)
+    {
+        const T half_step = T(0.5) * a.time_step;
+        const T inverse = inverse_mass(a.mass[i]);
+
+        a.ax[i] = a.fx[i] * inverse + a.uniform_ax;
+        a.ay[i] = a.fy[i] * inverse + a.uniform_ay;
+        a.vx[i] += a.ax[i] * half_step;
+        a.vy[i] += a.ay[i] * half_step;
+        a.fx[i] = T(0);
+        a.fy[i] = T(0);
+    }
+};
+
+/**
+ * @class   RungeKutta4
+ *
+ * @brief   Classic fourth order Runge-Kutta integrator.
+ *
+ * @details
+ *
+ * Evaluates the slopes of the position and velocity at the start of the step, twice at its middle
+ * and at its end, and advances the particle by their weighted average. Fourth order, but not
+ * symplectic, and four force evaluations per step. Worth it where the forces change quickly, e.g.
+ * close to the gravity objects, as it keeps its accuracy at far larger steps.
+ *
+ * The forces applied to the particles before the step act in all four evaluations.
+ */
+template <typename T>
+struct RungeKutta4
+{
+    static constexpr std::size_t STAGES = 4;  ///< Amount of force evaluations per step.
+
+    /**
+     * @brief   Returns true if the stage has work to do before the forces are evaluated.
+     */
+    static constexpr bool moves_before_forces(std::size_t stage) { return stage == 0; }
+
+    /**
+     * @brief   Prepares a particle for the evaluation of the forces of a stage.
+     *
+     * @details
+     *
+     * The state at the start of the step is saved in the first stage, the later stages evaluate the
+     * forces where the previous stage has left the particle.
+     */
+    template <std::size_t STAGE>
+    static void before_forces(const IntegratorArrays<T> &a, std::size_t i)
+    {
+        a.px[i] = a.x[i];
+        a.py[i] = a.y[i];
+        a.start_vx[i] = a.vx[i];
+        a.start_vy[i] = a.vy[i];
+        a.external_fx[i] = a.fx[i];
+        a.external_fy[i] = a.fy[i];
+    }
+
+    /**
+     * @brief   Consumes the forces evaluated in a stage for a particle.
+     *
+     * @details
+     *
+     * Adds the slopes of the stage to the weighted sums and moves the particle to where the next
+     * stage evaluates the forces, the last stage moves it to the end of the step.
+     */
+    template <std::size_t STAGE>
+    static void after_forces(const IntegratorArrays<T> &a, std::size_t i)
+    {
+        // Weight of the slopes in the average and how far into the step the next evaluation is.
+        constexpr T WEIGHT = (STAGE == 0 || STAGE == 3) ? T(1) : T(2);
+        constexpr T NEXT = (STAGE == 2) ? T(1) : T(0.5);
+
+        const T inverse = inverse_mass(a.mass[i]);
+        const T slope_x = a.vx[i];
+        const T slope_y = a.vy[i];
+        const T slope_vx = a.fx[i] * inverse + a.uniform_ax;
+        const T slope_vy = a.fy[i] * inverse + a.uniform_ay;
+
+        if constexpr (STAGE == 0) {
+            a.slope_x[i] = slope_x;
+            a.slope_y[i] = slope_y;
+            a.slope_vx[i] = slope_vx;
+            a.slope_vy[i] = slope_vy;
+        }
+        else {
+            a.slope_x[i] += WEIGHT * slope_x;
+            a.slope_y[i] += WEIGHT * slope_y;
+            a.slope_vx[i] += WEIGHT * slope_vx;
+            a.slope_vy[i] += WEIGHT * slope_vy;
+        }
+
+        if constexpr (STAGE < 3) {
+            a.x[i] = a.px[i] + slope_x * (NEXT * a.time_step);
+            a.y[i] = a.py[i] + slope_y * (NEXT * a.time_step);
+            a.vx[i] = a.start_vx[i] + slope_vx * (NEXT * a.time_step);
+            a.vy[i] = a.start_vy[i] + slope_vy * (NEXT * a.time_step);
+            a.fx[i] = a.external_fx[i];
+            a.fy[i] = a.external_fy[i];
+        }
+        else {
+            const T sixth_step = a.time_step / T(6);
+
+            a.x[i] = a.px[i] + a.slope_x[i] * sixth_step;
+            a.y[i] = a.py[i] + a.slope_y[i] * sixth_step;
+            a.vx[i] = a.start_vx[i] + a.slope_vx[i] * sixth_step;
+            a.vy[i] = a.start_vy[i] + a.slope_vy[i] * sixth_step;
+            a.fx[i] = T(0);
+            a.fy[i] = T(0);
+        }
+    }
+};
@@ -0,0 +1,228 @@
+/**
+ * @file    job_system.cpp
+ * @author  Martin Cagas
+ *
+ * @brief   Thread pool running parallel loops over index ranges.
+ */
+
+#include "job_system.hpp"
+
+// Standard includes
+#include <algorithm>
+
+// "Game essentials" library includes
+#include <profiler.hpp>
+
+/**
+ * @brief   True on the threads currently running a loop body.
+ */
+static thread_local bool in_parallel_for = false;
+
+/**
+ * @brief   Resolves a requested thread count, 0 meaning one per hardware thread.
+ */
+static std::size_t resolve_thread_count(std::size_t thread_count)
+{
+    if (thread_count == 0) {
+        thread_count = std::thread::hardware_concurrency();
+    }
+    return (thread_count == 0) ? 1 : thread_count;
+}
+
+JobSystem::JobSystem(void) : JobSystem(0) {}
+
+JobSystem::JobSystem(std::size_t thread_count)
+    : thread_count_(0),
+      deterministic_(false),
+      generation_(0),
+      stopping_(false),
+      remaining_(0),
+      function_(nullptr),
+      context_(nullptr),
+      grain_size_(1),
+      split_(true)
+{
+    start(resolve_thread_count(thread_count));
+}
+
+JobSystem::~JobSystem(void) { stop(); }
+
+void JobSystem::set_thread_count(std::size_t thread_count)
+{
+    thread_count = resolve_thread_count(thread_count);
+
+    if (thread_count != thread_count_) {
+        stop();
+        start(thread_count);
+    }
+}
+
+std::size_t JobSystem::get_thread_count(void) const { return thread_count_; }
+
+void JobSystem::set_deterministic(bool deterministic) { deterministic_ = deterministic; }
+
+bool JobSystem::get_deterministic(void) const { return deterministic_; }
+
+void JobSystem::run(std::size_t begin, std::size_t end, std::size_t grain_size,
+                    RangeFunction function, void *context)
+{
+    if (begin >= end) {
+        return;
+    }
+
+    grain_size = (grain_size == 0) ? 1 : grain_size;
+    const std::size_t count = end - begin;
+
+    if (thread_count_ == 1 || count <= grain_size || in_parallel_for) {
+        function(context, begin, end);
+        return;
+    }
+
+    function_ = function;
+    context_ = context;
+    grain_size_ = grain_size;
+    split_ = !deterministic_;
+    remaining_.store(count, std::memory_order_relaxed);
+
+    // Hand every thread one contiguous chunk to start with, the rest is balanced by stealing.
+    const std::size_t chunk_count = std::min(thread_count_, (count + grain_size - 1) / grain_size);
+    for (std::size_t chunk = 0; chunk < chunk_count; chunk++) {
+        push(chunk, Range{begin + count * chunk / chunk_count,
+                          begin + count * (chunk + 1) / chunk_count});
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        generation_++;
+    }
+    wake_condition_.notify_all();
+
+    work(0);
+}
+
+void JobSystem::start(std::size_t thread_count)
+{
+    thread_count_ = thread_count;
+    queues_.reset(new WorkQueue[thread_count_]);
+    stopping_ = false;
+
+    workers_.reserve(thread_count_ - 1);
+    for (std::size_t i = 1; i < thread_count_; i++) {
+        workers_.emplace_back(&JobSystem::worker_main, this, i);
+    }
+}
+
+void JobSystem::stop(void)
+{
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stopping_ = true;
+    }
+    wake_condition_.notify_all();
+
+    for (std::thread &worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+}
+
+void JobSystem::worker_main(std::size_t queue_index)
+{
+    std::size_t seen_generation = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            wake_condition_.wait(
+                lock, [&] { return stopping_ || generation_ != seen_generation; });
+
+            if (stopping_) {
+                return;
+            }
+            seen_generation = generation_;
+        }
+
+        work(queue_index);
+    }
+}
+
+void JobSystem::work(std::size_t queue_index)
+{
+    Range range;
+
+    // The release decrements of remaining_ make the whole loop's writes visible to the caller.
+    while (remaining_.load(std::memory_order_acquire) != 0) {
+        if (pop(queue_index, range) || steal(queue_index, range)) {
+            execute(queue_index, range);
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::execute(std::size_t queue_index, Range range)
+{
+    // Keep the first half and offer the second one to the thieves, until the grain size is hit.
+    if (split_) {
+        while (range.end - range.begin > grain_size_) {
+            std::size_t middle = range.begin + (range.end - range.begin) / 2;
+            if (!push(queue_index, Range{middle, range.end})) {
+                break;
+            }
+            range.end = middle;
+        }
+    }
+
+    in_parallel_for = true;
+    {
+        ESSENTIALS_PROFILE_SCOPE("job");
+        function_(context_, range.begin, range.end);
+    }
+    in_parallel_for = false;
+
+    remaining_.fetch_sub(range.end - range.begin, std::memory_order_acq_rel);
+}
+
+bool JobSystem::push(std::size_t queue_index, Range range)
+{
+    WorkQueue &queue = queues_[queue_index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (queue.bottom - queue.top == WorkQueue::CAPACITY) {
+        return false;
+    }
+
+    queue.ranges[queue.bottom % WorkQueue::CAPACITY] = range;
+    queue.bottom++;
+    return true;
+}
+
+bool JobSystem::pop(std::size_t queue_index, Range &range)
+{
+    WorkQueue &queue = queues_[queue_index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (queue.bottom == queue.top) {
+        return false;
+    }
+
+    queue.bottom--;
+    range = queue.ranges[queue.bottom % WorkQueue::CAPACITY];
+    return true;
+}
+
+bool JobSystem::steal(std::size_t queue_index, Range &range)
+{
+    for (std::size_t i = 1; i < thread_count_; i++) {
+        WorkQueue &queue = queues_[(queue_index + i) % thread_count_];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (queue.bottom != queue.top) {
+            range = queue.ranges[queue.top % WorkQueue::CAPACITY];
+            queue.top++;
+            return true;
+        }
+    }
+    return false;
+}
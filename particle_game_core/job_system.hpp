@@ -0,0 +1,245 @@
+/**
+ * @file    job_system.hpp
+ * @author  Martin Cagas
+ *
+ * @brief   Thread pool running parallel loops over index ranges.
+ */
+
+#pragma once
+
+// Standard includes
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @class   JobSystem
+ *
+ * @brief   Thread pool running parallel loops over index ranges.
+ *
+ * @section DESCRIPTION
+ *
+ * The job system keeps a fixed set of worker threads and splits loops over index ranges between
+ * them. The thread calling parallel_for() takes part in the work as well, so a job system with a
+ * thread count of N runs N - 1 workers and a thread count of 1 runs everything on the caller.
+ *
+ * Every thread owns a work-stealing deque of subranges. A thread takes work from the bottom of its
+ * own deque, splitting large subranges in half and pushing the halves back until they are no larger
+ * than the grain size. Threads that run out of work steal from the top of the other deques, where
+ * the largest subranges are. Workers sleep while there is no loop to run.
+ *
+ * Which thread runs which part of the range, and how the range gets split, depends on the timing of
+ * the threads. In the deterministic mode the range is instead cut into exactly one chunk per thread
+ * up front and the chunks are never split any further, so the boundaries of the subranges passed to
+ * the loop body only depend on the range, the grain size and the thread count. Loop bodies
+ * producing one partial result per subrange then give the same results on every run.
+ *
+ * Running a loop does not allocate memory. Loops are started from one thread at a time, loops
+ * started from within a loop body run serially on the calling thread.
+ *
+ * @section USAGE
+ *
+ * @code
+ *
+ * JobSystem jobs(4);
+ *
+ * jobs.parallel_for(0, count, 1024, [&](std::size_t begin, std::size_t end) {
+ *     for (std::size_t i = begin; i < end; i++) {
+ *         x[i] += vx[i];
+ *     }
+ * });
+ *
+ * @endcode
+ */
+class JobSystem
+{
+public:
+    /**
+     * @brief   Constructor.
+     *
+     * @details
+     *
+     * Uses one thread per hardware thread of the machine.
+     */
+    JobSystem(void);
+
+    /**
+     * @brief   Constructor.
+     *
+     * @param   thread_count    Amount of threads including the calling one, 0 for one per hardware
+     *                          thread.
+     */
+    JobSystem(std::size_t thread_count);
+
+    /**
+     * @brief   Destructor.
+     *
+     * @details
+     *
+     * Stops and joins all the workers.
+     */
+    ~JobSystem(void);
+
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    /**
+     * @brief   Changes the amount of threads, restarting all the workers.
+     *
+     * @details
+     *
+     * Must not be called while a loop is running.
+     *
+     * @param   thread_count    Amount of threads including the calling one, 0 for one per hardware
+     *                          thread.
+     */
+    void set_thread_count(std::size_t thread_count);
+
+    /**
+     * @brief   Returns the amount of threads including the calling one.
+     */
+    std::size_t get_thread_count(void) const;
+
+    /**
+     * @brief   deterministic_ setter.
+     *
+     * @param   deterministic   True to split the ranges independently of the timing of the threads.
+     */
+    void set_deterministic(bool deterministic);
+
+    /**
+     * @brief   deterministic_ getter.
+     */
+    bool get_deterministic(void) const;
+
+    /**
+     * @brief   Runs a loop body over the range [begin, end) on all the threads.
+     *
+     * @details
+     *
+     * The body is called with disjoint subranges covering the whole range, possibly concurrently.
+     * Returns once all the subranges are done.
+     *
+     * @param   begin           First index of the range.
+     * @param   end             Index one past the last index of the range.
+     * @param   grain_size      Size below which subranges are not split any further.
+     * @param   &&function      Loop body, callable as function(begin, end).
+     */
+    template <typename Function>
+    void parallel_for(std::size_t begin, std::size_t end, std::size_t grain_size,
+                      Function &&function)
+    {
+        typedef typename std::remove_reference<Function>::type Body;
+
+        run(begin, end, grain_size,
+            [](void *context, std::size_t range_begin, std::size_t range_end) {
+                (*static_cast<Body *>(context))(range_begin, range_end);
+            },
+            const_cast<void *>(static_cast<const void *>(&function)));
+    }
+
+protected:
+    /**
+     * @brief   Type-erased loop body.
+     */
+    typedef void (*RangeFunction)(void *context, std::size_t begin, std::size_t end);
+
+    /**
+     * @brief   A subrange of the loop.
+     */
+    struct Range
+    {
+        std::size_t begin;  ///< First index of the subrange.
+        std::size_t end;    ///< Index one past the last index of the subrange.
+    };
+
+    /**
+     * @brief   Work-stealing deque of a single thread.
+     *
+     * @details
+     *
+     * The owner pushes and pops at the bottom, thieves steal from the top. Splitting in halves
+     * keeps at most one subrange per level of splitting in the deque, so a fixed capacity suffices.
+     */
+    struct WorkQueue
+    {
+        static constexpr std::size_t CAPACITY = 128;  ///< Maximum amount of queued subranges.
+
+        std::mutex mutex;        ///< Protects the whole deque.
+        Range ranges[CAPACITY];  ///< Ring buffer of the subranges.
+        std::size_t top = 0;     ///< Index of the oldest subrange.
+        std::size_t bottom = 0;  ///< Index one past the newest subrange.
+    };
+
+    /**
+     * @brief   Runs a type-erased loop body, see parallel_for().
+     */
+    void run(std::size_t begin, std::size_t end, std::size_t grain_size, RangeFunction function,
+             void *context);
+
+    /**
+     * @brief   Starts the workers.
+     */
+    void start(std::size_t thread_count);
+
+    /**
+     * @brief   Stops and joins the workers.
+     */
+    void stop(void);
+
+    /**
+     * @brief   Main loop of a worker thread.
+     *
+     * @param   queue_index     Index of the worker's own deque.
+     */
+    void worker_main(std::size_t queue_index);
+
+    /**
+     * @brief   Runs subranges until the whole range of the current loop is done.
+     *
+     * @param   queue_index     Index of the calling thread's own deque.
+     */
+    void work(std::size_t queue_index);
+
+    /**
+     * @brief   Runs a single subrange, splitting it first unless in the deterministic mode.
+     *
+     * @param   queue_index     Index of the calling thread's own deque.
+     * @param   range           The subrange.
+     */
+    void execute(std::size_t queue_index, Range range);
+
+    /**
+     * @brief   Pushes a subrange to the bottom of a deque.
+     */
+    bool push(std::size_t queue_index, Range range);
+
+    /**
+     * @brief   Pops a subrange from the bottom of a deque.
+     */
+    bool pop(std::size_t queue_index, Range &range);
+
+    /**
+     * @brief   Steals a subrange from the top of any deque other than the given one.
+     */
+    bool steal(std::size_t queue_index, Range &range);
+
+    std::size_t thread_count_;                ///< Amount of threads including the caller.
+    bool deterministic_;                      ///< True to split ranges into fixed chunks.
+    std::vector<std::thread> workers_;        ///< Worker threads, one fewer than thread_count_.
+    std::unique_ptr<WorkQueue[]> queues_;     ///< One deque per thread, the caller's first.
+    std::mutex wake_mutex_;                   ///< Protects the fields below and wake_condition_.
+    std::condition_variable wake_condition_;  ///< Wakes the workers when a loop starts.
+    std::size_t generation_;                  ///< Incremented with every started loop.
+    bool stopping_;                           ///< True while the workers are being stopped.
+    std::atomic<std::size_t> remaining_;      ///< Amount of indices not yet run.
+    RangeFunction function_;                  ///< Loop body of the current loop.
+    void *context_;                           ///< Context of the loop body.
+    std::size_t grain_size_;                  ///< Grain size of the current loop.
+    bool split_;                              ///< True if the current loop may split subranges.
+};
@@ -0,0 +1,327 @@
+/**
+ * @file    obstacle_set.cpp
+ * @author  Martin Cagas
+ *
+ * @brief   Static obstacles keeping the particles out, stored in flat arrays.
+ */
+
+#include "obstacle_set.hpp"
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+using namespace essentials;
+
+/**
+ * @brief   Amount of particles resolved at a time, each tile is bounded by a box of its own.
+ */
+static constexpr std::size_t OBSTACLE_TILE_SIZE = 256;
+
+/**
+ * @brief   Pushes a particle out of an obstacle and reflects its velocity towards the obstacle.
+ *
+ * @details
+ *
+ * A zero penetration leaves the particle as it is. The contact is selected rather than branched
+ * to, so the loops calling this vectorise.
+ *
+ * @param   bounce      One plus the restitution.
+ */
+template <typename T>
+static inline void push_out(T &x, T &y, T &vx, T &vy, T normal_x, T normal_y, T penetration,
+                            T bounce)
+{
+    x += normal_x * penetration;
+    y += normal_y * penetration;
+
+    const T approach = vx * normal_x + vy * normal_y;
+    const T kick = (penetration > T(0) && approach < T(0)) ? -bounce * approach : T(0);
+    vx += normal_x * kick;
+    vy += normal_y * kick;
+}
+
+/**
+ * @brief   Replaces the contents of an array with an array of a snapshot.
+ */
+template <typename T>
+static void load_array(SnapshotReader &reader, std::vector<T> &array, std::size_t count)
+{
+    const T *data = reader.read_array<T>(count);
+    array.assign(data, data + count);
+}
+
+template <typename T>
+void BasicObstacleSet<T>::add_line(BasicVector2D<T> point, BasicVector2D<T> normal)
+{
+    normal = normal.normalized();
+    line_x_.push_back(point.x);
+    line_y_.push_back(point.y);
+    line_normal_x_.push_back(normal.x);
+    line_normal_y_.push_back(normal.y);
+}
+
+template <typename T>
+void BasicObstacleSet<T>::add_segment(BasicVector2D<T> start, BasicVector2D<T> end, T thickness)
+{
+    segment_x_.push_back(start.x);
+    segment_y_.push_back(start.y);
+    segment_dx_.push_back(end.x - start.x);
+    segment_dy_.push_back(end.y - start.y);
+    segment_thickness_.push_back(thickness);
+}
+
+template <typename T>
+void BasicObstacleSet<T>::add_circle(BasicVector2D<T> center, T radius)
+{
+    circle_x_.push_back(center.x);
+    circle_y_.push_back(center.y);
+    circle_radius_.push_back(radius);
+}
+
+template <typename T>
+void BasicObstacleSet<T>::clear(void)
+{
+    line_x_.clear();
+    line_y_.clear();
+    line_normal_x_.clear();
+    line_normal_y_.clear();
+    segment_x_.clear();
+    segment_y_.clear();
+    segment_dx_.clear();
+    segment_dy_.clear();
+    segment_thickness_.clear();
+    circle_x_.clear();
+    circle_y_.clear();
+    circle_radius_.clear();
+}
+
+template <typename T>
+bool BasicObstacleSet<T>::is_empty(void) const
+{
+    return line_x_.empty() && segment_x_.empty() && circle_x_.empty();
+}
+
+template <typename T>
+std::size_t BasicObstacleSet<T>::get_line_count(void) const { return line_x_.size(); }
+
+template <typename T>
+std::size_t BasicObstacleSet<T>::get_segment_count(void) const { return segment_x_.size(); }
+
+template <typename T>
+std::size_t BasicObstacleSet<T>::get_circle_count(void) const { return circle_x_.size(); }
+
+template <typename T>
+void BasicObstacleSet<T>::resolve(const ParticleArrays &arrays, std::size_t first,
+                                  std::size_t last, T restitution) const
+{
+    if (is_empty()) {
+        return;
+    }
+
+    for (std::size_t tile = first; tile < last; tile += OBSTACLE_TILE_SIZE) {
+        resolve_tile(arrays, tile, std::min(tile + OBSTACLE_TILE_SIZE, last), T(1) + restitution);
+    }
+}
+
+template <typename T>
+void BasicObstacleSet<T>::resolve_tile(const ParticleArrays &arrays, std::size_t first,
+                                       std::size_t last, T bounce) const
+{
+    const std::size_t count = last - first;
+    const T *px = arrays.px + first;
+    const T *py = arrays.py + first;
+    const T *radius = arrays.radius + first;
+
+    // The box covers the paths of the particles since their previous positions, which the
+    // segments test for crossings.
+    BasicVector2D<T> min(arrays.x[first], arrays.y[first]);
+    BasicVector2D<T> max = min;
+    T max_radius = T(0);
+    for (std::size_t i = first; i < last; i++) {
+        min.x = std::min(min.x, std::min(arrays.x[i], arrays.px[i]));
+        min.y = std::min(min.y, std::min(arrays.y[i], arrays.py[i]));
+        max.x = std::max(max.x, std::max(arrays.x[i], arrays.px[i]));
+        max.y = std::max(max.y, std::max(arrays.y[i], arrays.py[i]));
+        max_radius = std::max(max_radius, arrays.radius[i]);
+    }
+
+    // The obstacles work on local copies of the positions and velocities, which nothing else can
+    // alias, so the compiler vectorises the loops without checking the arrays for overlaps. The
+    // copies are only made once an obstacle reaches into the box.
+    T x[OBSTACLE_TILE_SIZE];
+    T y[OBSTACLE_TILE_SIZE];
+    T vx[OBSTACLE_TILE_SIZE];
+    T vy[OBSTACLE_TILE_SIZE];
+    bool is_copied = false;
+    auto copy_in = [&]() {
+        if (!is_copied) {
+            std::copy(arrays.x + first, arrays.x + last, x);
+            std::copy(arrays.y + first, arrays.y + last, y);
+            std::copy(arrays.vx + first, arrays.vx + last, vx);
+            std::copy(arrays.vy + first, arrays.vy + last, vy);
+            is_copied = true;
+        }
+    };
+
+    for (std::size_t k = 0; k < line_x_.size(); k++) {
+        const T line_x = line_x_[k];
+        const T line_y = line_y_[k];
+        const T normal_x = line_normal_x_[k];
+        const T normal_y = line_normal_y_[k];
+
+        // The corner of the box deepest behind the line decides whether any particle can touch it.
+        const T corner_x = normal_x >= T(0) ? min.x : max.x;
+        const T corner_y = normal_y >= T(0) ? min.y : max.y;
+        if ((corner_x - line_x) * normal_x + (corner_y - line_y) * normal_y >= max_radius) {
+            continue;
+        }
+
+        copy_in();
+        for (std::size_t i = 0; i < count; i++) {
+            const T distance =
+                (x[i] - line_x) * normal_x + (y[i] - line_y) * normal_y - radius[i];
+            push_out(x[i], y[i], vx[i], vy[i], normal_x, normal_y, std::max(-distance, T(0)),
+                     bounce);
+        }
+    }
+
+    for (std::size_t k = 0; k < segment_x_.size(); k++) {
+        const T start_x = segment_x_[k];
+        const T start_y = segment_y_[k];
+        const T dx = segment_dx_[k];
+        const T dy = segment_dy_[k];
+        const T thickness = segment_thickness_[k];
+
+        const T reach = thickness + max_radius;
+        if (max.x < std::min(start_x, start_x + dx) - reach ||
+            min.x > std::max(start_x, start_x + dx) + reach ||
+            max.y < std::min(start_y, start_y + dy) - reach ||
+            min.y > std::max(start_y, start_y + dy) + reach) {
+            continue;
+        }
+
+        // The side normal points to the left of the segment, a segment of zero length is a circle.
+        const T length_squared = dx * dx + dy * dy;
+        const T length = std::sqrt(length_squared);
+        const T inverse_length_squared = length_squared > T(0) ? T(1) / length_squared : T(0);
+        const T side_x = length > T(0) ? -dy / length : T(1);
+        const T side_y = length > T(0) ? dx / length : T(0);
+        const T crossable = length > T(0) ? T(1) : T(0);
+
+        copy_in();
+        for (std::size_t i = 0; i < count; i++) {
+            // A particle whose path crossed the segment is reflected back across its line.
+            const T before = (px[i] - start_x) * side_x + (py[i] - start_y) * side_y;
+            const T after = (x[i] - start_x) * side_x + (y[i] - start_y) * side_y;
+            const T denominator = before - after;
+            const T share = before / (denominator != T(0) ? denominator : T(1));
+            const T crossing_x = px[i] + (x[i] - px[i]) * share - start_x;
+            const T crossing_y = py[i] + (y[i] - py[i]) * share - start_y;
+            const T along = (crossing_x * dx + crossing_y * dy) * inverse_length_squared;
+            const bool is_crossing = before * after < T(0) && along >= T(0) && along <= T(1);
+            const T crossed = is_crossing ? crossable : T(0);
+            const T back = -bounce * after * crossed;
+            const T approach = vx[i] * side_x + vy[i] * side_y;
+            const T kick = approach * before < T(0) ? -bounce * approach * crossed : T(0);
+            x[i] += side_x * back;
+            y[i] += side_y * back;
+            vx[i] += side_x * kick;
+            vy[i] += side_y * kick;
+
+            // Particles right on the segment are pushed out to the side they came from.
+            const T offset_x = x[i] - start_x;
+            const T offset_y = y[i] - start_y;
+            const T t = std::min(
+                std::max((offset_x * dx + offset_y * dy) * inverse_length_squared, T(0)), T(1));
+            const T closest_x = offset_x - t * dx;
+            const T closest_y = offset_y - t * dy;
+            const T distance = std::sqrt(closest_x * closest_x + closest_y * closest_y);
+            const T inverse_distance = T(1) / (distance > T(0) ? distance : T(1));
+            const T side = before < T(0) ? T(-1) : T(1);
+            const T normal_x = distance > T(0) ? closest_x * inverse_distance : side_x * side;
+            const T normal_y = distance > T(0) ? closest_y * inverse_distance : side_y * side;
+            push_out(x[i], y[i], vx[i], vy[i], normal_x, normal_y,
+                     std::max(thickness + radius[i] - distance, T(0)), bounce);
+        }
+    }
+
+    for (std::size_t k = 0; k < circle_x_.size(); k++) {
+        const T center_x = circle_x_[k];
+        const T center_y = circle_y_[k];
+        const T circle_radius = circle_radius_[k];
+
+        const T reach = circle_radius + max_radius;
+        if (max.x < center_x - reach || min.x > center_x + reach || max.y < center_y - reach ||
+            min.y > center_y + reach) {
+            continue;
+        }
+
+        copy_in();
+        for (std::size_t i = 0; i < count; i++) {
+            // Particles right at the center are pushed out along the x axis.
+            const T offset_x = x[i] - center_x;
+            const T offset_y = y[i] - center_y;
+            const T distance = std::sqrt(offset_x * offset_x + offset_y * offset_y);
+            const T inverse_distance = T(1) / (distance > T(0) ? distance : T(1));
+            const T normal_x = distance > T(0) ? offset_x * inverse_distance : T(1);
+            const T normal_y = offset_y * inverse_distance;
+            push_out(x[i], y[i], vx[i], vy[i], normal_x, normal_y,
+                     std::max(circle_radius + radius[i] - distance, T(0)), bounce);
+        }
+    }
+
+    if (is_copied) {
+        std::copy(x, x + count, arrays.x + first);
+        std::copy(y, y + count, arrays.y + first);
+        std::copy(vx, vx + count, arrays.vx + first);
+        std::copy(vy, vy + count, arrays.vy + first);
+    }
+}
+
+template <typename T>
+void BasicObstacleSet<T>::save(SnapshotWriter &writer) const
+{
+    writer.write_value(static_cast<std::uint64_t>(line_x_.size()));
+    writer.write_value(static_cast<std::uint64_t>(segment_x_.size()));
+    writer.write_value(static_cast<std::uint64_t>(circle_x_.size()));
+
+    writer.write_array(line_x_.data(), line_x_.size());
+    writer.write_array(line_y_.data(), line_y_.size());
+    writer.write_array(line_normal_x_.data(), line_normal_x_.size());
+    writer.write_array(line_normal_y_.data(), line_normal_y_.size());
+    writer.write_array(segment_x_.data(), segment_x_.size());
+    writer.write_array(segment_y_.data(), segment_y_.size());
+    writer.write_array(segment_dx_.data(), segment_dx_.size());
+    writer.write_array(segment_dy_.data(), segment_dy_.size());
+    writer.write_array(segment_thickness_.data(), segment_thickness_.size());
+    writer.write_array(circle_x_.data(), circle_x_.size());
+    writer.write_array(circle_y_.data(), circle_y_.size());
+    writer.write_array(circle_radius_.data(), circle_radius_.size());
+}
+
+template <typename T>
+void BasicObstacleSet<T>::load(SnapshotReader &reader)
+{
+    const std::uint64_t line_count = reader.read_value<std::uint64_t>();
+    const std::uint64_t segment_count = reader.read_value<std::uint64_t>();
+    const std::uint64_t circle_count = reader.read_value<std::uint64_t>();
+
+    load_array(reader, line_x_, line_count);
+    load_array(reader, line_y_, line_count);
+    load_array(reader, line_normal_x_, line_count);
+    load_array(reader, line_normal_y_, line_count);
+    load_array(reader, segment_x_, segment_count);
+    load_array(reader, segment_y_, segment_count);
+    load_array(reader, segment_dx_, segment_count);
+    load_array(reader, segment_dy_, segment_count);
+    load_array(reader, segment_thickness_, segment_count);
+    load_array(reader, circle_x_, circle_count);
+    load_array(reader, circle_y_, circle_count);
+    load_array(reader, circle_radius_, circle_count);
+}
+
+// Explicitly instantiate all the supported precisions
+template class BasicObstacleSet<float>;
+template class BasicObstacleSet<double>;
@@ -0,0 +1,195 @@
+/**
+ * @file    obstacle_set.hpp
+ * @author  Martin Cagas
+ *
+ * @brief   Static obstacles keeping the particles out, stored in flat arrays.
+ */
+
+#pragma once
+
+// Standard includes
+#include <cstdlib>
+#include <vector>
+
+// "Game essentials" library includes
+#include <vector2d.hpp>
+
+// Local includes
+#include "snapshot.hpp"
+
+/**
+ * @class   BasicObstacleSet
+ *
+ * @brief   Static obstacles keeping the particles out, stored in flat arrays.
+ *
+ * @section DESCRIPTION
+ *
+ * The set holds three kinds of static obstacles, each kind in a structure of arrays of its own:
+ * - lines, solid half-planes bounded by an infinite line, e.g. a floor,
+ * - segments, capsules of a thickness around a line segment, e.g. walls and platforms,
+ * - circles, solid discs.
+ *
+ * Particles are resolved against the obstacles a small tile at a time, obstacle by obstacle. The
+ * inner loop over the particles has no branches, the contacts are selected rather than branched
+ * to, and works on local copies of the tile, so the compiler vectorises it. Every tile is bounded
+ * with a box first and the obstacles that cannot reach into the box skip the tile altogether, so
+ * a tile costs little more than its bounding box unless it actually meets an obstacle.
+ *
+ * A particle touching an obstacle with its radius is pushed out along the normal of the obstacle
+ * and its velocity towards the obstacle is reflected, scaled by the restitution. Particles are
+ * pushed out of the lines and the circles wherever they are, a particle fast enough to cross a
+ * circle within one step passes through it. Particles that crossed a segment since their previous
+ * positions are reflected back to the side they came from, so not even particles with a zero
+ * radius tunnel through thin segments.
+ *
+ * ObstacleSet works in double precision and ObstacleSetF in single precision.
+ *
+ * @section USAGE
+ *
+ * @code
+ *
+ * ObstacleSetF obstacles;
+ *
+ * obstacles.add_line(Point2DF(0.0f, -100.0f), Vector2DF(0.0f, 1.0f));
+ * obstacles.add_segment(Point2DF(-50.0f, 0.0f), Point2DF(50.0f, 10.0f), 2.0f);
+ * obstacles.add_circle(Point2DF(0.0f, 50.0f), 20.0f);
+ *
+ * obstacles.resolve(arrays, 0, count, 0.8f);
+ *
+ * @endcode
+ */
+template <typename T>
+class BasicObstacleSet
+{
+public:
+    /**
+     * @brief   Arrays of the particles resolved against the obstacles.
+     */
+    struct ParticleArrays
+    {
+        T *x;             ///< X components of the positions.
+        T *y;             ///< Y components of the positions.
+        const T *px;      ///< X components of the previous positions.
+        const T *py;      ///< Y components of the previous positions.
+        T *vx;            ///< X components of the velocities.
+        T *vy;            ///< Y components of the velocities.
+        const T *radius;  ///< Radii of the particles.
+    };
+
+    /**
+     * @brief   Adds a line, the half-plane behind it is solid.
+     *
+     * @param   point       Any point of the line.
+     * @param   normal      Direction the free side lies in, normalised by the set, not zero.
+     */
+    void add_line(essentials::BasicVector2D<T> point, essentials::BasicVector2D<T> normal);
+
+    /**
+     * @brief   Adds a segment.
+     *
+     * @param   start       First end point.
+     * @param   end         Second end point.
+     * @param   thickness   Distance up to which the segment keeps the particles away.
+     */
+    void add_segment(essentials::BasicVector2D<T> start, essentials::BasicVector2D<T> end,
+                     T thickness = T(0));
+
+    /**
+     * @brief   Adds a circle.
+     *
+     * @param   center      Center of the circle.
+     * @param   radius      Radius of the circle.
+     */
+    void add_circle(essentials::BasicVector2D<T> center, T radius);
+
+    /**
+     * @brief   Removes all the obstacles.
+     */
+    void clear(void);
+
+    /**
+     * @brief   Returns true if the set holds no obstacles, false otherwise.
+     */
+    bool is_empty(void) const;
+
+    /**
+     * @brief   Returns the amount of lines.
+     */
+    std::size_t get_line_count(void) const;
+
+    /**
+     * @brief   Returns the amount of segments.
+     */
+    std::size_t get_segment_count(void) const;
+
+    /**
+     * @brief   Returns the amount of circles.
+     */
+    std::size_t get_circle_count(void) const;
+
+    /**
+     * @brief   Pushes the particles of a range out of the obstacles and bounces them off.
+     *
+     * @param   &arrays         Arrays of the particles.
+     * @param   first           Index of the first particle.
+     * @param   last            Index one past the last particle.
+     * @param   restitution     Share of the speed towards an obstacle kept by a bounce, 1.0 for
+     *                          elastic and 0.0 for perfectly inelastic bounces.
+     */
+    void resolve(const ParticleArrays &arrays, std::size_t first, std::size_t last,
+                 T restitution) const;
+
+    /**
+     * @brief   Writes all the obstacles into a snapshot.
+     *
+     * @param   &writer     Writer of the snapshot.
+     *
+     * @throws  std::runtime_error if the snapshot cannot be written.
+     */
+    void save(SnapshotWriter &writer) const;
+
+    /**
+     * @brief   Replaces all the obstacles with the ones of a snapshot written by save().
+     *
+     * @details
+     *
+     * On failure, the set is left in an unspecified state, load into a fresh set and swap it in.
+     *
+     * @param   &reader     Reader of the snapshot.
+     *
+     * @throws  std::runtime_error if the snapshot is malformed.
+     */
+    void load(SnapshotReader &reader);
+
+protected:
+    /**
+     * @brief   Resolves a single tile of particles, see resolve().
+     *
+     * @param   bounce      One plus the restitution.
+     */
+    void resolve_tile(const ParticleArrays &arrays, std::size_t first, std::size_t last,
+                      T bounce) const;
+
+    std::vector<T> line_x_;             ///< X components of the points of the lines.
+    std::vector<T> line_y_;             ///< Y components of the points of the lines.
+    std::vector<T> line_normal_x_;      ///< X components of the normals of the lines.
+    std::vector<T> line_normal_y_;      ///< Y components of the normals of the lines.
+    std::vector<T> segment_x_;          ///< X components of the start points of the segments.
+    std::vector<T> segment_y_;          ///< Y components of the start points of the segments.
+    std::vector<T> segment_dx_;         ///< X components of the segments from start to end.
+    std::vector<T> segment_dy_;         ///< Y components of the segments from start to end.
+    std::vector<T> segment_thickness_;  ///< Thicknesses of the segments.
+    std::vector<T> circle_x_;           ///< X components of the centers of the circles.
+    std::vector<T> circle_y_;           ///< Y components of the centers of the circles.
+    std::vector<T> circle_radius_;      ///< Radii of the circles.
+};
+
+/**
+ * @brief   Double precision obstacle set.
+ */
+typedef BasicObstacleSet<double> ObstacleSet;
+
+/**
+ * @brief   Single precision obstacle set.
+ */
+typedef BasicObstacleSet<float> ObstacleSetF;
@@ -9,12 +9,19 @@
 
 using namespace essentials;
 
-Particle::Particle(void) : PhysicsObject() {}
+template <typename T>
+BasicParticle<T>::BasicParticle(void) : BasicPhysicsObject<T>() {}
 
-void Particle::setup(Point2D position, Vector2D velocity)
+template <typename T>
+void BasicParticle<T>::setup(BasicVector2D<T> position, BasicVector2D<T> velocity)
 {
-    position_ = position;
-    velocity_ = velocity;
+    this->position_ = position;
+    this->velocity_ = velocity;
 }
 
-void Particle::draw(void) const {}
+template <typename T>
+void BasicParticle<T>::draw(void) const {}
+
+// Explicitly instantiate all the supported precisions
+template class BasicParticle<float>;
+template class BasicParticle<double>;
@@ -21,7 +21,7 @@
 #include "physics_object.hpp"
 
 /**
- * @class   Particle
+ * @class   BasicParticle
  *
  * @brief   Class representing a particle in the game world.
  *
@@ -31,28 +31,31 @@
  * - Define the particle's type and features
  * - Implement a way of drawing said particle
  *
+ * Particle uses double precision and ParticleF single precision.
+ *
  * @section USAGE
  *
  * @code
  *
  * @endcode
  */
-class Particle : public PhysicsObject
+template <typename T>
+class BasicParticle : public BasicPhysicsObject<T>
 {
 public:
     /**
      * @brief   Contructor.
      *
-     * There is no reason to attempt to initialise anything in the contructor for now, because this
-     * object will be pooled. That means creating a large amount of instances ahead of the time and
-     * reusing them as needed.
+     * There is no reason to attempt to initialise anything in the contructor for now. The particles
+     * of the game world are not Particle instances, they live in the World's ParticlePool and are
+     * accessed through ParticleView.
      */
-    Particle(void);
+    BasicParticle(void);
 
     /**
      * @brief   Sets a new state to the particle.
      */
-    void setup(essentials::Point2D position, essentials::Vector2D velocity);
+    void setup(essentials::BasicVector2D<T> position, essentials::BasicVector2D<T> velocity);
 
     /**
      * @brief   Draws the particle on screen.
@@ -61,3 +64,13 @@ public:
 
 private:
 };
+
+/**
+ * @brief   Double precision particle.
+ */
+typedef BasicParticle<double> Particle;
+
+/**
+ * @brief   Single precision particle.
+ */
+typedef BasicParticle<float> ParticleF;
@@ -0,0 +1,255 @@
+/**
+ * @file    particle_pool.cpp
+ * @author  Martin Cagas
+ *
+ * @brief   Fixed-capacity pool of particles with constant-time spawning and killing.
+ */
+
+#include "particle_pool.hpp"
+
+// Standard includes
+#include <algorithm>
+#include <limits>
+
+template <typename T>
+BasicParticlePool<T>::BasicParticlePool(void) : size_(0) {}
+
+template <typename T>
+BasicParticlePool<T>::BasicParticlePool(std::size_t capacity) : size_(0) { set_capacity(capacity); }
+
+template <typename T>
+void BasicParticlePool<T>::set_capacity(std::size_t capacity)
+{
+    const std::size_t old_capacity = get_capacity();
+
+    if (capacity < old_capacity) {
+        clear();
+        slot_ids_.resize(capacity);
+        id_slots_.resize(capacity);
+        generations_.resize(capacity);
+
+        // Identifiers above the new capacity are gone, renumber the free list from scratch.
+        for (std::size_t i = 0; i < capacity; i++) {
+            slot_ids_[i] = static_cast<std::uint32_t>(i);
+            id_slots_[i] = static_cast<std::uint32_t>(i);
+        }
+    }
+    else {
+        slot_ids_.resize(capacity);
+        id_slots_.resize(capacity);
+        generations_.resize(capacity, 0);
+
+        for (std::size_t i = old_capacity; i < capacity; i++) {
+            slot_ids_[i] = static_cast<std::uint32_t>(i);
+            id_slots_[i] = static_cast<std::uint32_t>(i);
+        }
+    }
+
+    dead_ids_.reserve(capacity);
+    store_.set_capacity(capacity);
+}
+
+template <typename T>
+std::size_t BasicParticlePool<T>::get_capacity(void) const { return slot_ids_.size(); }
+
+template <typename T>
+std::size_t BasicParticlePool<T>::get_size(void) const { return size_; }
+
+template <typename T>
+bool BasicParticlePool<T>::is_full(void) const { return size_ == slot_ids_.size(); }
+
+template <typename T>
+bool BasicParticlePool<T>::spawn(ParticleHandle &handle)
+{
+    if (is_full()) {
+        return false;
+    }
+
+    const std::size_t index = size_++;
+    const std::uint32_t id = slot_ids_[index];
+
+    store_.clear_slot(index);
+    store_.alive[index] = 1;
+
+    handle.id = id;
+    handle.generation = generations_[id];
+    return true;
+}
+
+template <typename T>
+std::size_t BasicParticlePool<T>::spawn_batch(std::size_t count)
+{
+    // The free identifiers already wait behind the live ones, spawning only takes them over.
+    const std::size_t first = size_;
+    count = std::min(count, get_capacity() - size_);
+    size_ += count;
+
+    for (std::size_t index = first; index < size_; index++) {
+        store_.clear_slot(index);
+        store_.alive[index] = 1;
+    }
+
+    return count;
+}
+
+template <typename T>
+bool BasicParticlePool<T>::kill(ParticleHandle handle)
+{
+    if (!is_valid(handle)) {
+        return false;
+    }
+
+    kill_at(id_slots_[handle.id]);
+    return true;
+}
+
+template <typename T>
+void BasicParticlePool<T>::kill_at(std::size_t index)
+{
+    const std::size_t last = --size_;
+    const std::uint32_t id = slot_ids_[index];
+    const std::uint32_t last_id = slot_ids_[last];
+
+    // Move the last live particle into the hole and park the dead identifier right behind it.
+    if (index != last) {
+        store_.move_slot(last, index);
+    }
+    store_.clear_slot(last);
+
+    slot_ids_[index] = last_id;
+    slot_ids_[last] = id;
+    id_slots_[last_id] = static_cast<std::uint32_t>(index);
+    id_slots_[id] = static_cast<std::uint32_t>(last);
+
+    generations_[id]++;
+}
+
+template <typename T>
+std::size_t BasicParticlePool<T>::compact(void)
+{
+    const std::uint8_t *alive = store_.alive.data();
+
+    // Renumber the survivors in slot order and set the dead identifiers aside.
+    dead_ids_.clear();
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < size_; i++) {
+        const std::uint32_t id = slot_ids_[i];
+        if (alive[i]) {
+            slot_ids_[kept] = id;
+            id_slots_[id] = static_cast<std::uint32_t>(kept);
+            kept++;
+        }
+        else {
+            dead_ids_.push_back(id);
+        }
+    }
+
+    // The dead identifiers join the free ones right behind the survivors.
+    for (std::size_t i = 0; i < dead_ids_.size(); i++) {
+        const std::uint32_t id = dead_ids_[i];
+        slot_ids_[kept + i] = id;
+        id_slots_[id] = static_cast<std::uint32_t>(kept + i);
+        generations_[id]++;
+    }
+
+    store_.compact(size_);
+    size_ = kept;
+    return dead_ids_.size();
+}
+
+template <typename T>
+void BasicParticlePool<T>::swap_slots(std::size_t a, std::size_t b)
+{
+    const std::uint32_t id_a = slot_ids_[a];
+    const std::uint32_t id_b = slot_ids_[b];
+
+    store_.swap_slots(a, b);
+
+    slot_ids_[a] = id_b;
+    slot_ids_[b] = id_a;
+    id_slots_[id_a] = static_cast<std::uint32_t>(b);
+    id_slots_[id_b] = static_cast<std::uint32_t>(a);
+}
+
+template <typename T>
+void BasicParticlePool<T>::clear(void)
+{
+    for (std::size_t i = 0; i < size_; i++) {
+        generations_[slot_ids_[i]]++;
+        store_.clear_slot(i);
+    }
+    size_ = 0;
+}
+
+template <typename T>
+bool BasicParticlePool<T>::is_valid(ParticleHandle handle) const
+{
+    return handle.id < id_slots_.size() && id_slots_[handle.id] < size_ &&
+           generations_[handle.id] == handle.generation;
+}
+
+template <typename T>
+std::size_t BasicParticlePool<T>::get_index(ParticleHandle handle) const
+{
+    return id_slots_[handle.id];
+}
+
+template <typename T>
+ParticleHandle BasicParticlePool<T>::get_handle(std::size_t index) const
+{
+    const std::uint32_t id = slot_ids_[index];
+    return ParticleHandle{id, generations_[id]};
+}
+
+template <typename T>
+BasicParticleStore<T> &BasicParticlePool<T>::get_store(void) { return store_; }
+
+template <typename T>
+const BasicParticleStore<T> &BasicParticlePool<T>::get_store(void) const { return store_; }
+
+template <typename T>
+void BasicParticlePool<T>::save(SnapshotWriter &writer) const
+{
+    const std::size_t capacity = get_capacity();
+
+    writer.write_value(static_cast<std::uint64_t>(capacity));
+    writer.write_value(static_cast<std::uint64_t>(size_));
+    writer.write_array(slot_ids_.data(), capacity);
+    writer.write_array(id_slots_.data(), capacity);
+    writer.write_array(generations_.data(), capacity);
+    store_.save(writer, size_);
+}
+
+template <typename T>
+void BasicParticlePool<T>::load(SnapshotReader &reader)
+{
+    const std::uint64_t capacity = reader.read_value<std::uint64_t>();
+    const std::uint64_t size = reader.read_value<std::uint64_t>();
+    if (capacity > std::numeric_limits<std::uint32_t>::max() || size > capacity) {
+        reader.fail("invalid particle pool size");
+    }
+
+    clear();
+    set_capacity(capacity);
+
+    // The identifiers index the other arrays, make sure they form a permutation before using them.
+    const std::uint32_t *slot_ids = reader.read_array<std::uint32_t>(capacity);
+    const std::uint32_t *id_slots = reader.read_array<std::uint32_t>(capacity);
+    const std::uint32_t *generations = reader.read_array<std::uint32_t>(capacity);
+    for (std::size_t i = 0; i < capacity; i++) {
+        if (slot_ids[i] >= capacity || id_slots[slot_ids[i]] != i) {
+            reader.fail("inconsistent particle identifiers");
+        }
+    }
+
+    store_.load(reader, size);
+
+    std::copy(slot_ids, slot_ids + capacity, slot_ids_.begin());
+    std::copy(id_slots, id_slots + capacity, id_slots_.begin());
+    std::copy(generations, generations + capacity, generations_.begin());
+    size_ = size;
+}
+
+// Explicitly instantiate all the supported precisions
+template class BasicParticlePool<float>;
+template class BasicParticlePool<double>;
@@ -0,0 +1,266 @@
+/**
+ * @file    particle_pool.hpp
+ * @author  Martin Cagas
+ *
+ * @brief   Fixed-capacity pool of particles with constant-time spawning and killing.
+ */
+
+#pragma once
+
+// Standard includes
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+// Local includes
+#include "particle_store.hpp"
+#include "snapshot.hpp"
+
+/**
+ * @struct  ParticleHandle
+ *
+ * @brief   Stable reference to a particle living in a ParticlePool.
+ *
+ * @details
+ *
+ * Particles move between slots of the store whenever another particle is killed or the slots are
+ * reordered, so gameplay code has to refer to them through handles instead of slot indices. The
+ * generation is bumped each time a particle dies, so handles of dead particles never resolve to
+ * particles spawned later.
+ */
+struct ParticleHandle
+{
+    std::uint32_t id;          ///< Identifier of the particle, unique among the live particles.
+    std::uint32_t generation;  ///< Generation of the identifier at the time of spawning.
+};
+
+/**
+ * @class   BasicParticlePool
+ *
+ * @brief   Fixed-capacity pool of particles with constant-time spawning and killing.
+ *
+ * @section DESCRIPTION
+ *
+ * The pool owns a ParticleStore with one slot per particle of the capacity and preallocates all the
+ * bookkeeping up front, so neither spawning nor killing a particle ever allocates memory.
+ *
+ * The live particles are always packed densely in the slots [0, get_size()) of the store. Killing a
+ * particle moves the last live particle into its slot (swap-remove), so the passes over the
+ * particles never need to step over dead slots.
+ *
+ * Identifiers are kept as a sparse set: slot_ids_ lists the identifiers of the live particles in
+ * slot order followed by the free identifiers, and id_slots_ maps the identifiers back to slots.
+ * Spawning takes the first free identifier, killing swaps the identifier behind the live ones.
+ *
+ * ParticlePool stores double precision particles and ParticlePoolF single precision ones.
+ *
+ * @section USAGE
+ *
+ * @code
+ *
+ * ParticlePool pool(1000);
+ *
+ * ParticleHandle handle = pool.spawn();
+ * pool.get_store().x[pool.get_index(handle)] = 10.0;
+ *
+ * pool.kill(handle);
+ *
+ * @endcode
+ */
+template <typename T>
+class BasicParticlePool
+{
+public:
+    /**
+     * @brief   Empty constructor.
+     *
+     * @details
+     *
+     * Creates a pool with no capacity.
+     */
+    BasicParticlePool(void);
+
+    /**
+     * @brief   Constructor.
+     *
+     * @param   capacity    The maximum amount of live particles.
+     */
+    BasicParticlePool(std::size_t capacity);
+
+    /**
+     * @brief   Changes the capacity of the pool.
+     *
+     * @details
+     *
+     * Growing the pool keeps all live particles and their handles. Shrinking it kills all of them.
+     *
+     * @param   capacity    The maximum amount of live particles.
+     */
+    void set_capacity(std::size_t capacity);
+
+    /**
+     * @brief   Returns the maximum amount of live particles.
+     */
+    std::size_t get_capacity(void) const;
+
+    /**
+     * @brief   Returns the amount of live particles.
+     */
+    std::size_t get_size(void) const;
+
+    /**
+     * @brief   Returns true if no more particles can be spawned, false otherwise.
+     */
+    bool is_full(void) const;
+
+    /**
+     * @brief   Spawns a new particle in the first free slot.
+     *
+     * @details
+     *
+     * The slot is zeroed and marked as alive.
+     *
+     * @param   &handle     Receives the handle of the new particle.
+     *
+     * @return  True on success, false if the pool is full.
+     */
+    bool spawn(ParticleHandle &handle);
+
+    /**
+     * @brief   Spawns many new particles at once.
+     *
+     * @details
+     *
+     * The live particles are packed in front of the store, so the new particles occupy the
+     * contiguous slots [get_size() - spawned, get_size()) and can be initialised in bulk. The slots
+     * are cleared and marked as alive.
+     *
+     * @param   count       Amount of particles to spawn.
+     *
+     * @return  Amount of particles spawned, lower than count if the pool got full.
+     */
+    std::size_t spawn_batch(std::size_t count);
+
+    /**
+     * @brief   Kills a particle.
+     *
+     * @param   handle      Handle of the particle.
+     *
+     * @return  True if the particle was alive, false otherwise.
+     */
+    bool kill(ParticleHandle handle);
+
+    /**
+     * @brief   Kills the particle in the given slot.
+     *
+     * @details
+     *
+     * The last live particle is moved into the freed slot.
+     *
+     * @param   index       Index of the slot, must be lower than get_size().
+     */
+    void kill_at(std::size_t index);
+
+    /**
+     * @brief   Kills all the live particles whose slots are no longer marked as alive.
+     *
+     * @details
+     *
+     * Meant for killing many particles at once: clear the alive flags of their slots in the store,
+     * then compact the pool in a single pass linear in the amount of live particles. Unlike
+     * kill_at(), the surviving particles keep their relative order. The handles of the surviving
+     * particles stay valid, the handles of the killed ones are invalidated.
+     *
+     * @return  Amount of particles killed.
+     */
+    std::size_t compact(void);
+
+    /**
+     * @brief   Exchanges the slots of two live particles.
+     *
+     * @details
+     *
+     * The handles of both particles stay valid, only their slot indices change.
+     *
+     * @param   a           Index of the first slot, must be lower than get_size().
+     * @param   b           Index of the second slot, must be lower than get_size().
+     */
+    void swap_slots(std::size_t a, std::size_t b);
+
+    /**
+     * @brief   Kills all particles.
+     */
+    void clear(void);
+
+    /**
+     * @brief   Returns true if the handle refers to a live particle, false otherwise.
+     */
+    bool is_valid(ParticleHandle handle) const;
+
+    /**
+     * @brief   Returns the slot index of a live particle.
+     *
+     * @param   handle      Handle of the particle, must be valid.
+     */
+    std::size_t get_index(ParticleHandle handle) const;
+
+    /**
+     * @brief   Returns the handle of the particle in the given slot.
+     *
+     * @param   index       Index of the slot, must be lower than get_size().
+     */
+    ParticleHandle get_handle(std::size_t index) const;
+
+    /**
+     * @brief   Returns the store holding the particles.
+     */
+    BasicParticleStore<T> &get_store(void);
+
+    /**
+     * @brief   Returns the store holding the particles.
+     */
+    const BasicParticleStore<T> &get_store(void) const;
+
+    /**
+     * @brief   Writes the pool into a snapshot.
+     *
+     * @details
+     *
+     * Writes the bookkeeping of all the slots and the data of the live ones, so that the handles
+     * of the live particles stay valid across save() and load().
+     *
+     * @param   &writer     Writer of the snapshot.
+     */
+    void save(SnapshotWriter &writer) const;
+
+    /**
+     * @brief   Replaces the contents of the pool with a pool written into a snapshot by save().
+     *
+     * @details
+     *
+     * The capacity becomes the one of the saved pool. On failure, the pool is left empty.
+     *
+     * @param   &reader     Reader of the snapshot.
+     *
+     * @throws  std::runtime_error if the snapshot is malformed.
+     */
+    void load(SnapshotReader &reader);
+
+protected:
+    BasicParticleStore<T> store_;             ///< Particle data, live particles packed in front.
+    std::size_t size_;                        ///< Amount of live particles.
+    std::vector<std::uint32_t> slot_ids_;     ///< Identifiers of the particles in each slot.
+    std::vector<std::uint32_t> id_slots_;     ///< Slots of the particles with each identifier.
+    std::vector<std::uint32_t> generations_;  ///< Current generation of each identifier.
+    std::vector<std::uint32_t> dead_ids_;     ///< Identifiers of the particles killed by compact().
+};
+
+/**
+ * @brief   Double precision particle pool.
+ */
+typedef BasicParticlePool<double> ParticlePool;
+
+/**
+ * @brief   Single precision particle pool.
+ */
+typedef BasicParticlePool<float> ParticlePoolF;
@@ -0,0 +1,236 @@
+/**
+ * @file    particle_store.cpp
+ * @author  Martin Cagas
+ *
+ * @brief   Structure-of-arrays storage of all the particles in the game world.
+ */
+
+#include "particle_store.hpp"
+
+// Standard includes
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+// "Game essentials" library includes
+#include <hash.hpp>
+
+/**
+ * @brief   Moves the elements of the alive slots to the front of an array, keeping their order.
+ */
+template <typename U>
+static void compact_array(std::vector<U> &array, const std::vector<std::uint8_t> &alive,
+                          std::size_t count)
+{
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < count; i++) {
+        array[kept] = array[i];
+        kept += alive[i] ? 1 : 0;
+    }
+}
+
+/**
+ * @brief   Copies an array of a snapshot into the front of an array.
+ */
+template <typename U>
+static void load_array(SnapshotReader &reader, std::vector<U> &array, std::size_t count)
+{
+    const U *data = reader.read_array<U>(count);
+    std::copy(data, data + count, array.begin());
+}
+
+/**
+ * @brief   Chains the hash of the front of an array onto a hash.
+ */
+template <typename U>
+static std::uint64_t hash_array(const std::vector<U> &array, std::size_t count, std::uint64_t seed)
+{
+    return essentials::hash_bytes(array.data(), count * sizeof(U), seed);
+}
+
+template <typename T>
+BasicParticleStore<T>::BasicParticleStore(void) {}
+
+template <typename T>
+BasicParticleStore<T>::BasicParticleStore(std::size_t capacity) { set_capacity(capacity); }
+
+template <typename T>
+void BasicParticleStore<T>::set_capacity(std::size_t capacity)
+{
+    x.resize(capacity, T(0));
+    y.resize(capacity, T(0));
+    px.resize(capacity, T(0));
+    py.resize(capacity, T(0));
+    vx.resize(capacity, T(0));
+    vy.resize(capacity, T(0));
+    mass.resize(capacity, T(0));
+    fx.resize(capacity, T(0));
+    fy.resize(capacity, T(0));
+    ax.resize(capacity, T(0));
+    ay.resize(capacity, T(0));
+    age.resize(capacity, T(0));
+    lifetime.resize(capacity, std::numeric_limits<T>::infinity());
+    radius.resize(capacity, T(0));
+    alive.resize(capacity, 0);
+}
+
+template <typename T>
+std::size_t BasicParticleStore<T>::get_capacity(void) const { return alive.size(); }
+
+template <typename T>
+std::size_t BasicParticleStore<T>::compact(std::size_t count)
+{
+    // The alive mask goes last, all the other arrays need it intact.
+    compact_array(x, alive, count);
+    compact_array(y, alive, count);
+    compact_array(px, alive, count);
+    compact_array(py, alive, count);
+    compact_array(vx, alive, count);
+    compact_array(vy, alive, count);
+    compact_array(mass, alive, count);
+    compact_array(fx, alive, count);
+    compact_array(fy, alive, count);
+    compact_array(ax, alive, count);
+    compact_array(ay, alive, count);
+    compact_array(age, alive, count);
+    compact_array(lifetime, alive, count);
+    compact_array(radius, alive, count);
+
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < count; i++) {
+        kept += alive[i] ? 1 : 0;
+    }
+    std::fill(alive.begin(), alive.begin() + kept, std::uint8_t(1));
+    std::fill(alive.begin() + kept, alive.begin() + count, std::uint8_t(0));
+
+    return kept;
+}
+
+template <typename T>
+void BasicParticleStore<T>::clear_slot(std::size_t index)
+{
+    x[index] = T(0);
+    y[index] = T(0);
+    px[index] = T(0);
+    py[index] = T(0);
+    vx[index] = T(0);
+    vy[index] = T(0);
+    mass[index] = T(0);
+    fx[index] = T(0);
+    fy[index] = T(0);
+    ax[index] = T(0);
+    ay[index] = T(0);
+    age[index] = T(0);
+    lifetime[index] = std::numeric_limits<T>::infinity();
+    radius[index] = T(0);
+    alive[index] = 0;
+}
+
+template <typename T>
+void BasicParticleStore<T>::move_slot(std::size_t from, std::size_t to)
+{
+    x[to] = x[from];
+    y[to] = y[from];
+    px[to] = px[from];
+    py[to] = py[from];
+    vx[to] = vx[from];
+    vy[to] = vy[from];
+    mass[to] = mass[from];
+    fx[to] = fx[from];
+    fy[to] = fy[from];
+    ax[to] = ax[from];
+    ay[to] = ay[from];
+    age[to] = age[from];
+    lifetime[to] = lifetime[from];
+    radius[to] = radius[from];
+    alive[to] = alive[from];
+}
+
+template <typename T>
+void BasicParticleStore<T>::swap_slots(std::size_t a, std::size_t b)
+{
+    std::swap(x[a], x[b]);
+    std::swap(y[a], y[b]);
+    std::swap(px[a], px[b]);
+    std::swap(py[a], py[b]);
+    std::swap(vx[a], vx[b]);
+    std::swap(vy[a], vy[b]);
+    std::swap(mass[a], mass[b]);
+    std::swap(fx[a], fx[b]);
+    std::swap(fy[a], fy[b]);
+    std::swap(ax[a], ax[b]);
+    std::swap(ay[a], ay[b]);
+    std::swap(age[a], age[b]);
+    std::swap(lifetime[a], lifetime[b]);
+    std::swap(radius[a], radius[b]);
+    std::swap(alive[a], alive[b]);
+}
+
+template <typename T>
+void BasicParticleStore<T>::save(SnapshotWriter &writer, std::size_t count) const
+{
+    writer.write_array(x.data(), count);
+    writer.write_array(y.data(), count);
+    writer.write_array(px.data(), count);
+    writer.write_array(py.data(), count);
+    writer.write_array(vx.data(), count);
+    writer.write_array(vy.data(), count);
+    writer.write_array(mass.data(), count);
+    writer.write_array(fx.data(), count);
+    writer.write_array(fy.data(), count);
+    writer.write_array(ax.data(), count);
+    writer.write_array(ay.data(), count);
+    writer.write_array(age.data(), count);
+    writer.write_array(lifetime.data(), count);
+    writer.write_array(radius.data(), count);
+    writer.write_array(alive.data(), count);
+}
+
+template <typename T>
+void BasicParticleStore<T>::load(SnapshotReader &reader, std::size_t count)
+{
+    if (count > get_capacity()) {
+        reader.fail("more particles than slots");
+    }
+
+    load_array(reader, x, count);
+    load_array(reader, y, count);
+    load_array(reader, px, count);
+    load_array(reader, py, count);
+    load_array(reader, vx, count);
+    load_array(reader, vy, count);
+    load_array(reader, mass, count);
+    load_array(reader, fx, count);
+    load_array(reader, fy, count);
+    load_array(reader, ax, count);
+    load_array(reader, ay, count);
+    load_array(reader, age, count);
+    load_array(reader, lifetime, count);
+    load_array(reader, radius, count);
+    load_array(reader, alive, count);
+}
+
+template <typename T>
+std::uint64_t BasicParticleStore<T>::hash(std::size_t count) const
+{
+    std::uint64_t result = count;
+    result = hash_array(x, count, result);
+    result = hash_array(y, count, result);
+    result = hash_array(px, count, result);
+    result = hash_array(py, count, result);
+    result = hash_array(vx, count, result);
+    result = hash_array(vy, count, result);
+    result = hash_array(mass, count, result);
+    result = hash_array(fx, count, result);
+    result = hash_array(fy, count, result);
+    result = hash_array(ax, count, result);
+    result = hash_array(ay, count, result);
+    result = hash_array(age, count, result);
+    result = hash_array(lifetime, count, result);
+    result = hash_array(radius, count, result);
+    return hash_array(alive, count, result);
+}
+
+// Explicitly instantiate all the supported precisions
+template struct BasicParticleStore<float>;
+template struct BasicParticleStore<double>;
@@ -0,0 +1,198 @@
+/**
+ * @file    particle_store.hpp
+ * @author  Martin Cagas
+ *
+ * @brief   Structure-of-arrays storage of all the particles in the game world.
+ */
+
+#pragma once
+
+// Standard includes
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+// Local includes
+#include "snapshot.hpp"
+
+/**
+ * @class   BasicParticleStore
+ *
+ * @brief   Structure-of-arrays storage of all the particles in the game world.
+ *
+ * @section DESCRIPTION
+ *
+ * Instead of keeping every particle as a separate PhysicsObject instance, the state of all the
+ * particles is split into one contiguous array per component. Slot i of every array describes the
+ * same particle. All the arrays always have the same length - the capacity of the store.
+ *
+ * The passes run over the particles every frame (force integration, position update) only touch
+ * the components they need and stream through them linearly, which keeps the memory bandwidth
+ * spent per particle to a minimum.
+ *
+ * The force accumulators are filled by the force sources and consumed and cleared by the force
+ * integration, so they are always zero between steps unless gameplay code applies extra forces.
+ *
+ * The previous positions hold the positions from before the last position update, so that the
+ * rendering can interpolate between the last two steps of the simulation. The accelerations are
+ * kept from one step to the next by the integrators that reuse them. The age of a particle counts
+ * the simulated time since its spawning, the particle expires once it reaches its lifetime. The
+ * lifetime is infinite unless its spawner gives it one. The radius gives a particle its extent
+ * for the collisions with the other particles, the obstacles and the bounds of the world.
+ * Particles with a zero radius, the default, never collide with each other.
+ *
+ * The alive mask marks the slots that hold a particle. The contents of the other arrays are
+ * meaningless for slots that are not alive. The store itself does not decide which slots are used,
+ * that is the job of the ParticlePool owning it.
+ *
+ * The store is a template over the type of the components. ParticleStore uses double precision and
+ * ParticleStoreF single precision.
+ *
+ * @section USAGE
+ *
+ * @code
+ *
+ * ParticleStore store(1000);
+ *
+ * store.x[0] = 10.0;
+ * store.y[0] = 20.0;
+ * store.alive[0] = 1;
+ *
+ * @endcode
+ */
+template <typename T>
+struct BasicParticleStore
+{
+    std::vector<T> x;                 ///< X components of the positions.
+    std::vector<T> y;                 ///< Y components of the positions.
+    std::vector<T> px;                ///< X components of the previous positions.
+    std::vector<T> py;                ///< Y components of the previous positions.
+    std::vector<T> vx;                ///< X components of the velocities.
+    std::vector<T> vy;                ///< Y components of the velocities.
+    std::vector<T> mass;              ///< Masses for the gravitational force calculation.
+    std::vector<T> fx;                ///< X components of the accumulated forces.
+    std::vector<T> fy;                ///< Y components of the accumulated forces.
+    std::vector<T> ax;                ///< X components of the accelerations of the last step.
+    std::vector<T> ay;                ///< Y components of the accelerations of the last step.
+    std::vector<T> age;               ///< Time since the particles were spawned.
+    std::vector<T> lifetime;          ///< Time after which the particles expire.
+    std::vector<T> radius;            ///< Radii of the particles.
+    std::vector<std::uint8_t> alive;  ///< Non-zero for the slots holding a particle.
+
+    /**
+     * @brief   Empty constructor.
+     *
+     * @details
+     *
+     * Creates a store with no slots.
+     */
+    BasicParticleStore(void);
+
+    /**
+     * @brief   Constructor.
+     *
+     * @details
+     *
+     * Creates a store with the given amount of slots, none of them alive.
+     *
+     * @param   capacity    Amount of slots.
+     */
+    BasicParticleStore(std::size_t capacity);
+
+    /**
+     * @brief   Resizes all the arrays to the new capacity.
+     *
+     * @details
+     *
+     * Slots below the new capacity keep their contents, new slots are cleared and not alive.
+     *
+     * @param   capacity    New amount of slots.
+     */
+    void set_capacity(std::size_t capacity);
+
+    /**
+     * @brief   Returns the amount of slots in the store.
+     */
+    std::size_t get_capacity(void) const;
+
+    /**
+     * @brief   Removes the slots that are not alive from a range of slots in one pass.
+     *
+     * @details
+     *
+     * The alive slots among [0, count) are moved to the front of the store in their original order,
+     * the slots behind them are marked as not alive. Every array is compacted in a loop of its own,
+     * so the cost is linear in count no matter how many slots are removed.
+     *
+     * @param   count       Amount of slots to compact.
+     *
+     * @return  Amount of alive slots, now occupying [0, return value).
+     */
+    std::size_t compact(std::size_t count);
+
+    /**
+     * @brief   Zeroes a single slot, gives it an infinite lifetime and marks it as not alive.
+     *
+     * @param   index       Index of the slot.
+     */
+    void clear_slot(std::size_t index);
+
+    /**
+     * @brief   Copies the contents of one slot over another slot.
+     *
+     * @param   from        Index of the source slot.
+     * @param   to          Index of the destination slot.
+     */
+    void move_slot(std::size_t from, std::size_t to);
+
+    /**
+     * @brief   Exchanges the contents of two slots.
+     *
+     * @param   a           Index of the first slot.
+     * @param   b           Index of the second slot.
+     */
+    void swap_slots(std::size_t a, std::size_t b);
+
+    /**
+     * @brief   Writes the slots [0, count) into a snapshot, one array after another.
+     *
+     * @param   &writer     Writer of the snapshot.
+     * @param   count       Amount of slots to write.
+     */
+    void save(SnapshotWriter &writer, std::size_t count) const;
+
+    /**
+     * @brief   Reads the slots [0, count) from a snapshot written by save().
+     *
+     * @details
+     *
+     * Every array is copied out of the snapshot in bulk. The other slots are left untouched.
+     *
+     * @param   &reader     Reader of the snapshot.
+     * @param   count       Amount of slots to read, at most the capacity.
+     *
+     * @throws  std::runtime_error if the snapshot is malformed.
+     */
+    void load(SnapshotReader &reader, std::size_t count);
+
+    /**
+     * @brief   Returns a hash of the contents of the slots [0, count).
+     *
+     * @details
+     *
+     * Covers every array, bit for bit, so equal hashes mean equal states with near certainty.
+     *
+     * @param   count       Amount of slots to hash.
+     */
+    std::uint64_t hash(std::size_t count) const;
+};
+
+/**
+ * @brief   Double precision particle store.
+ */
+typedef BasicParticleStore<double> ParticleStore;
+
+/**
+ * @brief   Single precision particle store.
+ */
+typedef BasicParticleStore<float> ParticleStoreF;
@@ -0,0 +1,106 @@
+/**
+ * @file    particle_view.cpp
+ * @author  Martin Cagas
+ *
+ * @brief   Particle-like accessor to a single particle of a ParticlePool.
+ */
+
+#include "particle_view.hpp"
+
+using namespace essentials;
+
+template <typename T>
+BasicParticleView<T>::BasicParticleView(BasicParticlePool<T> &pool, ParticleHandle handle)
+    : pool_(&pool), handle_(handle)
+{
+}
+
+template <typename T>
+ParticleHandle BasicParticleView<T>::get_handle(void) const { return handle_; }
+
+template <typename T>
+std::size_t BasicParticleView<T>::get_index(void) const { return pool_->get_index(handle_); }
+
+template <typename T>
+bool BasicParticleView<T>::is_alive(void) const { return pool_->is_valid(handle_); }
+
+template <typename T>
+void BasicParticleView<T>::setup(BasicVector2D<T> position, BasicVector2D<T> velocity)
+{
+    set_position(position);
+    set_velocity(velocity);
+}
+
+template <typename T>
+void BasicParticleView<T>::kill(void) { pool_->kill(handle_); }
+
+template <typename T>
+void BasicParticleView<T>::set_position(BasicVector2D<T> position)
+{
+    const std::size_t index = get_index();
+    pool_->get_store().x[index] = position.x;
+    pool_->get_store().y[index] = position.y;
+    pool_->get_store().px[index] = position.x;
+    pool_->get_store().py[index] = position.y;
+}
+
+template <typename T>
+BasicVector2D<T> BasicParticleView<T>::get_position(void) const
+{
+    const std::size_t index = get_index();
+    return BasicVector2D<T>(pool_->get_store().x[index], pool_->get_store().y[index]);
+}
+
+template <typename T>
+void BasicParticleView<T>::set_velocity(BasicVector2D<T> velocity)
+{
+    const std::size_t index = get_index();
+    pool_->get_store().vx[index] = velocity.x;
+    pool_->get_store().vy[index] = velocity.y;
+}
+
+template <typename T>
+BasicVector2D<T> BasicParticleView<T>::get_velocity(void) const
+{
+    const std::size_t index = get_index();
+    return BasicVector2D<T>(pool_->get_store().vx[index], pool_->get_store().vy[index]);
+}
+
+template <typename T>
+void BasicParticleView<T>::apply_force(const BasicVector2D<T> &force)
+{
+    const std::size_t index = get_index();
+    pool_->get_store().fx[index] += force.x;
+    pool_->get_store().fy[index] += force.y;
+}
+
+template <typename T>
+void BasicParticleView<T>::set_mass(T mass) { pool_->get_store().mass[get_index()] = mass; }
+
+template <typename T>
+T BasicParticleView<T>::get_mass(void) const { return pool_->get_store().mass[get_index()]; }
+
+template <typename T>
+T BasicParticleView<T>::get_age(void) const { return pool_->get_store().age[get_index()]; }
+
+template <typename T>
+void BasicParticleView<T>::set_lifetime(T lifetime)
+{
+    pool_->get_store().lifetime[get_index()] = lifetime;
+}
+
+template <typename T>
+T BasicParticleView<T>::get_lifetime(void) const
+{
+    return pool_->get_store().lifetime[get_index()];
+}
+
+template <typename T>
+void BasicParticleView<T>::set_radius(T radius) { pool_->get_store().radius[get_index()] = radius; }
+
+template <typename T>
+T BasicParticleView<T>::get_radius(void) const { return pool_->get_store().radius[get_index()]; }
+
+// Explicitly instantiate all the supported precisions
+template class BasicParticleView<float>;
+template class BasicParticleView<double>;
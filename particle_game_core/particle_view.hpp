@@ -0,0 +1,180 @@
+/**
+ * @file    particle_view.hpp
+ * @author  Martin Cagas
+ *
+ * @brief   Particle-like accessor to a single particle of a ParticlePool.
+ */
+
+#pragma once
+
+// Standard includes
+#include <cstdlib>
+
+// "Game essentials" library includes
+#include <vector2d.hpp>
+
+// Local includes
+#include "particle_pool.hpp"
+
+/**
+ * @class   BasicParticleView
+ *
+ * @brief   Particle-like accessor to a single particle of a ParticlePool.
+ *
+ * @section DESCRIPTION
+ *
+ * The particles themselves live in the structure-of-arrays store of a ParticlePool. This class
+ * provides the same interface as Particle (and PhysicsObject) for gameplay code that needs to work
+ * with a single particle, reading and writing straight through to the arrays of the store.
+ *
+ * The view refers to the particle by its handle, so it stays valid while other particles are killed
+ * and moved around. It holds no state of its own and must not outlive the pool.
+ *
+ * ParticleView views particles of a ParticlePool and ParticleViewF of a ParticlePoolF.
+ *
+ * @section USAGE
+ *
+ * @code
+ *
+ * ParticleView particle = world.get_particle(world.spawn_particle(Point2D(0.0, 0.0), Vector2D()));
+ *
+ * particle.set_mass(2.0);
+ *
+ * if (particle.is_alive()) {
+ *     particle.kill();
+ * }
+ *
+ * @endcode
+ */
+template <typename T>
+class BasicParticleView
+{
+public:
+    /**
+     * @brief   Constructor.
+     *
+     * @param   &pool       The pool holding the particle.
+     * @param   handle      Handle of the particle.
+     */
+    BasicParticleView(BasicParticlePool<T> &pool, ParticleHandle handle);
+
+    /**
+     * @brief   Returns the handle of the viewed particle.
+     */
+    ParticleHandle get_handle(void) const;
+
+    /**
+     * @brief   Returns the current slot index of the viewed particle.
+     *
+     * @details
+     *
+     * The index changes whenever another particle is killed, it must not be kept around.
+     */
+    std::size_t get_index(void) const;
+
+    /**
+     * @brief   Returns true if the viewed particle is still alive, false otherwise.
+     *
+     * @details
+     *
+     * The getters and setters may only be used while the particle is alive.
+     */
+    bool is_alive(void) const;
+
+    /**
+     * @brief   Sets a new state to the particle.
+     */
+    void setup(essentials::BasicVector2D<T> position, essentials::BasicVector2D<T> velocity);
+
+    /**
+     * @brief   Returns the particle back to the pool.
+     */
+    void kill(void);
+
+    /**
+     * @brief   Position setter.
+     *
+     * @details
+     *
+     * Sets the previous position as well, so that the particle is not interpolated across the
+     * move.
+     */
+    void set_position(essentials::BasicVector2D<T> position);
+
+    /**
+     * @brief   Position getter.
+     */
+    essentials::BasicVector2D<T> get_position(void) const;
+
+    /**
+     * @brief   Velocity setter.
+     */
+    void set_velocity(essentials::BasicVector2D<T> velocity);
+
+    /**
+     * @brief   Velocity getter.
+     */
+    essentials::BasicVector2D<T> get_velocity(void) const;
+
+    /**
+     * @brief   Adds a force to the particle's force accumulator.
+     *
+     * @details
+     *
+     * The force is consumed by the next force integration of the world.
+     */
+    void apply_force(const essentials::BasicVector2D<T> &force);
+
+    /**
+     * @brief   Mass setter.
+     */
+    void set_mass(T mass);
+
+    /**
+     * @brief   Mass getter.
+     */
+    T get_mass(void) const;
+
+    /**
+     * @brief   Returns the time since the particle was spawned.
+     */
+    T get_age(void) const;
+
+    /**
+     * @brief   Lifetime setter.
+     *
+     * @param   lifetime    Age at which the particle expires.
+     */
+    void set_lifetime(T lifetime);
+
+    /**
+     * @brief   Lifetime getter.
+     */
+    T get_lifetime(void) const;
+
+    /**
+     * @brief   Radius setter.
+     *
+     * @param   radius      Radius of the particle for the collisions, 0.0 to never collide.
+     */
+    void set_radius(T radius);
+
+    /**
+     * @brief   Radius getter.
+     */
+    T get_radius(void) const;
+
+protected:
+    BasicParticlePool<T> *pool_;  ///< The pool holding the particle.
+    ParticleHandle handle_;       ///< Handle of the particle.
+};
+
+/**
+ * @brief   View of a double precision particle.
+ */
+typedef BasicParticleView<double> ParticleView;
+
+/**
+ * @brief   View of a single precision particle.
+ */
+typedef BasicParticleView<float> ParticleViewF;
@@ -9,35 +9,92 @@
 
 using namespace essentials;
 
-PhysicsObject::PhysicsObject(void) : position_(0.0, 0.0), velocity_(0.0, 0.0), mass_(0.0) {}
+template <typename T>
+BasicPhysicsObject<T>::BasicPhysicsObject(void)
+    : position_(0.0, 0.0), velocity_(0.0, 0.0), mass_(0.0), force_(0.0, 0.0)
+{
+}
 
-PhysicsObject::PhysicsObject(Vector2D position)
-    : position_(position), velocity_(0.0, 0.0), mass_(0.0)
+template <typename T>
+BasicPhysicsObject<T>::BasicPhysicsObject(BasicVector2D<T> position)
+    : position_(position), velocity_(0.0, 0.0), mass_(0.0), force_(0.0, 0.0)
 {
 }
 
-PhysicsObject::PhysicsObject(Point2D initial_position, double initial_mass)
-    : position_(initial_position), velocity_(0.0, 0.0), mass_(initial_mass)
+template <typename T>
+BasicPhysicsObject<T>::BasicPhysicsObject(BasicVector2D<T> initial_position, T initial_mass)
+    : position_(initial_position), velocity_(0.0, 0.0), mass_(initial_mass), force_(0.0, 0.0)
 {
 }
 
-void PhysicsObject::set_position(Point2D position) { position_ = position; }
+template <typename T>
+void BasicPhysicsObject<T>::set_position(BasicVector2D<T> position) { position_ = position; }
+
+template <typename T>
+BasicVector2D<T> BasicPhysicsObject<T>::get_position(void) const { return position_; }
+
+template <typename T>
+void BasicPhysicsObject<T>::set_velocity(BasicVector2D<T> velocity) { velocity_ = velocity; }
 
-Point2D PhysicsObject::get_position(void) const { return position_; }
+template <typename T>
+BasicVector2D<T> BasicPhysicsObject<T>::get_velocity(void) const { return velocity_; }
 
-void PhysicsObject::set_velocity(Point2D velocity) { velocity_ = velocity; }
+template <typename T>
+void BasicPhysicsObject<T>::set_mass(T mass) { mass_ = mass; }
 
-Point2D PhysicsObject::get_velocity(void) const { return velocity_; }
+template <typename T>
+T BasicPhysicsObject<T>::get_mass(void) const { return mass_; }
 
-void PhysicsObject::set_mass(double mass) { mass_ = mass; }
+template <typename T>
+BasicVector2D<T> BasicPhysicsObject<T>::get_force(void) const { return force_; }
 
-double PhysicsObject::get_mass(void) const { return mass_; }
+template <typename T>
+void BasicPhysicsObject<T>::apply_force(const BasicVector2D<T> &force) { force_ += force; }
+
+template <typename T>
+void BasicPhysicsObject<T>::integrate_forces(T time_step)
+{
+    velocity_ += force_ * (time_step / ((mass_ != T(0)) ? mass_ : T(1)));
+    force_.set_all(T(0));
+}
 
-void PhysicsObject::integrate_forces(std::vector<Vector2D> forces)
+template <typename T>
+void BasicPhysicsObject<T>::integrate_forces(const std::vector<BasicVector2D<T>> &forces,
+                                             T time_step)
 {
-    for (Vector2D force : forces) {
-        velocity_ += force;
+    for (const BasicVector2D<T> &force : forces) {
+        apply_force(force);
     }
+    integrate_forces(time_step);
+}
+
+template <typename T>
+void BasicPhysicsObject<T>::update(T time_step) { position_ += velocity_ * time_step; }
+
+template <typename T>
+void BasicPhysicsObject<T>::save(SnapshotWriter &writer) const
+{
+    writer.write_value(position_.x);
+    writer.write_value(position_.y);
+    writer.write_value(velocity_.x);
+    writer.write_value(velocity_.y);
+    writer.write_value(mass_);
+    writer.write_value(force_.x);
+    writer.write_value(force_.y);
+}
+
+template <typename T>
+void BasicPhysicsObject<T>::load(SnapshotReader &reader)
+{
+    position_.x = reader.read_value<T>();
+    position_.y = reader.read_value<T>();
+    velocity_.x = reader.read_value<T>();
+    velocity_.y = reader.read_value<T>();
+    mass_ = reader.read_value<T>();
+    force_.x = reader.read_value<T>();
+    force_.y = reader.read_value<T>();
 }
 
-void PhysicsObject::update(void) { position_ += velocity_; }
+// Explicitly instantiate all the supported precisions
+template class BasicPhysicsObject<float>;
+template class BasicPhysicsObject<double>;
@@ -14,8 +14,11 @@
 // "Game essentials" library includes
 #include <vector2d.hpp>
 
+// Local includes
+#include "snapshot.hpp"
+
 /**
- * @class   PhysicsObject
+ * @class   BasicPhysicsObject
  *
  * @brief   Base class for any physics-enabled object.
  *
@@ -25,17 +28,27 @@
  * - position
  * - velocity
  * - mass
+ * - force accumulated since the last integration
  *
  * Has following methods:
+ * - apply_force()
  * - integrate_forces()
  * - update()
  *
+ * Forces acting on the object are added to its accumulator with apply_force() and consumed all at
+ * once by integrate_forces(), which clears the accumulator again. No memory is allocated along the
+ * way.
+ *
+ * The class is a template over the type of the components. PhysicsObject uses double precision and
+ * PhysicsObjectF single precision.
+ *
  * @section USAGE
  *
  * This class isn't intended to be used directly, instead it serves as a base class for other
  * objects in the game world.
  */
-class PhysicsObject
+template <typename T>
+class BasicPhysicsObject
 {
 public:
     /**
@@ -49,7 +62,7 @@ public:
      *
      * @see    Particle::Particle()
      */
-    PhysicsObject(void);
+    BasicPhysicsObject(void);
 
     /**
      * @brief   Position-only constructor.
@@ -64,7 +77,7 @@ public:
      *
      * @param   position    Initial position.
      */
-    PhysicsObject(essentials::Vector2D position);
+    BasicPhysicsObject(essentials::BasicVector2D<T> position);
 
     /**
      * @brief   Contructor.
@@ -80,52 +93,109 @@ public:
      * @param   position    Initial position.
      * @param   mass        Initial mass.
      */
-    PhysicsObject(essentials::Point2D initial_position, double initial_mass);
+    BasicPhysicsObject(essentials::BasicVector2D<T> initial_position, T initial_mass);
 
     /**
      * @brief   position_ setter.
      */
-    void set_position(essentials::Point2D position);
+    void set_position(essentials::BasicVector2D<T> position);
 
     /**
      * @brief   position_ getter.
      */
-    essentials::Point2D get_position(void) const;
+    essentials::BasicVector2D<T> get_position(void) const;
 
     /**
      * @brief   velocity_ setter.
      */
-    void set_velocity(essentials::Point2D velocity);
+    void set_velocity(essentials::BasicVector2D<T> velocity);
 
     /**
      * @brief   velocity_ getter.
      */
-    essentials::Point2D get_velocity(void) const;
+    essentials::BasicVector2D<T> get_velocity(void) const;
 
     /**
      * @brief   mass_ setter.
      */
-    void set_mass(double mass);
+    void set_mass(T mass);
 
     /**
      * @brief   mass_ getter.
      */
-    double get_mass(void) const;
+    T get_mass(void) const;
+
+    /**
+     * @brief   force_ getter.
+     */
+    essentials::BasicVector2D<T> get_force(void) const;
+
+    /**
+     * @brief   Adds a force to the force accumulator.
+     *
+     * @param   &force          The force to add.
+     */
+    void apply_force(const essentials::BasicVector2D<T> &force);
+
+    /**
+     * @brief   Sums up the accumulated force with the velocity and clears the accumulator.
+     *
+     * @details
+     *
+     * The force is divided by the mass, an object without mass is treated as having a unit mass.
+     *
+     * @param   time_step       Length of the step the force acts for.
+     */
+    void integrate_forces(T time_step);
 
     /**
      * @brief   Iterates over a list of vectors of forces and sums them up with the velocity.
      *
-     * @param   forces          The list of forces to integrate.
+     * @details
+     *
+     * The accumulated force is integrated as well.
+     *
+     * @param   &forces         The list of forces to integrate.
+     * @param   time_step       Length of the step the forces act for.
      */
-    void integrate_forces(std::vector<essentials::Vector2D> forces);
+    void integrate_forces(const std::vector<essentials::BasicVector2D<T>> &forces, T time_step);
 
     /**
      * @brief   Updates the PhysicsObject's position using its current velocity.
+     *
+     * @param   time_step       Length of the step to move for.
+     */
+    void update(T time_step);
+
+    /**
+     * @brief   Writes the position, velocity, mass and accumulated force into a snapshot.
+     *
+     * @param   &writer         Writer of the snapshot.
+     */
+    void save(SnapshotWriter &writer) const;
+
+    /**
+     * @brief   Reads the position, velocity, mass and accumulated force written by save().
+     *
+     * @param   &reader         Reader of the snapshot.
+     *
+     * @throws  std::runtime_error if the snapshot is malformed.
      */
-    void update(void);
+    void load(SnapshotReader &reader);
 
 protected:
-    essentials::Point2D position_;   ///< Position in the game world's 2D space.
-    essentials::Vector2D velocity_;  ///< Velocity in the game world's 2D space.
-    double mass_;                    ///< Mass for the gravitational force calculation.
+    essentials::BasicVector2D<T> position_;  ///< Position in the game world's 2D space.
+    essentials::BasicVector2D<T> velocity_;  ///< Velocity in the game world's 2D space.
+    T mass_;                                 ///< Mass for the gravitational force calculation.
+    essentials::BasicVector2D<T> force_;     ///< Force accumulated since the last integration.
 };
+
+/**
+ * @brief   Double precision physics object.
+ */
+typedef BasicPhysicsObject<double> PhysicsObject;
+
+/**
+ * @brief   Single precision physics object.
+ */
+typedef BasicPhysicsObject<float> PhysicsObjectF;
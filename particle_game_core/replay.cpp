@@ -0,0 +1,487 @@
+/**
+ * @file    replay.cpp
+ * @author  Martin Cagas
+ *
+ * @brief   Recording and deterministic replaying of the inputs of a game world.
+ */
+
+#include "replay.hpp"
+
+// Standard includes
+#include <memory>
+#include <stdexcept>
+#include <typeinfo>
+
+// Local includes
+#include "gravity_constant.hpp"
+
+using namespace essentials;
+
+/**
+ * @brief   Kinds of the records of a replay stream.
+ */
+enum class ReplayRecord : std::uint8_t
+{
+    SPAWN,                   ///< Spawn through World::spawn_particle().
+    KILL,                    ///< Kill through World::kill_particle().
+    PARTICLE,                ///< State of a particle spawned since the last step.
+    TIME_STEP,               ///< New time step.
+    GRAVITY_OBJECT_ADDED,    ///< GravityObject added to the world.
+    GRAVITY_CONSTANT_ADDED,  ///< GravityConstant added to the world.
+    GRAVITY_STATE,           ///< State of a gravity object.
+    STEP,                    ///< Step of the world.
+    HASH,                    ///< Hash of the state of the particles.
+    SETTINGS,                ///< Settings of the world.
+};
+
+namespace
+{
+    /**
+     * @brief   Pointer to one of the arrays of a particle store.
+     */
+    template <typename T>
+    using ParticleArray = std::vector<T> BasicParticleStore<T>::*;
+
+    /**
+     * @brief   Returns the arrays holding the state of a particle, except its alive flag.
+     */
+    template <typename T>
+    std::array<ParticleArray<T>, 14> get_particle_arrays(void)
+    {
+        typedef BasicParticleStore<T> Store;
+        return {&Store::x, &Store::y, &Store::px, &Store::py, &Store::vx,
+                &Store::vy, &Store::mass, &Store::fx, &Store::fy, &Store::ax,
+                &Store::ay, &Store::age, &Store::lifetime, &Store::radius};
+    }
+
+    /**
+     * @brief   Returns the state of a gravity object that the inputs of the world can change.
+     *
+     * @details
+     *
+     * The state is made of the enabled flag, the position, the mass, the softening, the cutoff
+     * radius and, for a GravityConstant, its angle and strength.
+     */
+    template <typename T>
+    std::array<T, 8> get_gravity_state(const BasicGravityObject<T> &object)
+    {
+        std::array<T, 8> state = {T(object.get_is_enabled() ? 1 : 0),
+                                  object.get_position().x,
+                                  object.get_position().y,
+                                  object.get_mass(),
+                                  object.get_softening(),
+                                  object.get_cutoff_radius(),
+                                  T(0),
+                                  T(0)};
+
+        const BasicGravityConstant<T> *constant =
+            dynamic_cast<const BasicGravityConstant<T> *>(&object);
+        if (constant != nullptr) {
+            state[6] = constant->get_gravity_angle_as_rad();
+            state[7] = constant->get_gravity_strength();
+        }
+
+        return state;
+    }
+
+    /**
+     * @brief   Gives a gravity object a state returned by get_gravity_state().
+     */
+    template <typename T>
+    void set_gravity_state(BasicGravityObject<T> &object, const std::array<T, 8> &state)
+    {
+        if (state[0] != T(0)) {
+            object.enable();
+        }
+        else {
+            object.disable();
+        }
+        object.set_position(BasicVector2D<T>(state[1], state[2]));
+        object.set_mass(state[3]);
+        object.set_softening(state[4]);
+        object.set_cutoff_radius(state[5]);
+
+        BasicGravityConstant<T> *constant = dynamic_cast<BasicGravityConstant<T> *>(&object);
+        if (constant != nullptr) {
+            constant->set_gravity_angle_from_rad(state[6]);
+            constant->set_gravity_strength(state[7]);
+        }
+    }
+
+    /**
+     * @brief   Returns the current settings of a world.
+     */
+    template <typename T>
+    BasicReplaySettings<T> get_settings(BasicWorld<T> &world)
+    {
+        BasicReplaySettings<T> settings;
+        settings.particle_limit = world.get_particle_limit();
+        settings.gravity_solver = static_cast<std::uint32_t>(world.get_gravity_solver());
+        settings.barnes_hut_theta = world.get_barnes_hut_theta();
+        settings.particle_self_gravity = world.get_particle_self_gravity();
+        settings.particle_collisions = world.get_particle_collisions();
+        settings.collision_restitution = world.get_collision_restitution();
+        settings.integrator = static_cast<std::uint32_t>(world.get_integrator());
+        settings.max_time_step_level = world.get_max_time_step_level();
+        settings.time_step_accuracy = world.get_time_step_accuracy();
+        settings.boundary_mode = static_cast<std::uint32_t>(world.get_boundary_mode());
+        settings.bounds[0] = world.get_bounds_min().x;
+        settings.bounds[1] = world.get_bounds_min().y;
+        settings.bounds[2] = world.get_bounds_max().x;
+        settings.bounds[3] = world.get_bounds_max().y;
+        settings.obstacle_restitution = world.get_obstacle_restitution();
+        return settings;
+    }
+
+    /**
+     * @brief   Gives a world the settings returned by get_settings().
+     */
+    template <typename T>
+    void set_settings(BasicWorld<T> &world, const BasicReplaySettings<T> &settings)
+    {
+        world.set_particle_limit(settings.particle_limit);
+        world.set_gravity_solver(static_cast<GravitySolver>(settings.gravity_solver));
+        world.set_barnes_hut_theta(settings.barnes_hut_theta);
+        world.set_particle_self_gravity(settings.particle_self_gravity);
+        world.set_particle_collisions(settings.particle_collisions);
+        world.set_collision_restitution(settings.collision_restitution);
+        world.set_integrator(static_cast<Integrator>(settings.integrator));
+        world.set_max_time_step_level(settings.max_time_step_level);
+        world.set_time_step_accuracy(settings.time_step_accuracy);
+        world.set_boundary_mode(static_cast<BoundaryMode>(settings.boundary_mode));
+        world.set_bounds(BasicVector2D<T>(settings.bounds[0], settings.bounds[1]),
+                         BasicVector2D<T>(settings.bounds[2], settings.bounds[3]));
+        world.set_obstacle_restitution(settings.obstacle_restitution);
+    }
+
+    /**
+     * @brief   Writes settings field by field, so that no padding ends up in the stream.
+     */
+    template <typename T>
+    void write_settings(SnapshotWriter &writer, const BasicReplaySettings<T> &settings)
+    {
+        writer.write_value(settings.particle_limit);
+        writer.write_value(settings.gravity_solver);
+        writer.write_value(settings.barnes_hut_theta);
+        writer.write_value(static_cast<std::uint8_t>(settings.particle_self_gravity));
+        writer.write_value(static_cast<std::uint8_t>(settings.particle_collisions));
+        writer.write_value(settings.collision_restitution);
+        writer.write_value(settings.integrator);
+        writer.write_value(settings.max_time_step_level);
+        writer.write_value(settings.time_step_accuracy);
+        writer.write_value(settings.boundary_mode);
+        for (T bound : settings.bounds) {
+            writer.write_value(bound);
+        }
+        writer.write_value(settings.obstacle_restitution);
+    }
+
+    /**
+     * @brief   Reads settings written by write_settings().
+     *
+     * @throws  std::runtime_error if the settings are malformed.
+     */
+    template <typename T>
+    BasicReplaySettings<T> read_settings(SnapshotReader &reader)
+    {
+        BasicReplaySettings<T> settings;
+        settings.particle_limit = reader.read_value<std::uint64_t>();
+        settings.gravity_solver = reader.read_value<std::uint32_t>();
+        settings.barnes_hut_theta = reader.read_value<T>();
+        settings.particle_self_gravity = reader.read_value<std::uint8_t>() != 0;
+        settings.particle_collisions = reader.read_value<std::uint8_t>() != 0;
+        settings.collision_restitution = reader.read_value<T>();
+        settings.integrator = reader.read_value<std::uint32_t>();
+        settings.max_time_step_level = reader.read_value<std::uint64_t>();
+        settings.time_step_accuracy = reader.read_value<T>();
+        settings.boundary_mode = reader.read_value<std::uint32_t>();
+        for (T &bound : settings.bounds) {
+            bound = reader.read_value<T>();
+        }
+        settings.obstacle_restitution = reader.read_value<T>();
+
+        if (settings.gravity_solver > static_cast<std::uint32_t>(GravitySolver::BARNES_HUT) ||
+            settings.integrator > static_cast<std::uint32_t>(Integrator::RUNGE_KUTTA_4) ||
+            settings.boundary_mode > static_cast<std::uint32_t>(BoundaryMode::KILL)) {
+            reader.fail("unknown gravity solver, integrator or boundary mode");
+        }
+        return settings;
+    }
+}  // namespace
+
+template <typename T>
+bool BasicReplaySettings<T>::operator==(const BasicReplaySettings &other) const
+{
+    return particle_limit == other.particle_limit && gravity_solver == other.gravity_solver &&
+           barnes_hut_theta == other.barnes_hut_theta &&
+           particle_self_gravity == other.particle_self_gravity &&
+           particle_collisions == other.particle_collisions &&
+           collision_restitution == other.collision_restitution &&
+           integrator == other.integrator && max_time_step_level == other.max_time_step_level &&
+           time_step_accuracy == other.time_step_accuracy && boundary_mode == other.boundary_mode &&
+           bounds[0] == other.bounds[0] && bounds[1] == other.bounds[1] &&
+           bounds[2] == other.bounds[2] && bounds[3] == other.bounds[3] &&
+           obstacle_restitution == other.obstacle_restitution;
+}
+
+template <typename T>
+BasicReplayRecorder<T>::BasicReplayRecorder(BasicWorld<T> &world, const std::string &path,
+                                            std::size_t hash_interval)
+    : world_(world),
+      writer_(path, sizeof(T)),
+      hash_interval_(hash_interval),
+      step_count_(0),
+      time_step_(world.get_time_step()),
+      settings_(get_settings(world))
+{
+    // Refuses gravity objects of unknown classes, so the comparisons only meet the known ones.
+    world_.save_snapshot(writer_);
+
+    for (std::size_t i = 0; i < world_.get_gravity_object_count(); i++) {
+        gravity_.push_back(get_gravity_state(*world_.get_gravity_object(i)));
+    }
+
+    world_.set_observer(this);
+}
+
+template <typename T>
+BasicReplayRecorder<T>::~BasicReplayRecorder(void)
+{
+    if (world_.get_observer() == this) {
+        world_.set_observer(nullptr);
+    }
+}
+
+template <typename T>
+void BasicReplayRecorder<T>::finish(void)
+{
+    if (world_.get_observer() == this) {
+        world_.set_observer(nullptr);
+    }
+
+    // A closing hash covers the steps since the last one, so that every replay ends verified.
+    record_settings();
+    record_spawned_particles();
+    if (hash_interval_ > 0 && step_count_ % hash_interval_ != 0) {
+        writer_.write_value(ReplayRecord::HASH);
+        writer_.write_value(world_.get_state_hash());
+    }
+
+    writer_.finish();
+}
+
+template <typename T>
+std::size_t BasicReplayRecorder<T>::get_step_count(void) const { return step_count_; }
+
+template <typename T>
+void BasicReplayRecorder<T>::particle_spawned(ParticleHandle handle, BasicVector2D<T> position,
+                                              BasicVector2D<T> velocity, T mass)
+{
+    // The particle limit decides whether the spawn succeeds, a new one is replayed before it.
+    record_settings();
+
+    writer_.write_value(ReplayRecord::SPAWN);
+    writer_.write_value(position.x);
+    writer_.write_value(position.y);
+    writer_.write_value(velocity.x);
+    writer_.write_value(velocity.y);
+    writer_.write_value(mass);
+
+    spawned_.push_back(handle);
+}
+
+template <typename T>
+void BasicReplayRecorder<T>::particle_killed(ParticleHandle handle)
+{
+    record_settings();
+
+    writer_.write_value(ReplayRecord::KILL);
+    writer_.write_value(handle);
+}
+
+template <typename T>
+void BasicReplayRecorder<T>::step_starting(void)
+{
+    record_settings();
+    record_spawned_particles();
+
+    if (world_.get_time_step() != time_step_) {
+        time_step_ = world_.get_time_step();
+        writer_.write_value(ReplayRecord::TIME_STEP);
+        writer_.write_value(time_step_);
+    }
+
+    record_gravity_objects();
+
+    writer_.write_value(ReplayRecord::STEP);
+}
+
+template <typename T>
+void BasicReplayRecorder<T>::step_finished(void)
+{
+    step_count_++;
+
+    if (hash_interval_ > 0 && step_count_ % hash_interval_ == 0) {
+        writer_.write_value(ReplayRecord::HASH);
+        writer_.write_value(world_.get_state_hash());
+        writer_.flush();
+    }
+}
+
+template <typename T>
+void BasicReplayRecorder<T>::record_settings(void)
+{
+    const BasicReplaySettings<T> settings = get_settings(world_);
+    if (!(settings == settings_)) {
+        settings_ = settings;
+        writer_.write_value(ReplayRecord::SETTINGS);
+        write_settings(writer_, settings_);
+    }
+}
+
+template <typename T>
+void BasicReplayRecorder<T>::record_spawned_particles(void)
+{
+    // The particles spawned since the last step may have been changed through their views since,
+    // their whole state is recorded now that it is final. Killed ones are replayed as killed.
+    const BasicParticlePool<T> &pool = world_.get_particle_pool();
+    const BasicParticleStore<T> &store = pool.get_store();
+    for (ParticleHandle handle : spawned_) {
+        if (pool.is_valid(handle)) {
+            const std::size_t index = pool.get_index(handle);
+            writer_.write_value(ReplayRecord::PARTICLE);
+            writer_.write_value(handle);
+            for (ParticleArray<T> array : get_particle_arrays<T>()) {
+                writer_.write_value((store.*array)[index]);
+            }
+        }
+    }
+    spawned_.clear();
+}
+
+template <typename T>
+void BasicReplayRecorder<T>::record_gravity_objects(void)
+{
+    const std::size_t known_count = gravity_.size();
+    for (std::size_t i = known_count; i < world_.get_gravity_object_count(); i++) {
+        const BasicGravityObject<T> &object = *world_.get_gravity_object(i);
+        const std::type_info &type = typeid(object);
+        if (type == typeid(BasicGravityObject<T>)) {
+            writer_.write_value(ReplayRecord::GRAVITY_OBJECT_ADDED);
+        }
+        else if (type == typeid(BasicGravityConstant<T>)) {
+            writer_.write_value(ReplayRecord::GRAVITY_CONSTANT_ADDED);
+        }
+        else {
+            writer_.fail("cannot record a gravity object of an unknown class");
+        }
+        gravity_.emplace_back();
+    }
+
+    // The replay adds the new objects default constructed, their states are always recorded.
+    for (std::size_t i = 0; i < gravity_.size(); i++) {
+        const std::array<T, 8> state = get_gravity_state(*world_.get_gravity_object(i));
+        if (i >= known_count || state != gravity_[i]) {
+            gravity_[i] = state;
+            writer_.write_value(ReplayRecord::GRAVITY_STATE);
+            writer_.write_value(static_cast<std::uint32_t>(i));
+            writer_.write_value(state);
+        }
+    }
+}
+
+template <typename T>
+BasicReplayPlayer<T>::BasicReplayPlayer(const std::string &path, BasicWorld<T> &world)
+    : path_(path), world_(world), reader_(path, sizeof(T)), step_count_(0), verified_hash_count_(0)
+{
+    world_.load_snapshot(reader_);
+}
+
+template <typename T>
+bool BasicReplayPlayer<T>::step(void)
+{
+    while (!reader_.is_at_end()) {
+        switch (reader_.read_value<ReplayRecord>()) {
+            case ReplayRecord::SPAWN: {
+                const T x = reader_.read_value<T>();
+                const T y = reader_.read_value<T>();
+                const T vx = reader_.read_value<T>();
+                const T vy = reader_.read_value<T>();
+                const T mass = reader_.read_value<T>();
+                world_.spawn_particle(BasicVector2D<T>(x, y), BasicVector2D<T>(vx, vy), mass);
+                break;
+            }
+            case ReplayRecord::KILL:
+                world_.kill_particle(reader_.read_value<ParticleHandle>());
+                break;
+            case ReplayRecord::PARTICLE: {
+                BasicParticlePool<T> &pool = world_.get_particle_pool();
+                const ParticleHandle handle = reader_.read_value<ParticleHandle>();
+                if (!pool.is_valid(handle)) {
+                    reader_.fail("recorded particle does not exist in the replay");
+                }
+
+                const std::size_t index = pool.get_index(handle);
+                BasicParticleStore<T> &store = pool.get_store();
+                for (ParticleArray<T> array : get_particle_arrays<T>()) {
+                    (store.*array)[index] = reader_.read_value<T>();
+                }
+                break;
+            }
+            case ReplayRecord::TIME_STEP:
+                world_.set_time_step(reader_.read_value<T>());
+                break;
+            case ReplayRecord::SETTINGS:
+                set_settings(world_, read_settings<T>(reader_));
+                break;
+            case ReplayRecord::GRAVITY_OBJECT_ADDED:
+                world_.add_gravity_object(
+                    std::make_unique<BasicGravityObject<T>>(BasicVector2D<T>()));
+                break;
+            case ReplayRecord::GRAVITY_CONSTANT_ADDED:
+                world_.add_gravity_object(std::make_unique<BasicGravityConstant<T>>());
+                break;
+            case ReplayRecord::GRAVITY_STATE: {
+                const std::uint32_t index = reader_.read_value<std::uint32_t>();
+                const std::array<T, 8> state = reader_.read_value<std::array<T, 8>>();
+                if (index >= world_.get_gravity_object_count()) {
+                    reader_.fail("recorded gravity object does not exist in the replay");
+                }
+                set_gravity_state(*world_.get_gravity_object(index), state);
+                break;
+            }
+            case ReplayRecord::STEP:
+                world_.step();
+                step_count_++;
+                return true;
+            case ReplayRecord::HASH:
+                if (reader_.read_value<std::uint64_t>() != world_.get_state_hash()) {
+                    throw std::runtime_error(path_ + ": diverged from the recording at step " +
+                                             std::to_string(step_count_));
+                }
+                verified_hash_count_++;
+                break;
+            default:
+                reader_.fail("unknown replay record");
+        }
+    }
+
+    return false;
+}
+
+template <typename T>
+std::size_t BasicReplayPlayer<T>::get_step_count(void) const { return step_count_; }
+
+template <typename T>
+std::size_t BasicReplayPlayer<T>::get_verified_hash_count(void) const
+{
+    return verified_hash_count_;
+}
+
+// Explicitly instantiate all the supported precisions
+template struct BasicReplaySettings<float>;
+template struct BasicReplaySettings<double>;
+template class BasicReplayRecorder<float>;
+template class BasicReplayRecorder<double>;
+template class BasicReplayPlayer<float>;
+template class BasicReplayPlayer<double>;
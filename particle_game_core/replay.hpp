@@ -0,0 +1,292 @@
+/**
+ * @file    replay.hpp
+ * @author  Martin Cagas
+ *
+ * @brief   Recording and deterministic replaying of the inputs of a game world.
+ *
+ * @section DESCRIPTION
+ *
+ * A replay stream is a snapshot of the world at the start of the recording, see snapshot.hpp,
+ * followed by a record for every input the world received since, in the order it received them.
+ * Every record starts with a byte identifying its kind:
+ * - a spawn through World::spawn_particle(), with its position, velocity and mass,
+ * - a kill through World::kill_particle(), with the handle,
+ * - the whole state of every particle spawned since the last step, recorded at the start of the
+ *   next step, so that changes made through a ParticleView right after spawning are replayed too,
+ * - a new time step,
+ * - the settings of the world, whenever they changed before a spawn, a kill or a step, see
+ *   ReplaySettings,
+ * - a gravity object added to the world,
+ * - the whole state of a gravity object that changed since the last step, e.g. by enable(),
+ *   disable() or the setters of GravityConstant,
+ * - a step,
+ * - a hash of the state of the particles, every few steps and at the end of the recording.
+ *
+ * The state of the simulation follows from these inputs, so a replay steps an identical world
+ * through the same inputs and compares the hashes to catch the first divergence. Steps without
+ * inputs cost a single byte of the stream and the hashes a few bytes each, so a recording of a
+ * whole session stays small and can be left on in production builds.
+ *
+ * Only the inputs given through the world are recorded. Changes made directly to the particle
+ * pool, to particles older than a step, to the emitters or to the obstacles are not, and are caught
+ * by the next hash check as a divergence. Only gravity objects of the classes of this library can
+ * be recorded. Neither are the thread count and the deterministic splitting, which the player sets
+ * up on its own, nor the grid cell size, which does not change the state of the particles.
+ */
+
+#pragma once
+
+// Standard includes
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Local includes
+#include "snapshot.hpp"
+#include "world.hpp"
+#include "world_observer.hpp"
+
+/**
+ * @brief   Settings of a game world recorded whenever they change, except the time step.
+ *
+ * @details
+ *
+ * The enumerations are held as their underlying values, so the settings read from a stream can be
+ * checked before they are applied.
+ */
+template <typename T>
+struct BasicReplaySettings
+{
+    std::uint64_t particle_limit;       ///< Maximum amount of particles.
+    std::uint32_t gravity_solver;       ///< GravitySolver of the particles.
+    T barnes_hut_theta;                 ///< Opening angle of the Barnes-Hut tree.
+    bool particle_self_gravity;         ///< True if the particles attract each other.
+    bool particle_collisions;           ///< True if the particles collide with each other.
+    T collision_restitution;            ///< Restitution of the collisions between particles.
+    std::uint32_t integrator;           ///< Integrator of the particles.
+    std::uint64_t max_time_step_level;  ///< Deepest level of the block time steps.
+    T time_step_accuracy;               ///< Accuracy of the block time steps.
+    std::uint32_t boundary_mode;        ///< BoundaryMode of the world.
+    T bounds[4];                        ///< Lowest and highest corners of the bounds.
+    T obstacle_restitution;             ///< Restitution of the bounces off the obstacles.
+
+    /**
+     * @brief   Returns true if all the settings are equal, false otherwise.
+     */
+    bool operator==(const BasicReplaySettings &other) const;
+};
+
+/**
+ * @class   BasicReplayRecorder
+ *
+ * @brief   Records the inputs of a game world into a replay stream.
+ *
+ * @section DESCRIPTION
+ *
+ * The recorder saves the world into the stream and attaches itself as the observer of the world
+ * on construction. From then on, every input is appended to the stream as it happens. The changes
+ * of the settings are picked up before every input and every step, the changes of the gravity
+ * objects at the start of every step, by comparing them with their last recorded states. The
+ * stream is handed over to the operating system after every hash, so a crash loses at most the
+ * last few steps.
+ *
+ * The recorder must outlive its recording, it detaches itself from the world when destroyed or
+ * finished.
+ *
+ * @section USAGE
+ *
+ * @code
+ *
+ * ReplayRecorderF recorder(world, "session.replay");
+ *
+ * world.spawn_particle(Point2DF(0.0f, 0.0f), Vector2DF(1.0f, 0.0f));
+ * world.step();
+ *
+ * recorder.finish();
+ *
+ * @endcode
+ */
+template <typename T>
+class BasicReplayRecorder : public BasicWorldObserver<T>
+{
+public:
+    /**
+     * @brief   Constructor, saves the world and starts recording its inputs.
+     *
+     * @param   &world          The recorded world.
+     * @param   &path           Path of the stream, an existing file is overwritten.
+     * @param   hash_interval   Amount of steps between the hashes of the state, 0 for none.
+     *
+     * @throws  std::runtime_error if the stream cannot be written or the world cannot be saved.
+     */
+    BasicReplayRecorder(BasicWorld<T> &world, const std::string &path,
+                        std::size_t hash_interval = 60);
+
+    /**
+     * @brief   Destructor, detaches the recorder from the world.
+     */
+    ~BasicReplayRecorder(void);
+
+    BasicReplayRecorder(const BasicReplayRecorder &) = delete;
+    BasicReplayRecorder &operator=(const BasicReplayRecorder &) = delete;
+
+    /**
+     * @brief   Stops recording, records a closing hash and closes the stream.
+     *
+     * @throws  std::runtime_error if the stream cannot be written.
+     */
+    void finish(void);
+
+    /**
+     * @brief   Returns the amount of steps recorded so far.
+     */
+    std::size_t get_step_count(void) const;
+
+    /**
+     * @brief   Records a spawn.
+     */
+    void particle_spawned(ParticleHandle handle, essentials::BasicVector2D<T> position,
+                          essentials::BasicVector2D<T> velocity, T mass);
+
+    /**
+     * @brief   Records a kill.
+     */
+    void particle_killed(ParticleHandle handle);
+
+    /**
+     * @brief   Records the changes since the last step and the step itself.
+     */
+    void step_starting(void);
+
+    /**
+     * @brief   Records the hash of the state every hash_interval_ steps.
+     */
+    void step_finished(void);
+
+protected:
+    /**
+     * @brief   Records the settings of the world if they changed since they were last recorded.
+     */
+    void record_settings(void);
+
+    /**
+     * @brief   Records the final states of the particles spawned since the last step.
+     */
+    void record_spawned_particles(void);
+
+    /**
+     * @brief   Records the gravity objects added since the last step and the changed ones.
+     *
+     * @throws  std::runtime_error if a gravity object of an unknown class has been added.
+     */
+    void record_gravity_objects(void);
+
+    BasicWorld<T> &world_;                   ///< The recorded world.
+    SnapshotWriter writer_;                  ///< Writer of the stream.
+    std::size_t hash_interval_;              ///< Amount of steps between the hashes, 0 for none.
+    std::size_t step_count_;                 ///< Amount of steps recorded so far.
+    T time_step_;                            ///< Time step of the last recorded step.
+    std::vector<ParticleHandle> spawned_;    ///< Particles spawned since the last step.
+    std::vector<std::array<T, 8>> gravity_;  ///< States of the gravity objects at the last step.
+    BasicReplaySettings<T> settings_;        ///< Settings of the world at the last step.
+};
+
+/**
+ * @class   BasicReplayPlayer
+ *
+ * @brief   Replays the inputs of a replay stream and verifies the state of the world.
+ *
+ * @section DESCRIPTION
+ *
+ * The player loads the state at the start of the recording into a world on construction. Every
+ * call of step() then applies the inputs up to the next recorded step, runs it and compares the
+ * state of the world with every hash met on the way. The world has to run in the same precision
+ * as the recorded one, with deterministic splitting turned on for both when the results depend on
+ * it, see JobSystem.
+ *
+ * @section USAGE
+ *
+ * @code
+ *
+ * WorldF world;
+ * ReplayPlayerF player("session.replay", world);
+ *
+ * while (player.step()) {
+ * }
+ *
+ * @endcode
+ */
+template <typename T>
+class BasicReplayPlayer
+{
+public:
+    /**
+     * @brief   Constructor, loads the state at the start of the recording into a world.
+     *
+     * @param   &path       Path of the stream.
+     * @param   &world      The world to replay the stream in.
+     *
+     * @throws  std::runtime_error if the stream cannot be read or does not start with a valid
+     *          snapshot of a world of the same precision.
+     */
+    BasicReplayPlayer(const std::string &path, BasicWorld<T> &world);
+
+    /**
+     * @brief   Replays the inputs up to the next step and the step itself.
+     *
+     * @return  True if a step was replayed, false at the end of the stream.
+     *
+     * @throws  std::runtime_error if the stream is malformed or the state of the world differs
+     *          from a recorded hash.
+     */
+    bool step(void);
+
+    /**
+     * @brief   Returns the amount of steps replayed so far.
+     */
+    std::size_t get_step_count(void) const;
+
+    /**
+     * @brief   Returns the amount of hashes verified so far.
+     */
+    std::size_t get_verified_hash_count(void) const;
+
+protected:
+    std::string path_;                 ///< Path of the stream.
+    BasicWorld<T> &world_;             ///< The world the stream is replayed in.
+    SnapshotReader reader_;            ///< Reader of the stream.
+    std::size_t step_count_;           ///< Amount of steps replayed so far.
+    std::size_t verified_hash_count_;  ///< Amount of hashes verified so far.
+};
+
+/**
+ * @brief   Settings of double precision game worlds.
+ */
+typedef BasicReplaySettings<double> ReplaySettings;
+
+/**
+ * @brief   Settings of single precision game worlds.
+ */
+typedef BasicReplaySettings<float> ReplaySettingsF;
+
+/**
+ * @brief   Recorder of double precision game worlds.
+ */
+typedef BasicReplayRecorder<double> ReplayRecorder;
+
+/**
+ * @brief   Recorder of single precision game worlds.
+ */
+typedef BasicReplayRecorder<float> ReplayRecorderF;
+
+/**
+ * @brief   Player of replay streams of double precision game worlds.
+ */
+typedef BasicReplayPlayer<double> ReplayPlayer;
+
+/**
+ * @brief   Player of replay streams of single precision game worlds.
+ */
+typedef BasicReplayPlayer<float> ReplayPlayerF;
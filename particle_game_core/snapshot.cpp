@@ -0,0 +1,135 @@
+/**
+ * @file    snapshot.cpp
+ * @author  Martin Cagas
+ *
+ * @brief   Binary snapshot files holding the whole state of a game world.
+ */
+
+#include "snapshot.hpp"
+
+// Standard includes
+#include <limits>
+#include <stdexcept>
+
+/**
+ * @brief   Magic bytes every snapshot starts with.
+ */
+static const char SNAPSHOT_MAGIC[8] = {'P', 'G', 'S', 'N', 'A', 'P', 'S', 'H'};
+
+/**
+ * @brief   Throws if the host cannot read or write snapshots as raw bytes.
+ */
+static void check_host(const std::string &path)
+{
+    static_assert(std::numeric_limits<float>::is_iec559 && std::numeric_limits<double>::is_iec559,
+                  "Snapshots store IEEE floating point numbers");
+
+    const std::uint32_t probe = 1;
+    unsigned char first_byte = 0;
+    std::memcpy(&first_byte, &probe, 1);
+    if (first_byte != 1) {
+        throw std::runtime_error(path + ": snapshots are only supported on little-endian hosts");
+    }
+}
+
+SnapshotWriter::SnapshotWriter(const std::string &path, std::uint32_t scalar_size)
+    : path_(path), file_(nullptr), size_(0)
+{
+    check_host(path_);
+
+    file_ = std::fopen(path_.c_str(), "wb");
+    if (file_ == nullptr) {
+        throw std::runtime_error("Cannot open snapshot " + path_);
+    }
+
+    write(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    write_value(SNAPSHOT_VERSION);
+    write_value(scalar_size);
+}
+
+SnapshotWriter::~SnapshotWriter(void)
+{
+    if (file_ != nullptr) {
+        std::fclose(file_);
+    }
+}
+
+void SnapshotWriter::flush(void)
+{
+    if (std::fflush(file_) != 0) {
+        throw std::runtime_error("Cannot write snapshot " + path_);
+    }
+}
+
+void SnapshotWriter::finish(void)
+{
+    const bool failed = std::ferror(file_) != 0;
+    const bool closed = std::fclose(file_) == 0;
+    file_ = nullptr;
+
+    if (failed || !closed) {
+        throw std::runtime_error("Cannot write snapshot " + path_);
+    }
+}
+
+void SnapshotWriter::fail(const char *reason) const
+{
+    throw std::runtime_error(path_ + ": " + reason);
+}
+
+void SnapshotWriter::write(const void *data, std::size_t size)
+{
+    if (size > 0 && std::fwrite(data, 1, size, file_) != size) {
+        throw std::runtime_error("Cannot write snapshot " + path_);
+    }
+    size_ += size;
+}
+
+void SnapshotWriter::pad(void)
+{
+    static const unsigned char ZEROES[SNAPSHOT_ALIGNMENT] = {};
+    write(ZEROES, (SNAPSHOT_ALIGNMENT - size_ % SNAPSHOT_ALIGNMENT) % SNAPSHOT_ALIGNMENT);
+}
+
+SnapshotReader::SnapshotReader(const std::string &path, std::uint32_t scalar_size)
+    : path_(path), file_(path), offset_(0)
+{
+    check_host(path_);
+
+    if (file_.get_size() < sizeof(SNAPSHOT_MAGIC) ||
+        std::memcmp(read(sizeof(SNAPSHOT_MAGIC)), SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) {
+        fail("not a snapshot");
+    }
+    if (read_value<std::uint32_t>() != SNAPSHOT_VERSION) {
+        fail("unsupported snapshot version");
+    }
+    if (read_value<std::uint32_t>() != scalar_size) {
+        fail("snapshot of another precision");
+    }
+}
+
+bool SnapshotReader::is_at_end(void) const
+{
+    return offset_ == file_.get_size();
+}
+
+void SnapshotReader::fail(const char *reason) const
+{
+    throw std::runtime_error(path_ + ": " + reason);
+}
+
+const unsigned char *SnapshotReader::read(std::size_t size)
+{
+    if (size > file_.get_size() - offset_) {
+        fail("truncated snapshot");
+    }
+
+    const unsigned char *data = file_.get_data() + offset_;
+    offset_ += size;
+    return data;
+}
+
+void SnapshotReader::skip_padding(void)
+{
+    read((SNAPSHOT_ALIGNMENT - offset_ % SNAPSHOT_ALIGNMENT) % SNAPSHOT_ALIGNMENT);
+}
@@ -0,0 +1,272 @@
+/**
+ * @file    snapshot.hpp
+ * @author  Martin Cagas
+ *
+ * @brief   Binary snapshot files holding the whole state of a game world.
+ *
+ * @section DESCRIPTION
+ *
+ * A snapshot is a flat binary file in little-endian byte order. It starts with a header made of
+ * the magic bytes "PGSNAPSH", the 32-bit version of the format and the 32-bit size of the scalars
+ * of the world, 4 for single and 8 for double precision. The header is followed by the state of
+ * the world as a sequence of records, read back in the same order they were written. A replay
+ * stream, see replay.hpp, continues with the recorded inputs in the same encoding:
+ * - a value is stored as its raw bytes,
+ * - an array is stored as its 64-bit element count, padded up to the next multiple of
+ *   SNAPSHOT_ALIGNMENT bytes, followed by the raw bytes of its elements.
+ *
+ * The snapshot is read through a MappedFile. Thanks to the padding, every array lies aligned in the
+ * mapping, exactly as it lies in the particle store, so loading it is a single bulk copy with no
+ * per-particle parsing, bound by the memory bandwidth rather than by the parsing.
+ *
+ * The format only supports hosts with little-endian byte order and IEEE floating point numbers,
+ * which are all the platforms the game runs on. Both the writer and the reader refuse to work on
+ * any other host instead of producing or reading garbage.
+ */
+
+#pragma once
+
+// Standard includes
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+// "Game essentials" library includes
+#include <mapped_file.hpp>
+
+/**
+ * @brief   Version of the snapshot format written by SnapshotWriter.
+ */
+static constexpr std::uint32_t SNAPSHOT_VERSION = 3;
+
+/**
+ * @brief   Alignment of the elements of the arrays within a snapshot, in bytes.
+ */
+static constexpr std::size_t SNAPSHOT_ALIGNMENT = 64;
+
+/**
+ * @class   SnapshotWriter
+ *
+ * @brief   Writes a snapshot file record by record.
+ *
+ * @section DESCRIPTION
+ *
+ * The header is written on construction, the records follow as they are written. Every array is
+ * written with a single call, so saving costs a few large writes rather than one per particle.
+ * The file is only complete after finish(), a writer destroyed without it leaves a truncated file
+ * behind, which the reader rejects.
+ *
+ * @section USAGE
+ *
+ * @code
+ *
+ * SnapshotWriter writer("world.snapshot", sizeof(float));
+ *
+ * writer.write_value(time_step);
+ * writer.write_array(store.x.data(), count);
+ * writer.finish();
+ *
+ * @endcode
+ */
+class SnapshotWriter
+{
+public:
+    /**
+     * @brief   Constructor, creates the file and writes the header.
+     *
+     * @param   &path           Path of the file, an existing file is overwritten.
+     * @param   scalar_size     Size of the scalars of the world in bytes.
+     *
+     * @throws  std::runtime_error if the file cannot be written or the host is not little-endian.
+     */
+    SnapshotWriter(const std::string &path, std::uint32_t scalar_size);
+
+    /**
+     * @brief   Destructor, closes the file if finish() has not done so.
+     */
+    ~SnapshotWriter(void);
+
+    SnapshotWriter(const SnapshotWriter &) = delete;
+    SnapshotWriter &operator=(const SnapshotWriter &) = delete;
+
+    /**
+     * @brief   Writes a single value.
+     *
+     * @throws  std::runtime_error if the file cannot be written.
+     */
+    template <typename V>
+    void write_value(V value)
+    {
+        static_assert(std::is_trivially_copyable<V>::value, "Values are written as raw bytes");
+        write(&value, sizeof(V));
+    }
+
+    /**
+     * @brief   Writes an array.
+     *
+     * @param   *data       The elements.
+     * @param   count       Amount of elements.
+     *
+     * @throws  std::runtime_error if the file cannot be written.
+     */
+    template <typename V>
+    void write_array(const V *data, std::size_t count)
+    {
+        static_assert(std::is_trivially_copyable<V>::value, "Arrays are written as raw bytes");
+        write_value(static_cast<std::uint64_t>(count));
+        pad();
+        write(data, count * sizeof(V));
+    }
+
+    /**
+     * @brief   Hands the records written so far over to the operating system.
+     *
+     * @details
+     *
+     * The records then survive a crash of the process, which matters for files written
+     * continuously, such as the replay streams.
+     *
+     * @throws  std::runtime_error if the file cannot be written.
+     */
+    void flush(void);
+
+    /**
+     * @brief   Flushes and closes the file.
+     *
+     * @throws  std::runtime_error if the file cannot be written.
+     */
+    void finish(void);
+
+    /**
+     * @brief   Throws an exception describing a state that cannot be saved.
+     *
+     * @param   *reason     Why the state cannot be saved.
+     *
+     * @throws  std::runtime_error always.
+     */
+    [[noreturn]] void fail(const char *reason) const;
+
+protected:
+    /**
+     * @brief   Writes raw bytes.
+     */
+    void write(const void *data, std::size_t size);
+
+    /**
+     * @brief   Writes zeroes up to the next multiple of SNAPSHOT_ALIGNMENT bytes.
+     */
+    void pad(void);
+
+    std::string path_;    ///< Path of the file.
+    std::FILE *file_;     ///< The file, null once finished.
+    std::uint64_t size_;  ///< Amount of bytes written so far.
+};
+
+/**
+ * @class   SnapshotReader
+ *
+ * @brief   Reads a snapshot file record by record.
+ *
+ * @section DESCRIPTION
+ *
+ * The file is mapped and its header checked on construction. Values are copied out of the mapping,
+ * arrays are returned as pointers into it, valid for the lifetime of the reader. Every read is
+ * checked against the end of the file.
+ *
+ * @section USAGE
+ *
+ * @code
+ *
+ * SnapshotReader reader("world.snapshot", sizeof(float));
+ *
+ * float time_step = reader.read_value<float>();
+ * const float *x = reader.read_array<float>(count);
+ *
+ * @endcode
+ */
+class SnapshotReader
+{
+public:
+    /**
+     * @brief   Constructor, maps the file and checks its header.
+     *
+     * @param   &path           Path of the file.
+     * @param   scalar_size     Size of the scalars of the world the snapshot is loaded into.
+     *
+     * @throws  std::runtime_error if the file cannot be read, is not a snapshot, has an unsupported
+     *          version or another precision, or if the host is not little-endian.
+     */
+    SnapshotReader(const std::string &path, std::uint32_t scalar_size);
+
+    /**
+     * @brief   Reads a single value.
+     *
+     * @throws  std::runtime_error if the file ends before the value.
+     */
+    template <typename V>
+    V read_value(void)
+    {
+        static_assert(std::is_trivially_copyable<V>::value, "Values are read as raw bytes");
+        V value;
+        std::memcpy(&value, read(sizeof(V)), sizeof(V));
+        return value;
+    }
+
+    /**
+     * @brief   Reads an array of a known amount of elements.
+     *
+     * @param   count       Amount of elements the array must have.
+     *
+     * @return  The elements, aligned to SNAPSHOT_ALIGNMENT bytes within the mapping.
+     *
+     * @throws  std::runtime_error if the array has another amount of elements or the file ends
+     *          before its last element.
+     */
+    template <typename V>
+    const V *read_array(std::size_t count)
+    {
+        static_assert(std::is_trivially_copyable<V>::value, "Arrays are read as raw bytes");
+        if (read_value<std::uint64_t>() != count) {
+            fail("unexpected array size");
+        }
+        skip_padding();
+
+        // Checked before multiplying, a corrupt count would wrap the size around.
+        if (count > (file_.get_size() - offset_) / sizeof(V)) {
+            fail("truncated snapshot");
+        }
+        return reinterpret_cast<const V *>(read(count * sizeof(V)));
+    }
+
+    /**
+     * @brief   Returns whether all the records of the file have been read.
+     */
+    bool is_at_end(void) const;
+
+    /**
+     * @brief   Throws an exception describing a malformed snapshot.
+     *
+     * @param   *reason     What is wrong with the snapshot.
+     *
+     * @throws  std::runtime_error always.
+     */
+    [[noreturn]] void fail(const char *reason) const;
+
+protected:
+    /**
+     * @brief   Returns the next raw bytes of the file and moves past them.
+     */
+    const unsigned char *read(std::size_t size);
+
+    /**
+     * @brief   Moves to the next multiple of SNAPSHOT_ALIGNMENT bytes.
+     */
+    void skip_padding(void);
+
+    std::string path_;             ///< Path of the file.
+    essentials::MappedFile file_;  ///< The mapped file.
+    std::size_t offset_;           ///< Offset of the next record.
+};
@@ -0,0 +1,93 @@
+/**
+ * @file    spatial_grid.cpp
+ * @author  Martin Cagas
+ *
+ * @brief   Uniform grid answering neighbourhood queries over many points.
+ */
+
+#include "spatial_grid.hpp"
+
+// Standard includes
+#include <algorithm>
+
+template <typename T>
+BasicSpatialGrid<T>::BasicSpatialGrid(void)
+    : cell_size_(1.0), inverse_cell_size_(1.0), size_(0), bucket_mask_(0), bucket_starts_(2, 0)
+{
+}
+
+template <typename T>
+void BasicSpatialGrid<T>::set_cell_size(T cell_size) { cell_size_ = cell_size; }
+
+template <typename T>
+T BasicSpatialGrid<T>::get_cell_size(void) const { return cell_size_; }
+
+template <typename T>
+void BasicSpatialGrid<T>::build(const T *x, const T *y, std::size_t count)
+{
+    inverse_cell_size_ = T(1) / cell_size_;
+    size_ = count;
+
+    // About two buckets per point keeps the amount of cells sharing a bucket low.
+    std::size_t bucket_count = 16;
+    while (bucket_count < 2 * count) {
+        bucket_count *= 2;
+    }
+    bucket_mask_ = bucket_count - 1;
+
+    bucket_starts_.assign(bucket_count + 1, 0);
+    point_buckets_.resize(count);
+    indices_.resize(count);
+    entry_x_.resize(count);
+    entry_y_.resize(count);
+    entry_cell_x_.resize(count);
+    entry_cell_y_.resize(count);
+
+    for (std::size_t i = 0; i < count; i++) {
+        std::size_t bucket = bucket_of(cell_coordinate(x[i]), cell_coordinate(y[i]));
+        point_buckets_[i] = static_cast<std::uint32_t>(bucket);
+        bucket_starts_[bucket]++;
+    }
+
+    // Turn the counts into the ends of the buckets...
+    for (std::size_t b = 1; b < bucket_count; b++) {
+        bucket_starts_[b] += bucket_starts_[b - 1];
+    }
+    bucket_starts_[bucket_count] = static_cast<std::uint32_t>(count);
+
+    // ...and fill the buckets back to front, which leaves the starts behind and keeps the points of
+    // a bucket in their original order.
+    for (std::size_t i = count; i-- > 0;) {
+        std::size_t k = --bucket_starts_[point_buckets_[i]];
+        indices_[k] = static_cast<std::uint32_t>(i);
+        entry_x_[k] = x[i];
+        entry_y_[k] = y[i];
+        entry_cell_x_[k] = cell_coordinate(x[i]);
+        entry_cell_y_[k] = cell_coordinate(y[i]);
+    }
+}
+
+template <typename T>
+std::size_t BasicSpatialGrid<T>::get_size(void) const { return size_; }
+
+template <typename T>
+std::int32_t BasicSpatialGrid<T>::cell_coordinate(T position) const
+{
+    // Clamped, so that far away points share the outermost cells instead of overflowing.
+    const T limit = T(1 << 30);
+    T cell = std::floor(position * inverse_cell_size_);
+    return static_cast<std::int32_t>(std::min(std::max(cell, -limit), limit));
+}
+
+template <typename T>
+std::size_t BasicSpatialGrid<T>::bucket_of(std::int32_t cell_x, std::int32_t cell_y) const
+{
+    // Only the rows are scattered, the cells of a row follow each other.
+    std::uint32_t hash =
+        static_cast<std::uint32_t>(cell_y) * 19349663u + static_cast<std::uint32_t>(cell_x);
+    return hash & bucket_mask_;
+}
+
+// Explicitly instantiate all the supported precisions
+template class BasicSpatialGrid<float>;
+template class BasicSpatialGrid<double>;
@@ -0,0 +1,306 @@
+/**
+ * @file    spatial_grid.hpp
+ * @author  Martin Cagas
+ *
+ * @brief   Uniform grid answering neighbourhood queries over many points.
+ */
+
+#pragma once
+
+// Standard includes
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+// "Game essentials" library includes
+#include <vector2d.hpp>
+
+/**
+ * @class   BasicSpatialGrid
+ *
+ * @brief   Uniform grid answering neighbourhood queries over many points.
+ *
+ * @section DESCRIPTION
+ *
+ * The plane is divided into square cells of a fixed size. The cells are not stored as a dense
+ * array, instead every cell is hashed into one of a number of buckets proportional to the amount of
+ * points, so the grid covers an unbounded world with memory linear in the amount of points.
+ *
+ * Building the grid is a counting sort of the points by bucket: one pass counts the points per
+ * bucket, a prefix sum turns the counts into offsets and a second pass scatters the point indices
+ * (and copies of the positions, for cache-friendly queries) into their buckets. Both the build and
+ * the queries are linear in the amount of points involved. All memory is kept between the builds,
+ * so after the first few builds the grid does not allocate.
+ *
+ * Different cells may share a bucket, so the queries compare the cell coordinates of every entry
+ * and only report points inside the requested radius. Neighbouring cells of a row are hashed into
+ * consecutive buckets, so the queries scan the cells of a row as one contiguous range of entries
+ * rather than looking up every cell on its own.
+ *
+ * Queries report the indices the points had in the arrays given to build(), they are only
+ * meaningful until those arrays change order. SpatialGrid works in double precision and
+ * SpatialGridF in single precision.
+ *
+ * @section USAGE
+ *
+ * @code
+ *
+ * SpatialGrid grid;
+ *
+ * grid.set_cell_size(4.0);
+ * grid.build(x.data(), y.data(), x.size());
+ *
+ * grid.query_radius(Point2D(0.0, 0.0), 10.0, [&](std::size_t index) { picked.push_back(index); });
+ *
+ * grid.for_each_neighbor_pair(4.0, [&](std::size_t i, std::size_t j) { collide(i, j); });
+ *
+ * @endcode
+ */
+template <typename T>
+class BasicSpatialGrid
+{
+public:
+    /**
+     * @brief   Constructor.
+     *
+     * @details
+     *
+     * Initialises the cell size to 1.0.
+     */
+    BasicSpatialGrid(void);
+
+    /**
+     * @brief   cell_size_ setter.
+     *
+     * @details
+     *
+     * Takes effect with the next build.
+     *
+     * @param   cell_size   Length of the side of a cell, must be positive.
+     */
+    void set_cell_size(T cell_size);
+
+    /**
+     * @brief   cell_size_ getter.
+     */
+    T get_cell_size(void) const;
+
+    /**
+     * @brief   Rebuilds the grid over a new set of points.
+     *
+     * @param   *x          X components of the positions of the points.
+     * @param   *y          Y components of the positions of the points.
+     * @param   count       Amount of points.
+     */
+    void build(const T *x, const T *y, std::size_t count);
+
+    /**
+     * @brief   Returns the amount of points in the grid.
+     */
+    std::size_t get_size(void) const;
+
+    /**
+     * @brief   Calls the callback with the index of every point within a radius of a centre.
+     *
+     * @param   center          Centre of the queried circle.
+     * @param   radius          Radius of the queried circle, points on its edge are included.
+     * @param   &&callback      Callable as callback(index).
+     */
+    template <typename Callback>
+    void query_radius(essentials::BasicVector2D<T> center, T radius, Callback &&callback) const;
+
+    /**
+     * @brief   Calls the callback once for every pair of points closer to each other than a radius.
+     *
+     * @details
+     *
+     * Only the cells adjacent to each other are searched, so the radius must not exceed the cell
+     * size. Every unordered pair is reported exactly once, with the points in no particular order.
+     *
+     * @param   radius          Maximum distance of the points of a pair, at most the cell size.
+     * @param   &&callback      Callable as callback(index, other_index).
+     */
+    template <typename Callback>
+    void for_each_neighbor_pair(T radius, Callback &&callback) const;
+
+    /**
+     * @brief   Calls the callback for the close pairs of points of a range of entries.
+     *
+     * @details
+     *
+     * The entries are the points sorted by bucket, which keeps neighbouring points close together.
+     * Splitting [0, get_size()) into ranges reports every pair exactly once over all of them, so
+     * the ranges can be searched in parallel.
+     *
+     * @param   radius          Maximum distance of the points of a pair, at most the cell size.
+     * @param   first           Index of the first entry whose pairs are reported.
+     * @param   last            Index one past the last entry whose pairs are reported.
+     * @param   &&callback      Callable as callback(index, other_index).
+     */
+    template <typename Callback>
+    void for_each_neighbor_pair(T radius, std::size_t first, std::size_t last,
+                                Callback &&callback) const;
+
+protected:
+    /**
+     * @brief   Returns the cell coordinate of a position along one axis.
+     */
+    std::int32_t cell_coordinate(T position) const;
+
+    /**
+     * @brief   Returns the bucket a cell is hashed into.
+     */
+    std::size_t bucket_of(std::int32_t cell_x, std::int32_t cell_y) const;
+
+    /**
+     * @brief   Calls the callback for the entries of a row of cells within a radius of a point.
+     *
+     * @param   first           Index of the first entry to consider, within the bucket of the
+     *                          first cell.
+     * @param   cell_y          Cell coordinate of the row.
+     * @param   min_x           Cell coordinate of the first cell of the row.
+     * @param   max_x           Cell coordinate of the last cell of the row.
+     */
+    template <typename Callback>
+    void visit_row(std::size_t first, std::int32_t cell_y, std::int32_t min_x, std::int32_t max_x,
+                   T center_x, T center_y, T radius_squared, Callback &&callback) const;
+
+    /**
+     * @brief   Calls the callback for the entries of a range within a row of cells and a radius.
+     */
+    template <typename Callback>
+    void visit_entries(std::size_t first, std::size_t last, std::int32_t cell_y,
+                       std::int32_t min_x, std::int32_t max_x, T center_x, T center_y,
+                       T radius_squared, Callback &&callback) const;
+
+    T cell_size_;              ///< Length of the side of a cell.
+    T inverse_cell_size_;      ///< Inverse of the cell size used by the last build.
+    std::size_t size_;         ///< Amount of points in the grid.
+    std::size_t bucket_mask_;  ///< Amount of buckets minus one, a power of two.
+    std::vector<std::uint32_t> bucket_starts_;  ///< Offsets of the buckets' entries, plus the end.
+    std::vector<std::uint32_t> indices_;        ///< Indices of the points, sorted by bucket.
+    std::vector<T> entry_x_;                    ///< X components of the sorted points.
+    std::vector<T> entry_y_;                    ///< Y components of the sorted points.
+    std::vector<std::int32_t> entry_cell_x_;    ///< X cell coordinates of the sorted points.
+    std::vector<std::int32_t> entry_cell_y_;    ///< Y cell coordinates of the sorted points.
+    std::vector<std::uint32_t> point_buckets_;  ///< Buckets of the points in their original order.
+};
+
+/**
+ * @brief   Double precision spatial grid.
+ */
+typedef BasicSpatialGrid<double> SpatialGrid;
+
+/**
+ * @brief   Single precision spatial grid.
+ */
+typedef BasicSpatialGrid<float> SpatialGridF;
+
+template <typename T>
+template <typename Callback>
+void BasicSpatialGrid<T>::query_radius(essentials::BasicVector2D<T> center, T radius,
+                                       Callback &&callback) const
+{
+    if (size_ == 0 || radius < T(0)) {
+        return;
+    }
+
+    const T radius_squared = radius * radius;
+    const std::int32_t min_x = cell_coordinate(center.x - radius);
+    const std::int32_t max_x = cell_coordinate(center.x + radius);
+    const std::int32_t min_y = cell_coordinate(center.y - radius);
+    const std::int32_t max_y = cell_coordinate(center.y + radius);
+    const double cell_count = (double(max_x) - min_x + 1) * (double(max_y) - min_y + 1);
+
+    // Covering more cells than there are buckets, it is cheaper to test every point once.
+    if (cell_count > double(bucket_mask_ + 1)) {
+        for (std::size_t k = 0; k < size_; k++) {
+            T dx = entry_x_[k] - center.x;
+            T dy = entry_y_[k] - center.y;
+            if (dx * dx + dy * dy <= radius_squared) {
+                callback(static_cast<std::size_t>(indices_[k]));
+            }
+        }
+        return;
+    }
+
+    for (std::int32_t cell_y = min_y; cell_y <= max_y; cell_y++) {
+        visit_row(bucket_starts_[bucket_of(min_x, cell_y)], cell_y, min_x, max_x, center.x,
+                  center.y, radius_squared,
+                  [&](std::size_t k) { callback(static_cast<std::size_t>(indices_[k])); });
+    }
+}
+
+template <typename T>
+template <typename Callback>
+void BasicSpatialGrid<T>::for_each_neighbor_pair(T radius, Callback &&callback) const
+{
+    for_each_neighbor_pair(radius, 0, size_, callback);
+}
+
+template <typename T>
+template <typename Callback>
+void BasicSpatialGrid<T>::for_each_neighbor_pair(T radius, std::size_t first, std::size_t last,
+                                                 Callback &&callback) const
+{
+    const T radius_squared = radius * radius;
+
+    // Half of the surrounding cells, the one to the right and the three above, so that every pair
+    // of adjacent cells is visited once.
+    for (std::size_t k = first; k < last; k++) {
+        const std::int32_t cell_x = entry_cell_x_[k];
+        const std::int32_t cell_y = entry_cell_y_[k];
+        const std::size_t index = indices_[k];
+        auto report = [&](std::size_t other) {
+            callback(index, static_cast<std::size_t>(indices_[other]));
+        };
+
+        // Within its own cell, a point only pairs up with the points sorted after it, the cell to
+        // its right follows in the next bucket.
+        visit_row(k + 1, cell_y, cell_x, cell_x + 1, entry_x_[k], entry_y_[k], radius_squared,
+                  report);
+        visit_row(bucket_starts_[bucket_of(cell_x - 1, cell_y + 1)], cell_y + 1, cell_x - 1,
+                  cell_x + 1, entry_x_[k], entry_y_[k], radius_squared, report);
+    }
+}
+
+template <typename T>
+template <typename Callback>
+void BasicSpatialGrid<T>::visit_row(std::size_t first, std::int32_t cell_y, std::int32_t min_x,
+                                    std::int32_t max_x, T center_x, T center_y, T radius_squared,
+                                    Callback &&callback) const
+{
+    const std::size_t first_bucket = bucket_of(min_x, cell_y);
+    const std::size_t end_bucket =
+        first_bucket + static_cast<std::size_t>(std::int64_t(max_x) - min_x) + 1;
+
+    // A row running past the last bucket continues from the first one.
+    if (end_bucket <= bucket_mask_ + 1) {
+        visit_entries(first, bucket_starts_[end_bucket], cell_y, min_x, max_x, center_x, center_y,
+                      radius_squared, callback);
+    }
+    else {
+        visit_entries(first, size_, cell_y, min_x, max_x, center_x, center_y, radius_squared,
+                      callback);
+        visit_entries(0, bucket_starts_[end_bucket & bucket_mask_], cell_y, min_x, max_x, center_x,
+                      center_y, radius_squared, callback);
+    }
+}
+
+template <typename T>
+template <typename Callback>
+void BasicSpatialGrid<T>::visit_entries(std::size_t first, std::size_t last, std::int32_t cell_y,
+                                        std::int32_t min_x, std::int32_t max_x, T center_x,
+                                        T center_y, T radius_squared, Callback &&callback) const
+{
+    for (std::size_t k = first; k < last; k++) {
+        if (entry_cell_y_[k] == cell_y && entry_cell_x_[k] >= min_x && entry_cell_x_[k] <= max_x) {
+            T dx = entry_x_[k] - center_x;
+            T dy = entry_y_[k] - center_y;
+            if (dx * dx + dy * dy <= radius_squared) {
+                callback(k);
+            }
+        }
+    }
+}
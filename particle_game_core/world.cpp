@@ -7,11 +7,1250 @@
 
 #include "world.hpp"
 
-World::World(void) : particle_limit_(1000) {}
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <typeinfo>
 
-void World::set_particle_limit(std::size_t particle_limit)
+// "Game essentials" library includes
+#include <profiler.hpp>
+
+// Local includes
+#include "gravity_constant.hpp"
+
+using namespace essentials;
+
+/**
+ * @brief   Amount of particles per job in the force accumulation.
+ */
+static constexpr std::size_t FORCE_GRAIN_SIZE = 256;
+
+/**
+ * @brief   Amount of particles per job in the passes streaming through the arrays.
+ */
+static constexpr std::size_t STREAM_GRAIN_SIZE = 8192;
+
+/**
+ * @brief   Amount of emitters per job in the initialisation of the spawned particles.
+ */
+static constexpr std::size_t EMITTER_GRAIN_SIZE = 16;
+
+/**
+ * @brief   Amount of grid entries per block of the collision detection.
+ */
+static constexpr std::size_t COLLISION_GRAIN_SIZE = 4096;
+
+/**
+ * @brief   Share of an overlap resolved per step, split between the particles by their masses.
+ */
+static constexpr double COLLISION_RELAXATION = 0.5;
+
+/**
+ * @brief   Amount of particles per job of the obstacle pass.
+ */
+static constexpr std::size_t OBSTACLE_GRAIN_SIZE = 4096;
+
+/**
+ * @brief   Amount of per-particle scratch arrays used by the integrators.
+ */
+static constexpr std::size_t INTEGRATOR_SCRATCH_ARRAYS = 8;
+
+/**
+ * @brief   Classes of the gravity objects in a snapshot.
+ */
+enum class SnapshotGravityClass : std::uint32_t
+{
+    GRAVITY_OBJECT,    ///< GravityObject.
+    GRAVITY_CONSTANT,  ///< GravityConstant.
+};
+
+/**
+ * @brief   Returns the seconds elapsed since a point in time.
+ */
+static double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief   Reflects a coordinate of a particle and its velocity off the bounds of an axis.
+ *
+ * @details
+ *
+ * The bounds are selected rather than branched to, so the loops calling this vectorise.
+ *
+ * @param   &position       The coordinate.
+ * @param   &velocity       The velocity along the axis.
+ * @param   low             Lowest coordinate the particle may have.
+ * @param   high            Highest coordinate the particle may have.
+ * @param   restitution     Share of the speed kept by the bounce.
+ */
+template <typename T>
+static inline void bounce_off_bounds(T &position, T &velocity, T low, T high, T restitution)
+{
+    const bool below = position < low;
+    const bool above = position > high;
+    position = below ? low + (low - position) * restitution : position;
+    position = above ? high - (position - high) * restitution : position;
+    velocity = (below && velocity < T(0)) || (above && velocity > T(0)) ? -velocity * restitution
+                                                                        : velocity;
+
+    // Particles far beyond the bounds would still be out after the reflection.
+    position = std::max(std::min(position, high), low);
+}
+
+template <typename T>
+BasicWorld<T>::BasicWorld(void)
+    : particle_limit_(1000),
+      particles_(particle_limit_),
+      gravity_solver_(GravitySolver::DIRECT),
+      particle_self_gravity_(false),
+      particle_collisions_(false),
+      collision_restitution_(1.0),
+      integrator_(Integrator::SYMPLECTIC_EULER),
+      time_step_(1.0),
+      grid_cell_size_(0.0),
+      max_time_step_level_(0),
+      time_step_accuracy_(0.01),
+      observer_(nullptr),
+      phase_times_{},
+      boundary_mode_(BoundaryMode::NONE),
+      obstacle_restitution_(1.0)
+{
+}
+
+template <typename T>
+void BasicWorld<T>::set_particle_limit(std::size_t particle_limit)
+{
+    particle_limit_ = particle_limit;
+    particles_.set_capacity(particle_limit_);
+}
+
+template <typename T>
+std::size_t BasicWorld<T>::get_particle_limit() { return particle_limit_; }
+
+template <typename T>
+std::size_t BasicWorld<T>::get_particle_count(void) const { return particles_.get_size(); }
+
+template <typename T>
+BasicParticleStore<T> &BasicWorld<T>::get_particles(void) { return particles_.get_store(); }
+
+template <typename T>
+const BasicParticleStore<T> &BasicWorld<T>::get_particles(void) const
+{
+    return particles_.get_store();
+}
+
+template <typename T>
+BasicParticlePool<T> &BasicWorld<T>::get_particle_pool(void) { return particles_; }
+
+template <typename T>
+ParticleHandle BasicWorld<T>::spawn_particle(BasicVector2D<T> position, BasicVector2D<T> velocity,
+                                             T mass)
+{
+    // An out-of-range identifier never resolves to a particle.
+    ParticleHandle handle{static_cast<std::uint32_t>(-1), 0};
+
+    if (particles_.spawn(handle)) {
+        BasicParticleStore<T> &store = particles_.get_store();
+        const std::size_t index = particles_.get_index(handle);
+
+        store.x[index] = position.x;
+        store.y[index] = position.y;
+        store.px[index] = position.x;
+        store.py[index] = position.y;
+        store.vx[index] = velocity.x;
+        store.vy[index] = velocity.y;
+        store.mass[index] = mass;
+    }
+
+    if (observer_ != nullptr) {
+        observer_->particle_spawned(handle, position, velocity, mass);
+    }
+
+    return handle;
+}
+
+template <typename T>
+bool BasicWorld<T>::kill_particle(ParticleHandle handle)
+{
+    const bool killed = particles_.kill(handle);
+    if (observer_ != nullptr) {
+        observer_->particle_killed(handle);
+    }
+    return killed;
+}
+
+template <typename T>
+BasicParticleView<T> BasicWorld<T>::get_particle(ParticleHandle handle)
+{
+    return BasicParticleView<T>(particles_, handle);
+}
+
+template <typename T>
+BasicGravityObject<T> *BasicWorld<T>::add_gravity_object(
+    std::unique_ptr<BasicGravityObject<T>> gravity_object)
+{
+    gravity_objects_.push_back(std::move(gravity_object));
+    return gravity_objects_.back().get();
+}
+
+template <typename T>
+std::size_t BasicWorld<T>::get_gravity_object_count(void) const
+{
+    return gravity_objects_.size();
+}
+
+template <typename T>
+BasicGravityObject<T> *BasicWorld<T>::get_gravity_object(std::size_t index)
+{
+    return gravity_objects_[index].get();
+}
+
+template <typename T>
+BasicEmitter<T> *BasicWorld<T>::add_emitter(std::unique_ptr<BasicEmitter<T>> emitter)
+{
+    emitters_.push_back(std::move(emitter));
+    emitter_firsts_.resize(emitters_.size());
+    emitter_counts_.resize(emitters_.size());
+    return emitters_.back().get();
+}
+
+template <typename T>
+void BasicWorld<T>::emit_particles(void)
+{
+    ESSENTIALS_PROFILE_SCOPE("spawn");
+    const std::size_t emitter_count = emitters_.size();
+
+    // Spawning only moves the pool's bookkeeping, so it is cheap enough to do serially. It also
+    // keeps the slots of every emitter's batch independent of the thread count.
+    for (std::size_t e = 0; e < emitter_count; e++) {
+        emitter_firsts_[e] = particles_.get_size();
+        emitter_counts_[e] = particles_.spawn_batch(emitters_[e]->advance(time_step_));
+    }
+
+    BasicParticleStore<T> &store = particles_.get_store();
+    jobs_.parallel_for(0, emitter_count, EMITTER_GRAIN_SIZE,
+                       [&](std::size_t begin, std::size_t end) {
+                           for (std::size_t e = begin; e < end; e++) {
+                               emitters_[e]->initialize_particles(store, emitter_firsts_[e],
+                                                                  emitter_counts_[e]);
+                           }
+                       });
+}
+
+template <typename T>
+void BasicWorld<T>::set_expiry_callback(ExpiryCallback callback)
+{
+    expiry_callback_ = std::move(callback);
+}
+
+template <typename T>
+void BasicWorld<T>::set_observer(BasicWorldObserver<T> *observer) { observer_ = observer; }
+
+template <typename T>
+BasicWorldObserver<T> *BasicWorld<T>::get_observer(void) const { return observer_; }
+
+template <typename T>
+void BasicWorld<T>::set_gravity_solver(GravitySolver gravity_solver)
+{
+    gravity_solver_ = gravity_solver;
+}
+
+template <typename T>
+GravitySolver BasicWorld<T>::get_gravity_solver(void) const { return gravity_solver_; }
+
+template <typename T>
+void BasicWorld<T>::set_barnes_hut_theta(T theta) { barnes_hut_tree_.set_theta(theta); }
+
+template <typename T>
+T BasicWorld<T>::get_barnes_hut_theta(void) const { return barnes_hut_tree_.get_theta(); }
+
+template <typename T>
+void BasicWorld<T>::set_particle_self_gravity(bool enabled) { particle_self_gravity_ = enabled; }
+
+template <typename T>
+bool BasicWorld<T>::get_particle_self_gravity(void) const { return particle_self_gravity_; }
+
+template <typename T>
+void BasicWorld<T>::set_particle_collisions(bool enabled) { particle_collisions_ = enabled; }
+
+template <typename T>
+bool BasicWorld<T>::get_particle_collisions(void) const { return particle_collisions_; }
+
+template <typename T>
+void BasicWorld<T>::set_collision_restitution(T restitution)
+{
+    collision_restitution_ = restitution;
+}
+
+template <typename T>
+T BasicWorld<T>::get_collision_restitution(void) const { return collision_restitution_; }
+
+template <typename T>
+void BasicWorld<T>::set_boundary_mode(BoundaryMode mode) { boundary_mode_ = mode; }
+
+template <typename T>
+BoundaryMode BasicWorld<T>::get_boundary_mode(void) const { return boundary_mode_; }
+
+template <typename T>
+void BasicWorld<T>::set_bounds(BasicVector2D<T> min, BasicVector2D<T> max)
+{
+    bounds_min_ = min;
+    bounds_max_ = max;
+}
+
+template <typename T>
+BasicVector2D<T> BasicWorld<T>::get_bounds_min(void) const { return bounds_min_; }
+
+template <typename T>
+BasicVector2D<T> BasicWorld<T>::get_bounds_max(void) const { return bounds_max_; }
+
+template <typename T>
+void BasicWorld<T>::set_obstacle_restitution(T restitution) { obstacle_restitution_ = restitution; }
+
+template <typename T>
+T BasicWorld<T>::get_obstacle_restitution(void) const { return obstacle_restitution_; }
+
+template <typename T>
+BasicObstacleSet<T> &BasicWorld<T>::get_obstacles(void) { return obstacles_; }
+
+template <typename T>
+const BasicObstacleSet<T> &BasicWorld<T>::get_obstacles(void) const { return obstacles_; }
+
+template <typename T>
+void BasicWorld<T>::set_integrator(Integrator integrator)
+{
+    if (integrator != integrator_) {
+        BasicParticleStore<T> &store = particles_.get_store();
+        std::fill(store.ax.begin(), store.ax.end(), T(0));
+        std::fill(store.ay.begin(), store.ay.end(), T(0));
+        integrator_ = integrator;
+    }
+}
+
+template <typename T>
+Integrator BasicWorld<T>::get_integrator(void) const { return integrator_; }
+
+template <typename T>
+void BasicWorld<T>::set_time_step(T time_step) { time_step_ = time_step; }
+
+template <typename T>
+T BasicWorld<T>::get_time_step(void) const { return time_step_; }
+
+template <typename T>
+void BasicWorld<T>::set_max_time_step_level(std::size_t level)
+{
+    // Levels are kept in bytes and the substeps are counted in a size_t.
+    max_time_step_level_ = std::min<std::size_t>(level, 30);
+}
+
+template <typename T>
+std::size_t BasicWorld<T>::get_max_time_step_level(void) const { return max_time_step_level_; }
+
+template <typename T>
+void BasicWorld<T>::set_time_step_accuracy(T accuracy) { time_step_accuracy_ = accuracy; }
+
+template <typename T>
+T BasicWorld<T>::get_time_step_accuracy(void) const { return time_step_accuracy_; }
+
+template <typename T>
+std::size_t BasicWorld<T>::get_time_step_level_size(std::size_t level) const
+{
+    if (level + 1 >= level_starts_.size()) {
+        return 0;
+    }
+    return level_starts_[level + 1] - level_starts_[level];
+}
+
+template <typename T>
+void BasicWorld<T>::set_thread_count(std::size_t thread_count)
+{
+    jobs_.set_thread_count(thread_count);
+}
+
+template <typename T>
+std::size_t BasicWorld<T>::get_thread_count(void) const { return jobs_.get_thread_count(); }
+
+template <typename T>
+void BasicWorld<T>::set_deterministic(bool deterministic)
+{
+    jobs_.set_deterministic(deterministic);
+}
+
+template <typename T>
+bool BasicWorld<T>::get_deterministic(void) const { return jobs_.get_deterministic(); }
+
+template <typename T>
+JobSystem &BasicWorld<T>::get_job_system(void) { return jobs_; }
+
+template <typename T>
+void BasicWorld<T>::set_grid_cell_size(T cell_size) { grid_cell_size_ = cell_size; }
+
+template <typename T>
+T BasicWorld<T>::get_grid_cell_size(void) const { return grid_cell_size_; }
+
+template <typename T>
+const BasicSpatialGrid<T> &BasicWorld<T>::get_spatial_grid(void) const { return spatial_grid_; }
+
+template <typename T>
+void BasicWorld<T>::update_spatial_grid(void)
 {
+    ESSENTIALS_PROFILE_SCOPE("spatial grid");
+    BasicParticleStore<T> &store = particles_.get_store();
+
+    if (grid_cell_size_ > T(0)) {
+        spatial_grid_.set_cell_size(grid_cell_size_);
+    }
+    spatial_grid_.build(store.x.data(), store.y.data(), particles_.get_size());
+}
+
+template <typename T>
+void BasicWorld<T>::accumulate_forces(void)
+{
+    accumulate_forces(0, particles_.get_size(), true);
+}
+
+template <typename T>
+void BasicWorld<T>::apply_uniform_acceleration(BasicVector2D<T> acceleration)
+{
+    BasicParticleStore<T> &store = particles_.get_store();
+    const T kick_x = acceleration.x * time_step_;
+    const T kick_y = acceleration.y * time_step_;
+    T *vx = store.vx.data();
+    T *vy = store.vy.data();
+
+    jobs_.parallel_for(0, particles_.get_size(), STREAM_GRAIN_SIZE,
+                       [&](std::size_t begin, std::size_t end) {
+                           for (std::size_t i = begin; i < end; i++) {
+                               vx[i] += kick_x;
+                               vy[i] += kick_y;
+                           }
+                       });
+}
+
+template <typename T>
+BasicVector2D<T> BasicWorld<T>::get_uniform_acceleration(void) const
+{
+    BasicVector2D<T> sum;
+    for (const std::unique_ptr<BasicGravityObject<T>> &gravity_object : gravity_objects_) {
+        BasicVector2D<T> acceleration;
+        if (gravity_object->get_uniform_acceleration(acceleration)) {
+            sum += acceleration;
+        }
+    }
+    return sum;
+}
+
+template <typename T>
+void BasicWorld<T>::accumulate_forces(std::size_t first, std::size_t last, bool uniform)
+{
+    ESSENTIALS_PROFILE_SCOPE("forces");
+    const auto start = std::chrono::steady_clock::now();
+    BasicParticleStore<T> &store = particles_.get_store();
+    const std::size_t count = particles_.get_size();
+    const bool use_tree = (gravity_solver_ == GravitySolver::BARNES_HUT);
+
+    if (use_tree) {
+        // The particles come first, so that a particle's index is also its body index.
+        const std::size_t particle_bodies = particle_self_gravity_ ? count : 0;
+        body_x_.assign(store.x.begin(), store.x.begin() + particle_bodies);
+        body_y_.assign(store.y.begin(), store.y.begin() + particle_bodies);
+        body_mass_.assign(store.mass.begin(), store.mass.begin() + particle_bodies);
+
+        for (const std::unique_ptr<BasicGravityObject<T>> &gravity_object : gravity_objects_) {
+            if (gravity_object->is_point_mass() && gravity_object->get_is_enabled()) {
+                body_x_.push_back(gravity_object->get_position().x);
+                body_y_.push_back(gravity_object->get_position().y);
+                body_mass_.push_back(gravity_object->get_mass());
+            }
+        }
+
+        barnes_hut_tree_.build(body_x_.data(), body_y_.data(), body_mass_.data(), body_x_.size());
+    }
+
+    const T *x = store.x.data();
+    const T *y = store.y.data();
+    const T *mass = store.mass.data();
+    T *fx = store.fx.data();
+    T *fy = store.fy.data();
+
+    bool culling = false;
+    for (const std::unique_ptr<BasicGravityObject<T>> &gravity_object : gravity_objects_) {
+        culling = culling || gravity_object->get_cutoff_radius() > T(0);
+    }
+
+    jobs_.parallel_for(first, last, FORCE_GRAIN_SIZE, [&](std::size_t begin, std::size_t end) {
+        // Tile by tile, so that with cutoff radii in play, the bounding box of a tile lets the
+        // objects out of reach of all its particles skip the tile altogether.
+        for (std::size_t tile = begin; tile < end; tile += FORCE_GRAIN_SIZE) {
+            const std::size_t tile_end = std::min(tile + FORCE_GRAIN_SIZE, end);
+
+            BasicVector2D<T> min;
+            BasicVector2D<T> max;
+            if (culling) {
+                min = max = BasicVector2D<T>(x[tile], y[tile]);
+                for (std::size_t i = tile + 1; i < tile_end; i++) {
+                    min.x = std::min(min.x, x[i]);
+                    min.y = std::min(min.y, y[i]);
+                    max.x = std::max(max.x, x[i]);
+                    max.y = std::max(max.y, y[i]);
+                }
+            }
+
+            // One call per gravity object, each applying itself to the whole tile.
+            for (const std::unique_ptr<BasicGravityObject<T>> &gravity_object : gravity_objects_) {
+                BasicVector2D<T> acceleration;
+                if (!uniform && gravity_object->get_uniform_acceleration(acceleration)) {
+                    continue;
+                }
+                if (culling && !gravity_object->can_reach(min, max)) {
+                    continue;
+                }
+                if (!use_tree || !gravity_object->is_point_mass()) {
+                    gravity_object->accumulate_forces(x + tile, y + tile, mass + tile, fx + tile,
+                                                      fy + tile, tile_end - tile);
+                }
+            }
+        }
+
+        if (use_tree) {
+            for (std::size_t i = begin; i < end; i++) {
+                std::size_t self = particle_self_gravity_ ? i : BasicBarnesHutTree<T>::NO_BODY;
+                BasicVector2D<T> force = barnes_hut_tree_.calculate_force(
+                    BasicVector2D<T>(x[i], y[i]), mass[i], self);
+                fx[i] += force.x;
+                fy[i] += force.y;
+            }
+        }
+        else if (particle_self_gravity_) {
+            for (std::size_t i = begin; i < end; i++) {
+                BasicVector2D<T> target(x[i], y[i]);
+
+                for (std::size_t j = 0; j < count; j++) {
+                    if (j != i) {
+                        BasicVector2D<T> force = BasicGravityObject<T>::calculate_point_mass_force(
+                            BasicVector2D<T>(x[j], y[j]), mass[j], target, mass[i]);
+                        fx[i] += force.x;
+                        fy[i] += force.y;
+                    }
+                }
+            }
+        }
+    });
+    add_phase_time(StepPhase::FORCES, seconds_since(start));
+}
+
+template <typename T>
+void BasicWorld<T>::integrate_forces(void)
+{
+    BasicParticleStore<T> &store = particles_.get_store();
+    const std::size_t count = particles_.get_size();
+    T *vx = store.vx.data();
+    T *vy = store.vy.data();
+    T *fx = store.fx.data();
+    T *fy = store.fy.data();
+    const T *mass = store.mass.data();
+    const T time_step = time_step_;
+
+    // Consuming and clearing the accumulators in the same pass saves a separate sweep over them.
+    jobs_.parallel_for(0, count, STREAM_GRAIN_SIZE, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const T kick = inverse_mass(mass[i]) * time_step;
+            vx[i] += fx[i] * kick;
+            vy[i] += fy[i] * kick;
+            fx[i] = T(0);
+            fy[i] = T(0);
+        }
+    });
+}
+
+template <typename T>
+void BasicWorld<T>::update(void)
+{
+    BasicParticleStore<T> &store = particles_.get_store();
+    T *x = store.x.data();
+    T *y = store.y.data();
+    T *px = store.px.data();
+    T *py = store.py.data();
+    const T *vx = store.vx.data();
+    const T *vy = store.vy.data();
+    const T time_step = time_step_;
+
+    jobs_.parallel_for(0, particles_.get_size(), STREAM_GRAIN_SIZE,
+                       [&](std::size_t begin, std::size_t end) {
+                           std::copy(x + begin, x + end, px + begin);
+                           std::copy(y + begin, y + end, py + begin);
+                           batch::multiply_add(x + begin, y + begin, vx + begin, vy + begin,
+                                               time_step, end - begin);
+                       });
+}
+
+template <typename T>
+void BasicWorld<T>::step(void)
+{
+    ESSENTIALS_PROFILE_SCOPE("step");
+    if (observer_ != nullptr) {
+        observer_->step_starting();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    if (!emitters_.empty()) {
+        emit_particles();
+    }
+    add_phase_time(StepPhase::EMISSION, seconds_since(start));
+
+    // The force accumulation times itself, the integration gets the rest of the time.
+    start = std::chrono::steady_clock::now();
+    const double forces_before = get_phase_time(StepPhase::FORCES);
+    {
+        ESSENTIALS_PROFILE_SCOPE("integrate");
+        if (max_time_step_level_ > 0) {
+            run_block_step();
+        }
+        else {
+            switch (integrator_) {
+                case Integrator::SYMPLECTIC_EULER:
+                    run_integrator<SymplecticEuler<T>>();
+                    break;
+                case Integrator::VELOCITY_VERLET:
+                    run_integrator<VelocityVerlet<T>>();
+                    break;
+                case Integrator::RUNGE_KUTTA_4:
+                    run_integrator<RungeKutta4<T>>();
+                    break;
+            }
+        }
+    }
+    add_phase_time(StepPhase::INTEGRATION, seconds_since(start) -
+                                               (get_phase_time(StepPhase::FORCES) - forces_before));
+
+    if (particle_collisions_) {
+        start = std::chrono::steady_clock::now();
+        resolve_collisions();
+        add_phase_time(StepPhase::COLLISIONS, seconds_since(start));
+    }
+
+    if (boundary_mode_ != BoundaryMode::NONE || !obstacles_.is_empty()) {
+        start = std::chrono::steady_clock::now();
+        resolve_obstacles();
+        add_phase_time(StepPhase::OBSTACLES, seconds_since(start));
+    }
+
+    start = std::chrono::steady_clock::now();
+    expire_particles();
+    add_phase_time(StepPhase::EXPIRY, seconds_since(start));
+
+    if (grid_cell_size_ > T(0)) {
+        start = std::chrono::steady_clock::now();
+        update_spatial_grid();
+        add_phase_time(StepPhase::SPATIAL_GRID, seconds_since(start));
+    }
+
+    if (observer_ != nullptr) {
+        observer_->step_finished();
+    }
+}
+
+template <typename T>
+void BasicWorld<T>::save_snapshot(const std::string &path) const
+{
+    SnapshotWriter writer(path, sizeof(T));
+    save_snapshot(writer);
+    writer.finish();
+}
+
+template <typename T>
+void BasicWorld<T>::save_snapshot(SnapshotWriter &writer) const
+{
+    writer.write_value(static_cast<std::uint64_t>(particle_limit_));
+    writer.write_value(static_cast<std::uint32_t>(gravity_solver_));
+    writer.write_value(static_cast<std::uint8_t>(particle_self_gravity_));
+    writer.write_value(static_cast<std::uint32_t>(integrator_));
+    writer.write_value(time_step_);
+    writer.write_value(barnes_hut_tree_.get_theta());
+    writer.write_value(grid_cell_size_);
+    writer.write_value(static_cast<std::uint64_t>(max_time_step_level_));
+    writer.write_value(time_step_accuracy_);
+    writer.write_value(static_cast<std::uint8_t>(particle_collisions_));
+    writer.write_value(collision_restitution_);
+    writer.write_value(static_cast<std::uint32_t>(boundary_mode_));
+    writer.write_value(bounds_min_.x);
+    writer.write_value(bounds_min_.y);
+    writer.write_value(bounds_max_.x);
+    writer.write_value(bounds_max_.y);
+    writer.write_value(obstacle_restitution_);
+    obstacles_.save(writer);
+
+    particles_.save(writer);
+
+    // Objects of unknown classes would come back as their base class, refuse them instead.
+    writer.write_value(static_cast<std::uint64_t>(gravity_objects_.size()));
+    for (const std::unique_ptr<BasicGravityObject<T>> &gravity_object : gravity_objects_) {
+        const BasicGravityObject<T> &object = *gravity_object;
+        const std::type_info &type = typeid(object);
+        if (type == typeid(BasicGravityObject<T>)) {
+            writer.write_value(SnapshotGravityClass::GRAVITY_OBJECT);
+        }
+        else if (type == typeid(BasicGravityConstant<T>)) {
+            writer.write_value(SnapshotGravityClass::GRAVITY_CONSTANT);
+        }
+        else {
+            writer.fail("cannot save a gravity object of an unknown class");
+        }
+        gravity_object->save(writer);
+    }
+
+    writer.write_value(static_cast<std::uint64_t>(emitters_.size()));
+    for (const std::unique_ptr<BasicEmitter<T>> &emitter : emitters_) {
+        const BasicEmitter<T> &object = *emitter;
+        if (typeid(object) != typeid(BasicEmitter<T>)) {
+            writer.fail("cannot save an emitter of an unknown class");
+        }
+        emitter->save(writer);
+    }
+}
+
+template <typename T>
+void BasicWorld<T>::load_snapshot(const std::string &path)
+{
+    SnapshotReader reader(path, sizeof(T));
+    load_snapshot(reader);
+}
+
+template <typename T>
+void BasicWorld<T>::load_snapshot(SnapshotReader &reader)
+{
+    // Everything is read aside first, so that a malformed snapshot leaves the world untouched.
+    const std::uint64_t particle_limit = reader.read_value<std::uint64_t>();
+    const std::uint32_t gravity_solver = reader.read_value<std::uint32_t>();
+    const bool particle_self_gravity = reader.read_value<std::uint8_t>() != 0;
+    const std::uint32_t integrator = reader.read_value<std::uint32_t>();
+    const T time_step = reader.read_value<T>();
+    const T barnes_hut_theta = reader.read_value<T>();
+    const T grid_cell_size = reader.read_value<T>();
+    const std::uint64_t max_time_step_level = reader.read_value<std::uint64_t>();
+    const T time_step_accuracy = reader.read_value<T>();
+    const bool particle_collisions = reader.read_value<std::uint8_t>() != 0;
+    const T collision_restitution = reader.read_value<T>();
+    const std::uint32_t boundary_mode = reader.read_value<std::uint32_t>();
+    BasicVector2D<T> bounds_min;
+    bounds_min.x = reader.read_value<T>();
+    bounds_min.y = reader.read_value<T>();
+    BasicVector2D<T> bounds_max;
+    bounds_max.x = reader.read_value<T>();
+    bounds_max.y = reader.read_value<T>();
+    const T obstacle_restitution = reader.read_value<T>();
+
+    if (gravity_solver > static_cast<std::uint32_t>(GravitySolver::BARNES_HUT) ||
+        integrator > static_cast<std::uint32_t>(Integrator::RUNGE_KUTTA_4) ||
+        boundary_mode > static_cast<std::uint32_t>(BoundaryMode::KILL)) {
+        reader.fail("unknown gravity solver, integrator or boundary mode");
+    }
+
+    BasicObstacleSet<T> obstacles;
+    obstacles.load(reader);
+
+    BasicParticlePool<T> particles;
+    particles.load(reader);
+    if (particles.get_capacity() != particle_limit) {
+        reader.fail("particle pool does not match the particle limit");
+    }
+
+    std::vector<std::unique_ptr<BasicGravityObject<T>>> gravity_objects;
+    const std::uint64_t gravity_object_count = reader.read_value<std::uint64_t>();
+    for (std::uint64_t i = 0; i < gravity_object_count; i++) {
+        switch (reader.read_value<SnapshotGravityClass>()) {
+            case SnapshotGravityClass::GRAVITY_OBJECT:
+                gravity_objects.push_back(
+                    std::make_unique<BasicGravityObject<T>>(BasicVector2D<T>()));
+                break;
+            case SnapshotGravityClass::GRAVITY_CONSTANT:
+                gravity_objects.push_back(std::make_unique<BasicGravityConstant<T>>());
+                break;
+            default:
+                reader.fail("unknown gravity object class");
+        }
+        gravity_objects.back()->load(reader);
+    }
+
+    std::vector<std::unique_ptr<BasicEmitter<T>>> emitters;
+    const std::uint64_t emitter_count = reader.read_value<std::uint64_t>();
+    for (std::uint64_t i = 0; i < emitter_count; i++) {
+        emitters.push_back(std::make_unique<BasicEmitter<T>>(BasicVector2D<T>()));
+        emitters.back()->load(reader);
+    }
+
     particle_limit_ = particle_limit;
+    particles_ = std::move(particles);
+    gravity_objects_ = std::move(gravity_objects);
+    emitters_ = std::move(emitters);
+    emitter_firsts_.resize(emitters_.size());
+    emitter_counts_.resize(emitters_.size());
+
+    gravity_solver_ = static_cast<GravitySolver>(gravity_solver);
+    particle_self_gravity_ = particle_self_gravity;
+    integrator_ = static_cast<Integrator>(integrator);
+    time_step_ = time_step;
+    barnes_hut_tree_.set_theta(barnes_hut_theta);
+    grid_cell_size_ = grid_cell_size;
+    set_max_time_step_level(max_time_step_level);
+    time_step_accuracy_ = time_step_accuracy;
+    particle_collisions_ = particle_collisions;
+    collision_restitution_ = collision_restitution;
+    boundary_mode_ = static_cast<BoundaryMode>(boundary_mode);
+    bounds_min_ = bounds_min;
+    bounds_max_ = bounds_max;
+    obstacle_restitution_ = obstacle_restitution;
+    obstacles_ = std::move(obstacles);
+
+    if (grid_cell_size_ > T(0)) {
+        update_spatial_grid();
+    }
+}
+
+template <typename T>
+std::uint64_t BasicWorld<T>::get_state_hash(void) const
+{
+    return particles_.get_store().hash(particles_.get_size());
+}
+
+template <typename T>
+double BasicWorld<T>::get_phase_time(StepPhase phase) const
+{
+    return phase_times_[static_cast<std::size_t>(phase)];
+}
+
+template <typename T>
+void BasicWorld<T>::reset_phase_times(void) { phase_times_.fill(0.0); }
+
+template <typename T>
+void BasicWorld<T>::add_phase_time(StepPhase phase, double seconds)
+{
+    phase_times_[static_cast<std::size_t>(phase)] += seconds;
+}
+
+template <typename T>
+void BasicWorld<T>::expire_particles(void)
+{
+    ESSENTIALS_PROFILE_SCOPE("expiry");
+    BasicParticleStore<T> &store = particles_.get_store();
+    const std::size_t count = particles_.get_size();
+    const T time_step = time_step_;
+    T *age = store.age.data();
+    const T *lifetime = store.lifetime.data();
+    std::uint8_t *alive = store.alive.data();
+
+    jobs_.parallel_for(0, count, STREAM_GRAIN_SIZE, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            age[i] += time_step;
+            alive[i] &= static_cast<std::uint8_t>(age[i] < lifetime[i]);
+        }
+    });
+
+    // Most steps expire nothing, skip the compaction unless something did.
+    if (std::find(alive, alive + count, std::uint8_t(0)) == alive + count) {
+        return;
+    }
+
+    if (expiry_callback_) {
+        expired_slots_.reserve(particles_.get_capacity());
+        expired_slots_.clear();
+        for (std::size_t i = 0; i < count; i++) {
+            if (!alive[i]) {
+                expired_slots_.push_back(i);
+            }
+        }
+        expiry_callback_(particles_, expired_slots_);
+    }
+
+    particles_.compact();
+}
+
+template <typename T>
+void BasicWorld<T>::resolve_collisions(void)
+{
+    ESSENTIALS_PROFILE_SCOPE("collisions");
+    BasicParticleStore<T> &store = particles_.get_store();
+    const std::size_t count = particles_.get_size();
+    T *x = store.x.data();
+    T *y = store.y.data();
+    T *vx = store.vx.data();
+    T *vy = store.vy.data();
+    const T *mass = store.mass.data();
+    const T *radius = store.radius.data();
+
+    // No contact is longer than twice the largest radius, which makes it the ideal cell size.
+    const T max_radius = count > 0 ? *std::max_element(radius, radius + count) : T(0);
+    if (max_radius <= T(0)) {
+        return;
+    }
+
+    collision_grid_.set_cell_size(T(2) * max_radius);
+    collision_grid_.build(x, y, count);
+
+    // The entries of the grid are split into fixed blocks, each collecting its own contacts, so
+    // the order of the contacts does not depend on the threads.
+    const std::size_t block_count = (count + COLLISION_GRAIN_SIZE - 1) / COLLISION_GRAIN_SIZE;
+    if (collision_contacts_.size() < block_count) {
+        collision_contacts_.resize(block_count);
+    }
+
+    const T restitution = collision_restitution_;
+    const T relaxation = T(COLLISION_RELAXATION);
+
+    jobs_.parallel_for(0, block_count, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t block = begin; block < end; block++) {
+            std::vector<Contact> &contacts = collision_contacts_[block];
+            contacts.clear();
+
+            const std::size_t first = block * COLLISION_GRAIN_SIZE;
+            const std::size_t last = std::min(first + COLLISION_GRAIN_SIZE, count);
+            collision_grid_.for_each_neighbor_pair(
+                T(2) * max_radius, first, last, [&](std::size_t i, std::size_t j) {
+                    const T contact = radius[i] + radius[j];
+                    const T dx = x[i] - x[j];
+                    const T dy = y[i] - y[j];
+                    const T distance_squared = dx * dx + dy * dy;
+                    if (radius[i] <= T(0) || radius[j] <= T(0) ||
+                        distance_squared >= contact * contact) {
+                        return;
+                    }
+
+                    // Particles at the same spot, e.g. fresh from an emitter, are split along the
+                    // x axis.
+                    T normal_x = T(1);
+                    T normal_y = T(0);
+                    T distance = T(0);
+                    if (distance_squared > T(0)) {
+                        distance = std::sqrt(distance_squared);
+                        normal_x = dx / distance;
+                        normal_y = dy / distance;
+                    }
+
+                    const T inverse_sum = T(1) / (inverse_mass(mass[i]) + inverse_mass(mass[j]));
+                    const T approach = (vx[i] - vx[j]) * normal_x + (vy[i] - vy[j]) * normal_y;
+                    const T impulse =
+                        approach < T(0) ? -(T(1) + restitution) * approach * inverse_sum : T(0);
+                    const T separation = (contact - distance) * relaxation * inverse_sum;
+
+                    contacts.push_back({static_cast<std::uint32_t>(i),
+                                        static_cast<std::uint32_t>(j), normal_x, normal_y,
+                                        separation, impulse});
+                });
+        }
+    });
+
+    // Every contact pushes its two particles apart and changes their momenta by exactly opposite
+    // amounts. The contacts were all computed from the state before the pass, applying them is
+    // a short serial pass over the contacts alone.
+    for (std::size_t block = 0; block < block_count; block++) {
+        for (const Contact &contact : collision_contacts_[block]) {
+            const T inverse_i = inverse_mass(mass[contact.i]);
+            const T inverse_j = inverse_mass(mass[contact.j]);
+            const T move = contact.separation;
+            const T kick = contact.impulse;
+
+            x[contact.i] += contact.normal_x * move * inverse_i;
+            y[contact.i] += contact.normal_y * move * inverse_i;
+            vx[contact.i] += contact.normal_x * kick * inverse_i;
+            vy[contact.i] += contact.normal_y * kick * inverse_i;
+            x[contact.j] -= contact.normal_x * move * inverse_j;
+            y[contact.j] -= contact.normal_y * move * inverse_j;
+            vx[contact.j] -= contact.normal_x * kick * inverse_j;
+            vy[contact.j] -= contact.normal_y * kick * inverse_j;
+        }
+    }
+}
+
+template <typename T>
+void BasicWorld<T>::resolve_obstacles(void)
+{
+    ESSENTIALS_PROFILE_SCOPE("obstacles");
+    BasicParticleStore<T> &store = particles_.get_store();
+    T *x = store.x.data();
+    T *y = store.y.data();
+    T *px = store.px.data();
+    T *py = store.py.data();
+    T *vx = store.vx.data();
+    T *vy = store.vy.data();
+    const T *radius = store.radius.data();
+    std::uint8_t *alive = store.alive.data();
+    const typename BasicObstacleSet<T>::ParticleArrays arrays = {x, y, px, py, vx, vy, radius};
+
+    const BoundaryMode mode = boundary_mode_;
+    const BasicVector2D<T> min = bounds_min_;
+    const BasicVector2D<T> max = bounds_max_;
+    const T width = max.x - min.x;
+    const T height = max.y - min.y;
+    const T inverse_width = width > T(0) ? T(1) / width : T(0);
+    const T inverse_height = height > T(0) ? T(1) / height : T(0);
+    const T restitution = obstacle_restitution_;
+
+    jobs_.parallel_for(
+        0, particles_.get_size(), OBSTACLE_GRAIN_SIZE, [&](std::size_t begin, std::size_t end) {
+            // The bounds go first, so the obstacles see the wrapped positions.
+            switch (mode) {
+                case BoundaryMode::NONE:
+                    break;
+                case BoundaryMode::WRAP:
+                    // The previous positions move along, so the interpolated positions of the
+                    // rendering do not sweep across the whole world.
+                    for (std::size_t i = begin; i < end; i++) {
+                        const T shift_x = width * std::floor((x[i] - min.x) * inverse_width);
+                        const T shift_y = height * std::floor((y[i] - min.y) * inverse_height);
+                        x[i] -= shift_x;
+                        y[i] -= shift_y;
+                        px[i] -= shift_x;
+                        py[i] -= shift_y;
+                    }
+                    break;
+                case BoundaryMode::BOUNCE:
+                    for (std::size_t i = begin; i < end; i++) {
+                        bounce_off_bounds(x[i], vx[i], min.x + radius[i], max.x - radius[i],
+                                          restitution);
+                        bounce_off_bounds(y[i], vy[i], min.y + radius[i], max.y - radius[i],
+                                          restitution);
+                    }
+                    break;
+                case BoundaryMode::KILL:
+                    for (std::size_t i = begin; i < end; i++) {
+                        alive[i] &= static_cast<std::uint8_t>(x[i] >= min.x && x[i] <= max.x &&
+                                                              y[i] >= min.y && y[i] <= max.y);
+                    }
+                    break;
+            }
+
+            obstacles_.resolve(arrays, begin, end, restitution);
+        });
+}
+
+template <typename T>
+void BasicWorld<T>::run_block_step(void)
+{
+    BasicParticleStore<T> &store = particles_.get_store();
+    const std::size_t count = particles_.get_size();
+    const std::size_t substeps = std::size_t(1) << max_time_step_level_;
+    const T substep = time_step_ / T(substeps);
+
+    // Every particle starts a step of its level now, so all the forces are needed.
+    accumulate_forces(0, count, false);
+
+    const BasicVector2D<T> uniform = get_uniform_acceleration();
+
+    T *x = store.x.data();
+    T *y = store.y.data();
+    T *px = store.px.data();
+    T *py = store.py.data();
+    T *vx = store.vx.data();
+    T *vy = store.vy.data();
+    T *fx = store.fx.data();
+    T *fy = store.fy.data();
+    T *ax = store.ax.data();
+    T *ay = store.ay.data();
+    const T *mass = store.mass.data();
+
+    jobs_.parallel_for(0, count, STREAM_GRAIN_SIZE, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const T inverse = inverse_mass(mass[i]);
+            ax[i] = fx[i] * inverse + uniform.x;
+            ay[i] = fy[i] * inverse + uniform.y;
+            fx[i] = T(0);
+            fy[i] = T(0);
+            px[i] = x[i];
+            py[i] = y[i];
+        }
+    });
+
+    sort_by_time_step_level();
+
+    for (std::size_t substep_index = 0; substep_index < substeps; substep_index++) {
+        // Level L starts a new step every 2^(max - L) substeps, so the finest levels are active at
+        // every substep and the coarser ones at every power of two.
+        std::size_t coarsest_active = 0;
+        if (substep_index > 0) {
+            std::size_t trailing_zeros = 0;
+            while (((substep_index >> trailing_zeros) & 1) == 0) {
+                trailing_zeros++;
+            }
+            coarsest_active = max_time_step_level_ - trailing_zeros;
+
+            const std::size_t first = level_starts_[coarsest_active];
+            accumulate_forces(first, count, false);
+
+            jobs_.parallel_for(first, count, STREAM_GRAIN_SIZE,
+                               [&](std::size_t begin, std::size_t end) {
+                                   for (std::size_t i = begin; i < end; i++) {
+                                       const T inverse = inverse_mass(mass[i]);
+                                       ax[i] = fx[i] * inverse + uniform.x;
+                                       ay[i] = fy[i] * inverse + uniform.y;
+                                       fx[i] = T(0);
+                                       fy[i] = T(0);
+                                   }
+                               });
+        }
+
+        // Kick the active levels for the length of their own steps...
+        for (std::size_t level = coarsest_active; level <= max_time_step_level_; level++) {
+            const T level_step = time_step_ / T(std::size_t(1) << level);
+
+            jobs_.parallel_for(level_starts_[level], level_starts_[level + 1], STREAM_GRAIN_SIZE,
+                               [&](std::size_t begin, std::size_t end) {
+                                   for (std::size_t i = begin; i < end; i++) {
+                                       vx[i] += ax[i] * level_step;
+                                       vy[i] += ay[i] * level_step;
+                                   }
+                               });
+        }
+
+        // ...and drift all the particles through the substep.
+        jobs_.parallel_for(0, count, STREAM_GRAIN_SIZE, [&](std::size_t begin, std::size_t end) {
+            batch::multiply_add(x + begin, y + begin, vx + begin, vy + begin, substep, end - begin);
+        });
+    }
+}
+
+template <typename T>
+void BasicWorld<T>::sort_by_time_step_level(void)
+{
+    BasicParticleStore<T> &store = particles_.get_store();
+    const std::size_t count = particles_.get_size();
+    const std::size_t level_count = max_time_step_level_ + 1;
+    const T *ax = store.ax.data();
+    const T *ay = store.ay.data();
+
+    if (time_step_levels_.size() < count) {
+        time_step_levels_.resize(count);
+    }
+    level_starts_.assign(level_count + 1, 0);
+
+    // A particle with acceleration a strays by a * dt^2 / 2 from a straight line within a step of
+    // dt, its level is the coarsest one whose steps keep that within the accuracy.
+    const T time_step_squared = time_step_ * time_step_;
+    const T accuracy = T(2) * time_step_accuracy_;
+    std::uint8_t *levels = time_step_levels_.data();
+
+    jobs_.parallel_for(0, count, STREAM_GRAIN_SIZE, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            T acceleration = std::sqrt(ax[i] * ax[i] + ay[i] * ay[i]);
+            T level_step_squared = time_step_squared;
+            std::size_t level = 0;
+            while (level < max_time_step_level_ &&
+                   acceleration * level_step_squared > accuracy) {
+                level_step_squared *= T(0.25);
+                level++;
+            }
+            levels[i] = static_cast<std::uint8_t>(level);
+        }
+    });
+
+    for (std::size_t i = 0; i < count; i++) {
+        level_starts_[levels[i] + 1]++;
+    }
+    for (std::size_t level = 0; level < level_count; level++) {
+        level_starts_[level + 1] += level_starts_[level];
+    }
+
+    // Swap every particle straight into the next free slot of its level. Each swap settles at
+    // least one particle for good, so the sort takes at most one swap per particle.
+    std::vector<std::size_t> &next = level_fill_;
+    next.assign(level_starts_.begin(), level_starts_.end() - 1);
+
+    for (std::size_t level = 0; level < level_count; level++) {
+        while (next[level] < level_starts_[level + 1]) {
+            const std::size_t i = next[level];
+            const std::size_t target_level = levels[i];
+
+            if (target_level == level) {
+                next[level]++;
+            }
+            else {
+                const std::size_t target = next[target_level]++;
+                particles_.swap_slots(i, target);
+                std::swap(levels[i], levels[target]);
+            }
+        }
+    }
+}
+
+template <typename T>
+template <typename Policy>
+void BasicWorld<T>::run_integrator(void)
+{
+    BasicParticleStore<T> &store = particles_.get_store();
+    const std::size_t count = particles_.get_size();
+
+    IntegratorArrays<T> arrays = {};
+    arrays.x = store.x.data();
+    arrays.y = store.y.data();
+    arrays.px = store.px.data();
+    arrays.py = store.py.data();
+    arrays.vx = store.vx.data();
+    arrays.vy = store.vy.data();
+    arrays.fx = store.fx.data();
+    arrays.fy = store.fy.data();
+    arrays.ax = store.ax.data();
+    arrays.ay = store.ay.data();
+    arrays.mass = store.mass.data();
+    arrays.time_step = time_step_;
+
+    // The uniform accelerations skip the force accumulators, the integrators add them directly.
+    const BasicVector2D<T> uniform = get_uniform_acceleration();
+    arrays.uniform_ax = uniform.x;
+    arrays.uniform_ay = uniform.y;
+
+    // Only the multi-stage integrators need to keep per-particle state between their stages.
+    if (Policy::STAGES > 1) {
+        if (integrator_scratch_.size() < INTEGRATOR_SCRATCH_ARRAYS * count) {
+            integrator_scratch_.resize(INTEGRATOR_SCRATCH_ARRAYS * count);
+        }
+
+        T *scratch = integrator_scratch_.data();
+        arrays.start_vx = scratch;
+        arrays.start_vy = scratch + count;
+        arrays.slope_x = scratch + 2 * count;
+        arrays.slope_y = scratch + 3 * count;
+        arrays.slope_vx = scratch + 4 * count;
+        arrays.slope_vy = scratch + 5 * count;
+        arrays.external_fx = scratch + 6 * count;
+        arrays.external_fy = scratch + 7 * count;
+    }
+
+    run_stages<Policy>(arrays, std::make_index_sequence<Policy::STAGES>());
+}
+
+template <typename T>
+template <typename Policy, std::size_t... STAGES>
+void BasicWorld<T>::run_stages(const IntegratorArrays<T> &arrays, std::index_sequence<STAGES...>)
+{
+    (run_stage<Policy, STAGES>(arrays), ...);
+}
+
+template <typename T>
+template <typename Policy, std::size_t STAGE>
+void BasicWorld<T>::run_stage(const IntegratorArrays<T> &arrays)
+{
+    const std::size_t count = particles_.get_size();
+
+    if (Policy::moves_before_forces(STAGE)) {
+        jobs_.parallel_for(0, count, STREAM_GRAIN_SIZE, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                Policy::template before_forces<STAGE>(arrays, i);
+            }
+        });
+    }
+
+    accumulate_forces(0, count, false);
+
+    jobs_.parallel_for(0, count, STREAM_GRAIN_SIZE, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            Policy::template after_forces<STAGE>(arrays, i);
+        }
+    });
 }
 
-std::size_t World::get_particle_limit() { return particle_limit_; }
+// Explicitly instantiate all the supported precisions
+template class BasicWorld<float>;
+template class BasicWorld<double>;
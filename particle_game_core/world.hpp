@@ -7,11 +7,73 @@
 
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <cstdlib>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
+// "Game essentials" library includes
+#include <vector2d_batch.hpp>
+
+// Local includes
+#include "barnes_hut_tree.hpp"
+#include "emitter.hpp"
+#include "gravity_object.hpp"
+#include "integrator.hpp"
+#include "job_system.hpp"
+#include "obstacle_set.hpp"
+#include "particle_pool.hpp"
+#include "particle_store.hpp"
+#include "particle_view.hpp"
+#include "snapshot.hpp"
+#include "spatial_grid.hpp"
+#include "world_observer.hpp"
+
+/**
+ * @brief   Algorithm used to sum up the pull of the point masses in the world.
+ */
+enum class GravitySolver
+{
+    DIRECT,      ///< Exact pairwise sum, linear in the amount of point masses per particle.
+    BARNES_HUT,  ///< Barnes-Hut tree approximation, logarithmic per particle.
+};
+
+/**
+ * @brief   What happens to the particles leaving the bounds of the world.
+ */
+enum class BoundaryMode
+{
+    NONE,    ///< The world is unbounded.
+    WRAP,    ///< The particles reenter the bounds on the opposite side.
+    BOUNCE,  ///< The particles bounce off the bounds.
+    KILL,    ///< The particles are killed.
+};
+
 /**
- * @class   World
+ * @brief   Phases of a step of the game world, timed separately.
+ */
+enum class StepPhase
+{
+    EMISSION,      ///< Spawning and initialising the particles of the emitters.
+    FORCES,        ///< Accumulating the forces of the gravity objects and of the particles.
+    INTEGRATION,   ///< Advancing the particles, without the force accumulation.
+    COLLISIONS,    ///< Detecting and resolving the collisions between particles.
+    OBSTACLES,     ///< Keeping the particles within the bounds and out of the obstacles.
+    EXPIRY,        ///< Aging the particles and removing the expired ones.
+    SPATIAL_GRID,  ///< Rebuilding the spatial grid.
+};
+
+/**
+ * @brief   Amount of values of StepPhase.
+ */
+static constexpr std::size_t STEP_PHASE_COUNT = 7;
+
+/**
+ * @class   BasicWorld
  *
  * @brief   Class representing the contents of the game world.
  *
@@ -21,22 +83,122 @@
  * - Keep the constraints and state of the simulation world.
  * - Keep track of objects in the world.
  *
+ * The particles are kept in a ParticlePool preallocated to the particle limit. The live particles
+ * are packed densely in front of its structure-of-arrays store, so the passes over them never step
+ * over dead slots. Gravity objects are owned by the world and act on every live particle.
+ *
+ * The point masses in the world are the enabled gravity objects acting as point masses and, with
+ * particle self-gravity turned on, every particle with a positive mass. Their pull is summed up
+ * either directly or, for many of them, approximately by a BarnesHutTree rebuilt every step.
+ * Gravity objects that are not point masses are always evaluated directly. When some of them
+ * have a cutoff radius, every job first bounds its particle range with a box and skips the
+ * objects that cannot reach into it.
+ *
+ * The whole simulation of a world runs in one precision, picked by the template parameter. World
+ * simulates in double precision. WorldF simulates in single precision, which is plenty for particle
+ * effects, halves the memory traffic and doubles the width of the SIMD kernels. Its gravity objects
+ * have to be of the same precision, e.g. GravityConstantF.
+ *
+ * Every step is spread over all the threads of the world's JobSystem, one particle range per job.
+ * A particle only ever writes its own state and sums up the forces acting on it in a fixed order,
+ * so the results do not depend on the thread count or on the scheduling of the threads.
+ *
+ * Every step advances the simulation by a fixed time step, 1.0 unless set otherwise, using the
+ * selected Integrator. Symplectic Euler is the cheapest, velocity Verlet is more accurate for the
+ * same single force evaluation per step and Runge-Kutta 4 allows the largest steps near strong
+ * sources for four evaluations per step. Gravity objects giving every particle the same
+ * acceleration, such as GravityConstant, are summed up once per step and added to the velocities
+ * by the integration pass itself, without touching the force accumulators. Before moving
+ * the particles, the step saves their positions as the previous positions, so that the rendering
+ * can interpolate between the last two steps while the steps run at a rate of their own, see
+ * FixedTimestep.
+ *
+ * The particles close to strong sources need far shorter steps than the rest. With block time
+ * steps enabled, every step first sorts the particles by their acceleration into power-of-two
+ * levels: level L advances in 2^L steps of time_step / 2^L, each one just short enough for the
+ * particle to stay within the time step accuracy of a straight line. The slots are reordered so
+ * that every level occupies a contiguous range, finest last, and the forces of a level are only
+ * evaluated at its own steps. Most particles thus still cost one force evaluation per step, while
+ * the few in the fine levels get the substeps they need. Block time steps integrate with the
+ * symplectic Euler kicks regardless of the selected integrator.
+ *
+ * Emitters are owned by the world as well. Every step starts by spawning the particles the
+ * emitters ask for, one contiguous batch of slots per emitter, and initialising the batches of all
+ * emitters in parallel.
+ *
+ * Every step ages the particles by the time step and expires the ones that reached their lifetime
+ * in a single pass, which then compacts the survivors in bulk, see ParticlePool::compact(). An
+ * expiry callback, if set, receives all the particles expired in a step in one call, while their
+ * data is still in the store.
+ *
+ * With particle collisions turned on, every step resolves the collisions between the particles with
+ * a positive radius right after moving them. The broadphase sorts the particles into a SpatialGrid
+ * with cells twice the largest radius, so the candidate pairs of a particle only come from the few
+ * particles in the neighbouring cells. Fixed blocks of the grid are searched for candidate pairs in
+ * parallel and the narrowphase turns the overlapping ones into contacts right away, with the
+ * normal, the overlap and the impulse of approaching particles computed from the state before the
+ * pass. A serial pass then applies the contacts, pushing the particles of every contact apart and
+ * changing their momenta by exactly opposite amounts. The results do not depend on the thread
+ * count. The restitution selects between perfectly elastic (1.0) and perfectly inelastic (0.0)
+ * collisions.
+ *
+ * The world may have axis-aligned bounds and static obstacles, see ObstacleSet. Every step then
+ * applies the boundary mode to the particles that left the bounds, wrapping them around, bouncing
+ * them off or killing them, and keeps the particles out of the obstacles. Both run in a single
+ * branch-free pass over the particles. Particles killed by the bounds are removed by the expiry
+ * pass of the same step, together with the expired ones, and are reported to the expiry callback
+ * as well.
+ *
+ * With a grid cell size set, every step ends by rebuilding a SpatialGrid over the live particles,
+ * for neighbourhood queries such as picking. The indices it reports are slots of the particle
+ * store and stay valid until a particle is spawned or killed.
+ *
+ * The wall-clock time of every StepPhase is summed up over the steps, for profiling the
+ * simulation without external tools.
+ *
+ * The whole simulation state can be saved into a snapshot file and loaded back, see snapshot.hpp
+ * for the format. Stepping a loaded world continues exactly like stepping the saved one would have.
+ *
+ * An observer, if set, is notified about the particles spawned and killed through the world and
+ * about every step, which is how a ReplayRecorder records the inputs of a session.
+ *
  * @section USAGE
  *
  * @code
  *
+ * World world;
+ *
+ * world.set_particle_limit(100000);
+ * world.add_gravity_object(std::make_unique<GravityConstant>());
+ *
+ * ParticleHandle handle = world.spawn_particle(Point2D(0.0, 0.0), Vector2D(1.0, 0.0));
+ *
+ * world.step();
+ *
  * @endcode
  */
-class World
+template <typename T>
+class BasicWorld
 {
 public:
+    /**
+     * @brief   Callback receiving the pool and the slots of all the particles expired in a step.
+     */
+    typedef std::function<void(const BasicParticlePool<T> &, const std::vector<std::size_t> &)>
+        ExpiryCallback;
+
     /**
      * @brief   Contructor.
      */
-    World(void);
+    BasicWorld(void);
 
     /**
      * @brief   particle_limit_ setter.
+     *
+     * @details
+     *
+     * Also resizes the particle pool, so that it has exactly one slot per allowed particle.
+     * Lowering the limit kills all the particles.
      */
     void set_particle_limit(std::size_t particle_limit);
 
@@ -45,6 +207,611 @@ public:
      */
     std::size_t get_particle_limit();
 
+    /**
+     * @brief   Returns the amount of live particles.
+     */
+    std::size_t get_particle_count(void) const;
+
+    /**
+     * @brief   Returns the store holding all the particles.
+     *
+     * @details
+     *
+     * The live particles occupy the slots [0, get_particle_count()).
+     */
+    BasicParticleStore<T> &get_particles(void);
+
+    /**
+     * @brief   Returns the store holding all the particles.
+     */
+    const BasicParticleStore<T> &get_particles(void) const;
+
+    /**
+     * @brief   Returns the pool managing the particle slots.
+     */
+    BasicParticlePool<T> &get_particle_pool(void);
+
+    /**
+     * @brief   Spawns a new particle.
+     *
+     * @param   position    Initial position.
+     * @param   velocity    Initial velocity.
+     * @param   mass        Initial mass.
+     *
+     * @return  Handle of the new particle, invalid if the particle limit has been reached.
+     */
+    ParticleHandle spawn_particle(essentials::BasicVector2D<T> position,
+                                  essentials::BasicVector2D<T> velocity, T mass = 0.0);
+
+    /**
+     * @brief   Kills a particle.
+     *
+     * @param   handle      Handle of the particle.
+     *
+     * @return  True if the particle was alive, false otherwise.
+     */
+    bool kill_particle(ParticleHandle handle);
+
+    /**
+     * @brief   Returns a Particle-like view of a single particle.
+     *
+     * @param   handle      Handle of the particle.
+     */
+    BasicParticleView<T> get_particle(ParticleHandle handle);
+
+    /**
+     * @brief   Hands a gravity object over to the world.
+     *
+     * @param   gravity_object  The gravity object.
+     *
+     * @return  Non-owning pointer to the added object, valid for the lifetime of the world.
+     */
+    BasicGravityObject<T> *add_gravity_object(
+        std::unique_ptr<BasicGravityObject<T>> gravity_object);
+
+    /**
+     * @brief   Returns the amount of gravity objects in the world.
+     */
+    std::size_t get_gravity_object_count(void) const;
+
+    /**
+     * @brief   Returns a gravity object of the world, in the order they were added.
+     *
+     * @param   index       Index of the gravity object, less than get_gravity_object_count().
+     */
+    BasicGravityObject<T> *get_gravity_object(std::size_t index);
+
+    /**
+     * @brief   Hands an emitter over to the world.
+     *
+     * @param   emitter     The emitter.
+     *
+     * @return  Non-owning pointer to the added emitter, valid for the lifetime of the world.
+     */
+    BasicEmitter<T> *add_emitter(std::unique_ptr<BasicEmitter<T>> emitter);
+
+    /**
+     * @brief   Spawns and initialises the particles of all emitters for one time step.
+     *
+     * @details
+     *
+     * Emitters asking for more particles than the particle limit allows get only the remaining
+     * ones, in the order they were added.
+     */
+    void emit_particles(void);
+
+    /**
+     * @brief   expiry_callback_ setter.
+     *
+     * @details
+     *
+     * The callback is called at most once per step, after the particles were aged and before the
+     * expired ones are removed, so their slots still hold their data and handles.
+     *
+     * @param   callback    The callback, empty for none.
+     */
+    void set_expiry_callback(ExpiryCallback callback);
+
+    /**
+     * @brief   observer_ setter.
+     *
+     * @param   *observer   The observer, not owned by the world, null for none.
+     */
+    void set_observer(BasicWorldObserver<T> *observer);
+
+    /**
+     * @brief   observer_ getter.
+     */
+    BasicWorldObserver<T> *get_observer(void) const;
+
+    /**
+     * @brief   gravity_solver_ setter.
+     */
+    void set_gravity_solver(GravitySolver gravity_solver);
+
+    /**
+     * @brief   gravity_solver_ getter.
+     */
+    GravitySolver get_gravity_solver(void) const;
+
+    /**
+     * @brief   Sets the opening angle of the Barnes-Hut solver.
+     *
+     * @details
+     *
+     * Lower angles trade speed for accuracy, 0.0 gives the same forces as the direct solver.
+     *
+     * @see     BarnesHutTree
+     */
+    void set_barnes_hut_theta(T theta);
+
+    /**
+     * @brief   Returns the opening angle of the Barnes-Hut solver.
+     */
+    T get_barnes_hut_theta(void) const;
+
+    /**
+     * @brief   particle_self_gravity_ setter.
+     *
+     * @param   enabled     True to make the particles with a positive mass attract each other.
+     */
+    void set_particle_self_gravity(bool enabled);
+
+    /**
+     * @brief   particle_self_gravity_ getter.
+     */
+    bool get_particle_self_gravity(void) const;
+
+    /**
+     * @brief   particle_collisions_ setter.
+     *
+     * @param   enabled     True to make the particles with a positive radius collide.
+     */
+    void set_particle_collisions(bool enabled);
+
+    /**
+     * @brief   particle_collisions_ getter.
+     */
+    bool get_particle_collisions(void) const;
+
+    /**
+     * @brief   collision_restitution_ setter.
+     *
+     * @param   restitution     Share of the approaching speed kept by colliding particles, 1.0 for
+     *                          elastic and 0.0 for perfectly inelastic collisions.
+     */
+    void set_collision_restitution(T restitution);
+
+    /**
+     * @brief   collision_restitution_ getter.
+     */
+    T get_collision_restitution(void) const;
+
+    /**
+     * @brief   boundary_mode_ setter.
+     */
+    void set_boundary_mode(BoundaryMode mode);
+
+    /**
+     * @brief   boundary_mode_ getter.
+     */
+    BoundaryMode get_boundary_mode(void) const;
+
+    /**
+     * @brief   Sets the bounds of the world.
+     *
+     * @details
+     *
+     * Particles bounce off the bounds with their radius, but wrap around and are killed once
+     * their centers leave the bounds.
+     *
+     * @param   min     Corner of the bounds with the lowest coordinates.
+     * @param   max     Corner of the bounds with the highest coordinates.
+     */
+    void set_bounds(essentials::BasicVector2D<T> min, essentials::BasicVector2D<T> max);
+
+    /**
+     * @brief   bounds_min_ getter.
+     */
+    essentials::BasicVector2D<T> get_bounds_min(void) const;
+
+    /**
+     * @brief   bounds_max_ getter.
+     */
+    essentials::BasicVector2D<T> get_bounds_max(void) const;
+
+    /**
+     * @brief   obstacle_restitution_ setter.
+     *
+     * @param   restitution     Share of the speed towards the bounds or an obstacle kept by a
+     *                          bounce off them, 1.0 for elastic and 0.0 for inelastic bounces.
+     */
+    void set_obstacle_restitution(T restitution);
+
+    /**
+     * @brief   obstacle_restitution_ getter.
+     */
+    T get_obstacle_restitution(void) const;
+
+    /**
+     * @brief   Returns the static obstacles of the world.
+     */
+    BasicObstacleSet<T> &get_obstacles(void);
+
+    /**
+     * @brief   Returns the static obstacles of the world.
+     */
+    const BasicObstacleSet<T> &get_obstacles(void) const;
+
+    /**
+     * @brief   integrator_ setter.
+     *
+     * @details
+     *
+     * Switching the integrator forgets the accelerations kept for velocity Verlet.
+     */
+    void set_integrator(Integrator integrator);
+
+    /**
+     * @brief   integrator_ getter.
+     */
+    Integrator get_integrator(void) const;
+
+    /**
+     * @brief   time_step_ setter.
+     *
+     * @param   time_step   Length of the simulated time of every step.
+     */
+    void set_time_step(T time_step);
+
+    /**
+     * @brief   time_step_ getter.
+     */
+    T get_time_step(void) const;
+
+    /**
+     * @brief   max_time_step_level_ setter.
+     *
+     * @param   level       Finest block time step level, advancing in 2^level substeps per step.
+     *                      0 turns the block time steps off.
+     */
+    void set_max_time_step_level(std::size_t level);
+
+    /**
+     * @brief   max_time_step_level_ getter.
+     */
+    std::size_t get_max_time_step_level(void) const;
+
+    /**
+     * @brief   time_step_accuracy_ setter.
+     *
+     * @param   accuracy    Largest distance the acceleration may deflect a particle from a
+     *                      straight line within one of its block time steps.
+     */
+    void set_time_step_accuracy(T accuracy);
+
+    /**
+     * @brief   time_step_accuracy_ getter.
+     */
+    T get_time_step_accuracy(void) const;
+
+    /**
+     * @brief   Returns the amount of particles in a block time step level during the last step.
+     */
+    std::size_t get_time_step_level_size(std::size_t level) const;
+
+    /**
+     * @brief   Changes the amount of threads running the steps.
+     *
+     * @param   thread_count    Amount of threads including the calling one, 0 for one per hardware
+     *                          thread.
+     *
+     * @see     JobSystem::set_thread_count()
+     */
+    void set_thread_count(std::size_t thread_count);
+
+    /**
+     * @brief   Returns the amount of threads running the steps.
+     */
+    std::size_t get_thread_count(void) const;
+
+    /**
+     * @brief   Switches the deterministic splitting of the particle ranges on or off.
+     *
+     * @see     JobSystem::set_deterministic()
+     */
+    void set_deterministic(bool deterministic);
+
+    /**
+     * @brief   Returns true if the particle ranges are split deterministically, false otherwise.
+     */
+    bool get_deterministic(void) const;
+
+    /**
+     * @brief   Returns the job system running the steps.
+     */
+    JobSystem &get_job_system(void);
+
+    /**
+     * @brief   grid_cell_size_ setter.
+     *
+     * @param   cell_size   Cell size of the spatial grid rebuilt every step, 0.0 to not keep one.
+     */
+    void set_grid_cell_size(T cell_size);
+
+    /**
+     * @brief   grid_cell_size_ getter.
+     */
+    T get_grid_cell_size(void) const;
+
+    /**
+     * @brief   Returns the spatial grid over the live particles.
+     *
+     * @details
+     *
+     * The indices reported by the grid are slots of the particle store.
+     */
+    const BasicSpatialGrid<T> &get_spatial_grid(void) const;
+
+    /**
+     * @brief   Rebuilds the spatial grid over the current positions of the live particles.
+     */
+    void update_spatial_grid(void);
+
+    /**
+     * @brief   Adds the forces of all gravity objects to the force accumulators of the particles.
+     */
+    void accumulate_forces(void);
+
+    /**
+     * @brief   Adds the same acceleration to the velocities of all particles.
+     *
+     * @details
+     *
+     * The acceleration acts for the length of the time step regardless of the masses, in a single
+     * pass over the velocities.
+     *
+     * @param   acceleration    The acceleration.
+     */
+    void apply_uniform_acceleration(essentials::BasicVector2D<T> acceleration);
+
+    /**
+     * @brief   Returns the sum of the accelerations of all the gravity objects with a uniform one.
+     *
+     * @see     GravityObject::get_uniform_acceleration()
+     */
+    essentials::BasicVector2D<T> get_uniform_acceleration(void) const;
+
+    /**
+     * @brief   Sums up the accumulated forces with the velocities and clears the accumulators.
+     *
+     * @details
+     *
+     * The forces act for the length of the time step and are divided by the masses, particles
+     * without mass are treated as having a unit mass. Together with update(), this is one step of
+     * the symplectic Euler integrator, which step() runs fused into a single pass.
+     */
+    void integrate_forces(void);
+
+    /**
+     * @brief   Updates the positions of all particles using their current velocities.
+     *
+     * @details
+     *
+     * The particles move for the length of the time step, their positions from before the move are
+     * kept as the previous positions.
+     */
+    void update(void);
+
+    /**
+     * @brief   Ages all particles by the time step and kills the ones that reached their lifetime.
+     *
+     * @details
+     *
+     * Particles whose slots were marked as not alive by other means are killed as well.
+     */
+    void expire_particles(void);
+
+    /**
+     * @brief   Separates the overlapping particles and bounces off the approaching ones.
+     *
+     * @details
+     *
+     * Every overlap is resolved partially, each particle moves away by a share of the overlap
+     * given by the masses, so that particles pressed on from many sides settle over a few steps
+     * instead of overshooting. Particles with a zero radius are left alone.
+     */
+    void resolve_collisions(void);
+
+    /**
+     * @brief   Applies the boundary mode and keeps the particles out of the obstacles.
+     *
+     * @details
+     *
+     * Particles killed by the bounds are only marked as not alive, expire_particles() removes them.
+     */
+    void resolve_obstacles(void);
+
+    /**
+     * @brief   Advances the simulation by one step.
+     */
+    void step(void);
+
+    /**
+     * @brief   Saves the state of the world into a snapshot file.
+     *
+     * @details
+     *
+     * The snapshot holds the simulation settings, the particle pool with the bookkeeping of its
+     * handles, the gravity objects and the emitters with the states of their random generators.
+     * The thread count, the expiry callback and the phase times are not part of it. Only gravity
+     * objects and emitters of the classes of this library can be saved.
+     *
+     * @param   &path       Path of the file, an existing file is overwritten.
+     *
+     * @throws  std::runtime_error if the file cannot be written or the world holds a gravity
+     *          object or an emitter of another class.
+     */
+    void save_snapshot(const std::string &path) const;
+
+    /**
+     * @brief   Saves the state of the world as the records of an open snapshot.
+     *
+     * @param   &writer     Writer of the snapshot, left open for further records.
+     *
+     * @throws  std::runtime_error if the snapshot cannot be written or the world holds a gravity
+     *          object or an emitter of another class.
+     */
+    void save_snapshot(SnapshotWriter &writer) const;
+
+    /**
+     * @brief   Replaces the state of the world with the one saved in a snapshot file.
+     *
+     * @details
+     *
+     * The particle arrays are copied out of the mapped file in bulk, so loading takes about as
+     * long as copying them in memory. The handles of the saved particles are valid in the loaded
+     * world, the pointers to the previous gravity objects and emitters are not. On failure, the
+     * world is left unchanged.
+     *
+     * @param   &path       Path of the file.
+     *
+     * @throws  std::runtime_error if the file cannot be read or is not a valid snapshot of a world
+     *          of the same precision.
+     */
+    void load_snapshot(const std::string &path);
+
+    /**
+     * @brief   Replaces the state of the world with the next records of an open snapshot.
+     *
+     * @param   &reader     Reader of the snapshot, positioned at the state of a world.
+     *
+     * @throws  std::runtime_error if the records are not a valid state of a world of the same
+     *          precision.
+     */
+    void load_snapshot(SnapshotReader &reader);
+
+    /**
+     * @brief   Returns a hash of the state of all the live particles.
+     *
+     * @details
+     *
+     * Deterministic worlds stepped through the same inputs have equal hashes, regardless of their
+     * thread counts. Hashing costs a single pass over the particle arrays.
+     */
+    std::uint64_t get_state_hash(void) const;
+
+    /**
+     * @brief   Returns the seconds spent in a phase of the steps since the last reset.
+     */
+    double get_phase_time(StepPhase phase) const;
+
+    /**
+     * @brief   Zeroes the times spent in the phases of the steps.
+     */
+    void reset_phase_times(void);
+
 protected:
-    std::size_t particle_limit_;  ///< The maximum amount of particles allowed at one time.
+    /**
+     * @brief   Contact between two overlapping particles, computed before resolving any of them.
+     */
+    struct Contact
+    {
+        std::uint32_t i;  ///< Slot of the first particle.
+        std::uint32_t j;  ///< Slot of the second particle.
+        T normal_x;       ///< X component of the normal pointing from the second to the first.
+        T normal_y;       ///< Y component of the normal pointing from the second to the first.
+        T separation;     ///< Overlap to resolve now, divided by the summed inverse masses.
+        T impulse;        ///< Impulse along the normal, zero for particles moving apart.
+    };
+
+    /**
+     * @brief   Adds the forces of the gravity objects to the force accumulators of a slot range.
+     *
+     * @param   first       Index of the first slot.
+     * @param   last        Index one past the last slot.
+     * @param   uniform     True to include the gravity objects with a uniform acceleration, false
+     *                      if the caller adds get_uniform_acceleration() on its own.
+     */
+    void accumulate_forces(std::size_t first, std::size_t last, bool uniform);
+
+    /**
+     * @brief   Adds to the time spent in a phase of the steps.
+     */
+    void add_phase_time(StepPhase phase, double seconds);
+
+    /**
+     * @brief   Runs one step with block time steps.
+     */
+    void run_block_step(void);
+
+    /**
+     * @brief   Assigns the block time step levels by the accelerations and sorts the slots by them.
+     */
+    void sort_by_time_step_level(void);
+
+    /**
+     * @brief   Runs one step of an integrator.
+     */
+    template <typename Policy>
+    void run_integrator(void);
+
+    /**
+     * @brief   Runs all the stages of an integrator's step in order.
+     */
+    template <typename Policy, std::size_t... STAGES>
+    void run_stages(const IntegratorArrays<T> &arrays, std::index_sequence<STAGES...>);
+
+    /**
+     * @brief   Runs a single stage of an integrator's step.
+     */
+    template <typename Policy, std::size_t STAGE>
+    void run_stage(const IntegratorArrays<T> &arrays);
+
+    std::size_t particle_limit_;      ///< The maximum amount of particles allowed at one time.
+    BasicParticlePool<T> particles_;  ///< All particles, one slot per allowed particle.
+    std::vector<std::unique_ptr<BasicGravityObject<T>>> gravity_objects_;  ///< Owned objects.
+    GravitySolver gravity_solver_;        ///< Algorithm summing up the pull of the point masses.
+    bool particle_self_gravity_;          ///< True if the particles attract each other.
+    bool particle_collisions_;            ///< True if the particles collide.
+    T collision_restitution_;             ///< Share of the approaching speed kept by collisions.
+    BasicSpatialGrid<T> collision_grid_;  ///< Broadphase grid of the collisions.
+    std::vector<std::vector<Contact>> collision_contacts_;  ///< Contacts of every grid block.
+    Integrator integrator_;                                 ///< Integrator advancing the particles.
+    T time_step_;                            ///< Length of the simulated time of every step.
+    std::vector<T> integrator_scratch_;      ///< Per-particle scratch arrays of the integrators.
+    BasicBarnesHutTree<T> barnes_hut_tree_;  ///< Tree over all point masses, rebuilt every step.
+    std::vector<T> body_x_;                  ///< X components of the positions of all point masses.
+    std::vector<T> body_y_;                  ///< Y components of the positions of all point masses.
+    std::vector<T> body_mass_;               ///< Masses of all point masses.
+    JobSystem jobs_;                         ///< Threads running the steps.
+    T grid_cell_size_;                       ///< Cell size of the spatial grid, 0.0 for none.
+    BasicSpatialGrid<T> spatial_grid_;       ///< Grid over the live particles.
+    std::size_t max_time_step_level_;        ///< Finest block time step level, 0 for none.
+    T time_step_accuracy_;                   ///< Largest deflection within a block time step.
+    std::vector<std::uint8_t> time_step_levels_;  ///< Block time step level of every slot.
+    std::vector<std::size_t> level_starts_;       ///< First slot of every level, plus the end.
+    std::vector<std::size_t> level_fill_;         ///< Next slot of every level while sorting.
+    std::vector<std::unique_ptr<BasicEmitter<T>>> emitters_;  ///< Owned emitters.
+    std::vector<std::size_t> emitter_firsts_;  ///< First slot of every emitter's batch.
+    std::vector<std::size_t> emitter_counts_;  ///< Amount of slots in every emitter's batch.
+    ExpiryCallback expiry_callback_;           ///< Receiver of the expired particles, if any.
+    std::vector<std::size_t> expired_slots_;   ///< Slots of the particles expired in a step.
+    BasicWorldObserver<T> *observer_;          ///< Receiver of the inputs and steps, if any.
+    std::array<double, STEP_PHASE_COUNT> phase_times_;  ///< Seconds spent in each step phase.
+    BoundaryMode boundary_mode_;                        ///< Fate of the particles out of bounds.
+    essentials::BasicVector2D<T> bounds_min_;           ///< Lowest corner of the bounds.
+    essentials::BasicVector2D<T> bounds_max_;           ///< Highest corner of the bounds.
+    T obstacle_restitution_;                            ///< Share of the speed kept by bounces.
+    BasicObstacleSet<T> obstacles_;                     ///< Static obstacles.
 };
+
+/**
+ * @brief   Double precision game world.
+ */
+typedef BasicWorld<double> World;
+
+/**
+ * @brief   Single precision game world.
+ */
+typedef BasicWorld<float> WorldF;
@@ -0,0 +1,68 @@
+/**
+ * @file    world_observer.hpp
+ * @author  Martin Cagas
+ *
+ * @brief   Interface of objects notified about the inputs and steps of a game world.
+ */
+
+#pragma once
+
+// "Game essentials" library includes
+#include <vector2d.hpp>
+
+// Local includes
+#include "particle_pool.hpp"
+
+/**
+ * @class   BasicWorldObserver
+ *
+ * @brief   Interface of objects notified about the inputs and steps of a game world.
+ *
+ * @section DESCRIPTION
+ *
+ * A world with an observer set notifies it about every particle spawned or killed through the
+ * world's methods and about the start and the end of every step. Particles spawned by emitters or
+ * expired by the steps are not reported, they follow from the state of the world.
+ *
+ * The notifications come from the thread calling the world's methods, never from the worker
+ * threads. A world without an observer pays a single null check per notification.
+ *
+ * @see     ReplayRecorder
+ */
+template <typename T>
+class BasicWorldObserver
+{
+public:
+    /**
+     * @brief   Destructor.
+     */
+    virtual ~BasicWorldObserver(void) = default;
+
+    /**
+     * @brief   Called after World::spawn_particle(), also when it failed.
+     *
+     * @param   handle      Handle returned by the spawn.
+     * @param   position    Initial position.
+     * @param   velocity    Initial velocity.
+     * @param   mass        Initial mass.
+     */
+    virtual void particle_spawned(ParticleHandle handle, essentials::BasicVector2D<T> position,
+                                  essentials::BasicVector2D<T> velocity, T mass) = 0;
+
+    /**
+     * @brief   Called after World::kill_particle(), also when it failed.
+     *
+     * @param   handle      Handle of the particle.
+     */
+    virtual void particle_killed(ParticleHandle handle) = 0;
+
+    /**
+     * @brief   Called at the start of every step, before anything is simulated.
+     */
+    virtual void step_starting(void) = 0;
+
+    /**
+     * @brief   Called at the end of every step.
+     */
+    virtual void step_finished(void) = 0;
+};